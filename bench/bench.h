@@ -0,0 +1,102 @@
+#pragma once
+
+#include "MySTL/Allocator.h"
+#include "MySTL/Queue.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+
+namespace bench {
+
+// Keeps the optimizer from discarding a computed value.
+template <typename T>
+inline void do_not_optimize(T const &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Runs `fn` once and returns the elapsed wall time in seconds.
+template <typename Fn>
+double measure(Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+inline void print_header(char const *title) { std::printf("\n%s\n", title); }
+
+// Heap traffic seen by every CountingAllocator.
+struct AllocationStats {
+  static inline std::size_t m_Allocations = 0;
+  static inline std::size_t m_BytesInUse = 0;
+
+  static void reset() {
+    m_Allocations = 0;
+    m_BytesInUse = 0;
+  }
+};
+
+// mystl::Allocator that records how often and how much it allocates.
+template <typename T>
+class CountingAllocator : public mystl::Allocator<T> {
+public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = CountingAllocator<U>;
+  };
+
+  constexpr CountingAllocator() = default;
+
+  template <typename U>
+  constexpr CountingAllocator(CountingAllocator<U> const &) {}
+
+  T *allocate(std::size_t count) {
+    ++AllocationStats::m_Allocations;
+    AllocationStats::m_BytesInUse += count * sizeof(T);
+    return mystl::Allocator<T>::allocate(count);
+  }
+
+  void deallocate(T *data, std::size_t count) {
+    AllocationStats::m_BytesInUse -= count * sizeof(T);
+    mystl::Allocator<T>::deallocate(data, count);
+  }
+
+  T *reallocate(T *data, std::size_t oldCount, std::size_t newCount) {
+    ++AllocationStats::m_Allocations;
+    AllocationStats::m_BytesInUse += (newCount - oldCount) * sizeof(T);
+    return mystl::Allocator<T>::reallocate(data, oldCount, newCount);
+  }
+};
+
+// The baseline for the concurrent queues: a bounded Queue behind a mutex.
+template <typename T, std::size_t Capacity = 1024>
+class LockedQueue {
+public:
+  bool try_push(T const &val) {
+    std::lock_guard lock(m_Mutex);
+    if (m_Queue.size() == Capacity) {
+      return false;
+    }
+    m_Queue.push(val);
+    return true;
+  }
+
+  bool try_pop(T &out) {
+    std::lock_guard lock(m_Mutex);
+    if (m_Queue.empty()) {
+      return false;
+    }
+    out = m_Queue.front();
+    m_Queue.pop();
+    return true;
+  }
+
+private:
+  std::mutex m_Mutex;
+  mystl::Queue<T> m_Queue;
+};
+
+} // namespace bench
@@ -0,0 +1,64 @@
+#include "MySTL/Vector.h"
+#include "MySTL/algorithms.h"
+#include "bench.h"
+
+#include <cstdio>
+
+namespace {
+
+// 1 GiB of floats: far past every cache level, so this is memory bandwidth.
+constexpr std::size_t float_count = std::size_t{1} << 28;
+constexpr double float_bytes = double(float_count * sizeof(float));
+
+// Best of a few runs: the first pass over fresh memory also pays for the
+// page faults.
+template <typename Fn>
+double best_of(Fn &&fn) {
+  double best = bench::measure(fn);
+  for (int run = 1; run < 3; ++run) {
+    double seconds = bench::measure(fn);
+    best = seconds < best ? seconds : best;
+  }
+  return best;
+}
+
+void print_row(char const *name, double seconds, double bytesMoved) {
+  std::printf("%28s %10.1f %10.2f\n", name, seconds * 1e3,
+              bytesMoved / seconds / 1e9);
+}
+
+} // namespace
+
+void bench_algorithms() {
+  bench::print_header("algo::fill / algo::copy, Vector<float> of 1 GiB");
+  std::printf("%28s %10s %10s\n", "operation", "ms", "GB/s");
+
+  mystl::Vector<float> source(float_count, 2.0f);
+
+  double zero = best_of([&source] {
+    mystl::algo::fill(source.begin(), source.end(), 0.0f);
+  });
+  bench::do_not_optimize(source[float_count / 2]);
+  print_row("fill 0.0f", zero, float_bytes);
+
+  double pattern = best_of([&source] {
+    mystl::algo::fill(source.begin(), source.end(), 1.5f);
+  });
+  bench::do_not_optimize(source[float_count / 2]);
+  print_row("fill 1.5f", pattern, float_bytes);
+
+  mystl::Vector<float> dest(float_count, 0.0f);
+  double copy = best_of([&source, &dest] {
+    mystl::algo::copy(source.begin(), source.end(), dest.begin());
+  });
+  bench::do_not_optimize(dest[float_count / 2]);
+  // A copy reads the source and writes the destination.
+  print_row("copy", copy, 2 * float_bytes);
+  dest = mystl::Vector<float>();
+
+  double construct = bench::measure([&source] {
+    mystl::Vector<float> copied(source);
+    bench::do_not_optimize(copied[float_count / 2]);
+  });
+  print_row("copy-construct (+ page faults)", construct, 2 * float_bytes);
+}
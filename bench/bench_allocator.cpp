@@ -0,0 +1,48 @@
+#include "MySTL/Vector.h"
+#include "bench.h"
+
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+
+// Sums `lookups` pseudo-random elements of a `bytes`-sized table, which is
+// dominated by TLB misses once the table is far larger than the TLB reach.
+template <typename Vec>
+double random_gather_rate(std::size_t bytes, std::size_t lookups) {
+  Vec table(bytes / sizeof(std::uint64_t), mystl::default_init);
+  for (std::size_t i = 0; i < table.size(); ++i) {
+    table[i] = i;
+  }
+
+  std::uint64_t sum = 0;
+  double seconds = bench::measure([&] {
+    std::uint64_t state = 88172645463325252ull;
+    std::uint64_t *data = table.data();
+    std::size_t mask = table.size() - 1;
+    for (std::size_t i = 0; i < lookups; ++i) {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      sum += data[state & mask];
+    }
+  });
+  bench::do_not_optimize(sum);
+  return static_cast<double>(lookups) / seconds / 1e6;
+}
+
+} // namespace
+
+void bench_allocator() {
+  bench::print_header("Random gather over a large table (Mlookups/s)");
+  std::printf("%12s %14s %16s\n", "table MiB", "Vector", "HugePageVector");
+
+  for (std::size_t mib : {64, 256, 1024}) {
+    std::size_t bytes = mib << 20;
+    double plain = random_gather_rate<mystl::Vector<std::uint64_t>>(
+        bytes, 20000000);
+    double huge = random_gather_rate<mystl::HugePageVector<std::uint64_t>>(
+        bytes, 20000000);
+    std::printf("%12zu %14.1f %16.1f\n", mib, plain, huge);
+  }
+}
@@ -0,0 +1,76 @@
+#include "MySTL/ForwardList.h"
+#include "MySTL/List.h"
+#include "MySTL/MemoryResource.h"
+#include "bench.h"
+
+#include <cstdio>
+
+namespace {
+
+constexpr int node_count = 10000000;
+
+// Passes through to the heap, keeping count of the bytes handed out.
+class CountingResource : public mystl::MemoryResource {
+public:
+  std::size_t m_Bytes = 0;
+
+private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    m_Bytes += bytes;
+    return mystl::default_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *data, std::size_t bytes,
+                     std::size_t alignment) override {
+    m_Bytes -= bytes;
+    mystl::default_resource()->deallocate(data, bytes, alignment);
+  }
+};
+
+// Pending-work style use: push everything at the front, then walk it.
+// Prints the node size, the memory the node pool takes per node (chunks
+// included), and the timings with the default allocator.
+template <template <typename, typename> typename List_t>
+void run_footprint(char const *name) {
+  double pooled;
+  {
+    // The same pool the default allocator builds, over a counting heap.
+    CountingResource heap;
+    mystl::PoolResource pool(0, 64, &heap);
+    List_t<int, mystl::PolymorphicAllocator<int>> list(&pool);
+    for (int i = 0; i < node_count; ++i) {
+      list.push_front(i);
+    }
+    pooled = double(heap.m_Bytes) / node_count;
+  }
+
+  List_t<int, mystl::PoolAllocator<int>> list;
+  double push = bench::measure([&list] {
+    for (int i = 0; i < node_count; ++i) {
+      list.push_front(i);
+    }
+  });
+
+  double traverse = bench::measure([&list] {
+    long sum = 0;
+    for (int value : list) {
+      sum += value;
+    }
+    bench::do_not_optimize(sum);
+  });
+
+  std::printf("%12s %10zu %12.1f %12.1f %12.1f %12.1f\n", name,
+              sizeof(typename decltype(list)::node_t), pooled,
+              pooled * node_count / (1 << 20), push * 1e9 / node_count,
+              traverse * 1e9 / node_count);
+}
+
+} // namespace
+
+void bench_forward_list() {
+  bench::print_header("ForwardList<int> vs List<int>, 10^7 nodes");
+  std::printf("%12s %10s %12s %12s %12s %12s\n", "container", "node B",
+              "pool B/node", "pool MiB", "push ns", "traverse ns");
+  run_footprint<mystl::List>("List");
+  run_footprint<mystl::ForwardList>("ForwardList");
+}
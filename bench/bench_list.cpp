@@ -0,0 +1,187 @@
+#include "MySTL/Allocator.h"
+#include "MySTL/List.h"
+#include "MySTL/UnrolledList.h"
+#include "bench.h"
+
+#include <cstdio>
+
+namespace {
+
+constexpr int node_count = 1000000;
+constexpr int resting_count = 10000;
+constexpr int cached_node_count = 1000;
+constexpr int cached_round_count = 2000;
+
+struct ListTimes {
+  double build;
+  double traverse;
+  double churn;
+  double clear;
+};
+
+// Order-book style use: build a book, scan it, then keep adding orders at
+// the back while filling them from the front and cancelling some in the
+// middle.
+template <typename List_t>
+ListTimes run_list() {
+  ListTimes times;
+  List_t list;
+
+  times.build = bench::measure([&list] {
+    for (int i = 0; i < node_count; ++i) {
+      list.push_back(i);
+    }
+  });
+
+  times.traverse = bench::measure([&list] {
+    long sum = 0;
+    for (int value : list) {
+      sum += value;
+    }
+    bench::do_not_optimize(sum);
+  });
+
+  times.clear = bench::measure([&list] { list.clear(); });
+
+  for (int i = 0; i < resting_count; ++i) {
+    list.push_back(i);
+  }
+  times.churn = bench::measure([&list] {
+    auto cancel = list.begin();
+    for (int i = 0; i < node_count; ++i) {
+      list.push_back(i);
+      if (i % 8 == 0) {
+        // Cancel a resting order and replace it.
+        cancel = list.erase(cancel);
+        cancel = list.insert(cancel, i);
+        ++cancel;
+        if (cancel == list.end()) {
+          cancel = list.begin();
+        }
+      }
+      if (cancel == list.begin()) {
+        ++cancel;
+      }
+      list.pop_front();
+    }
+    bench::do_not_optimize(list.back());
+  });
+
+  return times;
+}
+
+void print_times(char const *name, ListTimes times) {
+  double perNode = 1e9 / node_count;
+  std::printf("%18s %12.1f %12.1f %12.1f %12.1f\n", name,
+              times.build * perNode, times.traverse * perNode,
+              times.churn * perNode, times.clear * perNode);
+}
+
+// A list small enough to stay in cache, so the cost is the per-step work
+// of the iterator and of linking rather than memory latency.
+void run_cached_list() {
+  mystl::List<int> list;
+  for (int i = 0; i < cached_node_count; ++i) {
+    list.push_back(i);
+  }
+  mystl::List<int> const &view = list;
+
+  double forward = bench::measure([&view] {
+    long sum = 0;
+    for (int round = 0; round < cached_round_count; ++round) {
+      for (auto it = view.begin(); it != view.end(); ++it) {
+        sum += *it;
+      }
+    }
+    bench::do_not_optimize(sum);
+  });
+
+  double backward = bench::measure([&view] {
+    long sum = 0;
+    for (int round = 0; round < cached_round_count; ++round) {
+      auto it = view.end();
+      while (it != view.begin()) {
+        --it;
+        sum += *it;
+      }
+    }
+    bench::do_not_optimize(sum);
+  });
+
+  // Insert before every node, then erase what was inserted.
+  double insertErase = bench::measure([&list] {
+    for (int round = 0; round < cached_round_count; ++round) {
+      for (auto it = list.begin(); it != list.end(); ++it) {
+        list.insert(it, round);
+      }
+      for (auto it = list.begin(); it != list.end(); ++it) {
+        it = list.erase(it);
+      }
+    }
+    bench::do_not_optimize(list.front());
+  });
+
+  double perStep = 1e9 / (double(cached_node_count) * cached_round_count);
+  std::printf("%18s %12.2f %12.2f %12.2f\n", "node pool", forward * perStep,
+              backward * perStep, insertErase * perStep);
+}
+
+// Builds a container of node_count ints, sums it, and inserts before every
+// 16th element. Returns {scan, insert} in ns per element.
+template <typename Container_t>
+ListTimes run_scan_insert() {
+  ListTimes times{};
+  Container_t container;
+  for (int i = 0; i < node_count; ++i) {
+    container.push_back(i);
+  }
+
+  times.traverse = bench::measure([&container] {
+    long sum = 0;
+    for (int value : container) {
+      sum += value;
+    }
+    bench::do_not_optimize(sum);
+  });
+
+  times.churn = bench::measure([&container] {
+    int i = 0;
+    for (auto it = container.begin(); it != container.end(); ++it) {
+      if (++i % 16 == 0) {
+        it = container.insert(it, i);
+        ++it;
+      }
+    }
+    bench::do_not_optimize(container.back());
+  });
+
+  return times;
+}
+
+void print_scan_insert(char const *name, ListTimes times) {
+  double perNode = 1e9 / node_count;
+  std::printf("%18s %12.2f %12.2f\n", name, times.traverse * perNode,
+              times.churn * perNode);
+}
+
+} // namespace
+
+void bench_list() {
+  bench::print_header("List<int>, 1M nodes: ns per node");
+  std::printf("%18s %12s %12s %12s %12s\n", "allocator", "push_back",
+              "traverse", "churn", "clear");
+  print_times("malloc per node",
+              run_list<mystl::List<int, mystl::Allocator<int>>>());
+  print_times("node pool", run_list<mystl::List<int>>());
+
+  bench::print_header("List<int>, 1000 nodes in cache: ns per node");
+  std::printf("%18s %12s %12s %12s\n", "allocator", "forward",
+              "backward", "insert+erase");
+  run_cached_list();
+
+  bench::print_header("1M ints: ns per element");
+  std::printf("%18s %12s %12s\n", "container", "scan", "insert/16");
+  print_scan_insert("List", run_scan_insert<mystl::List<int>>());
+  print_scan_insert("UnrolledList",
+                    run_scan_insert<mystl::UnrolledList<int>>());
+}
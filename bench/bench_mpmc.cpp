@@ -0,0 +1,78 @@
+#include "MySTL/MpmcQueue.h"
+#include "bench.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t item_count = 4000000;
+
+// Runs `threads` producers and as many consumers over `queue` until
+// item_count integers have passed through; returns items per second.
+template <typename Push_t, typename Pop_t>
+double transfer(unsigned threads, Push_t push, Pop_t pop) {
+  std::size_t perThread = item_count / threads;
+  double seconds = bench::measure([&] {
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+      workers.emplace_back([&push, perThread] {
+        for (std::size_t i = 0; i < perThread; ++i) {
+          push(i);
+        }
+      });
+      workers.emplace_back([&pop, perThread] {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < perThread; ++i) {
+          sum += pop();
+        }
+        bench::do_not_optimize(sum);
+      });
+    }
+    for (std::thread &worker : workers) {
+      worker.join();
+    }
+  });
+  return perThread * threads / seconds;
+}
+
+} // namespace
+
+void bench_mpmc() {
+  unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+
+  bench::print_header("MPMC: N producers + N consumers, capacity 1024");
+  std::printf("%10s %18s %18s\n", "N", "mutex M items/s", "Mpmc M items/s");
+
+  for (unsigned threads = 1; threads <= std::max(4u, cores); threads *= 2) {
+    bench::LockedQueue<std::size_t> locked;
+    double lockedRate = transfer(
+        threads,
+        [&locked](std::size_t val) {
+          while (!locked.try_push(val)) {
+            std::this_thread::yield();
+          }
+        },
+        [&locked] {
+          std::size_t val;
+          while (!locked.try_pop(val)) {
+            std::this_thread::yield();
+          }
+          return val;
+        });
+
+    mystl::MpmcQueue<std::size_t> mpmc(1024);
+    double mpmcRate = transfer(
+        threads, [&mpmc](std::size_t val) { mpmc.push(val); },
+        [&mpmc] {
+          std::size_t val;
+          mpmc.pop(val);
+          return val;
+        });
+
+    std::printf("%10u %18.1f %18.1f\n", threads, lockedRate / 1e6,
+                mpmcRate / 1e6);
+  }
+}
@@ -0,0 +1,62 @@
+#include "MySTL/ParallelAlgorithms.h"
+#include "MySTL/ThreadPool.h"
+#include "MySTL/Vector.h"
+#include "bench.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+namespace {
+
+// 2^28 ints (1 GiB): a memory-bound sum and a compute-bound one over the
+// same data, on pools of 1, 2, 4, ... up to the hardware thread count.
+constexpr std::size_t element_count = std::size_t{1} << 28;
+
+} // namespace
+
+void bench_parallel_algorithms() {
+  bench::print_header("algo::reduce / transform_reduce(par), 2^28 ints");
+  std::printf("%8s %12s %10s %14s %10s\n", "threads", "reduce ms", "speedup",
+              "sqrt-sum ms", "speedup");
+
+  mystl::Vector<std::int32_t> values(element_count, 0);
+  mystl::algo::for_each(mystl::execution::par, values.begin(), values.end(),
+                        [](std::int32_t &value) { value = 3; });
+
+  double reduceBase = 0;
+  double computeBase = 0;
+  std::size_t hardware =
+      mystl::algo::max(std::thread::hardware_concurrency(), 1u);
+  for (std::size_t threads = 1;; threads *= 2) {
+    threads = mystl::algo::min(threads, hardware);
+    mystl::ThreadPool pool(threads);
+    auto par = mystl::execution::par.on(pool);
+
+    std::int64_t sum = 0;
+    double reduce = bench::measure([&] {
+      sum = mystl::algo::reduce(par, values.begin(), values.end(),
+                                std::int64_t{0});
+    });
+    bench::do_not_optimize(sum);
+
+    double roots = 0;
+    double compute = bench::measure([&] {
+      roots = mystl::algo::transform_reduce(
+          par, values.begin(), values.end(), 0.0, std::plus<>(),
+          [](std::int32_t value) { return std::sqrt(double(value)); });
+    });
+    bench::do_not_optimize(roots);
+
+    if (threads == 1) {
+      reduceBase = reduce;
+      computeBase = compute;
+    }
+    std::printf("%8zu %12.1f %10.2f %14.1f %10.2f\n", threads, reduce * 1e3,
+                reduceBase / reduce, compute * 1e3, computeBase / compute);
+    if (threads == hardware) {
+      break;
+    }
+  }
+}
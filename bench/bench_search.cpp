@@ -0,0 +1,105 @@
+#include "MySTL/Vector.h"
+#include "MySTL/algorithms.h"
+#include "bench.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+
+// 2^16 elements (256 KiB of int32), small enough to stay in L2, so this is
+// the scan itself rather than memory bandwidth. Every search has to look
+// at the whole range: the element sought, and the largest, is the last one.
+constexpr std::size_t element_count = std::size_t{1} << 16;
+constexpr int round_count = 2000;
+
+template <typename Fn>
+double gigabytes_per_second(std::size_t bytes, Fn &&fn) {
+  double seconds = bench::measure([&fn] {
+    for (int round = 0; round < round_count; ++round) {
+      fn();
+    }
+  });
+  return double(bytes) * round_count / seconds / 1e9;
+}
+
+template <typename T, typename StdFn, typename AlgoFn>
+void print_row(char const *name, std::size_t bytes, StdFn &&stdFn,
+               AlgoFn &&algoFn) {
+  double stdRate = gigabytes_per_second(bytes, stdFn);
+  double algoRate = gigabytes_per_second(bytes, algoFn);
+  std::printf("%24s %10.2f %10.2f %8.1fx\n", name, stdRate, algoRate,
+              algoRate / stdRate);
+}
+
+template <typename T>
+void bench_type(char const *type) {
+  mystl::Vector<T> values(element_count, T(0));
+  for (std::size_t i = 0; i < element_count; ++i) {
+    values[i] = static_cast<T>(i % 100);
+  }
+  values[element_count - 1] = T(127);
+  mystl::Vector<T> other(values);
+  other[element_count - 1] = T(1);
+  T *first = values.data();
+  T *last = first + element_count;
+  std::size_t bytes = element_count * sizeof(T);
+
+  bench::print_header(type);
+  std::printf("%24s %10s %10s %9s\n", "GB/s", "std", "algo", "");
+  print_row<T>(
+      "find", bytes,
+      [&] { bench::do_not_optimize(std::find(first, last, T(127))); },
+      [&] { bench::do_not_optimize(mystl::algo::find(first, last, T(127))); });
+  print_row<T>(
+      "find_if(greater_than)", bytes,
+      [&] {
+        bench::do_not_optimize(
+            std::find_if(first, last, [](T value) { return value > T(99); }));
+      },
+      [&] {
+        bench::do_not_optimize(mystl::algo::find_if(
+            first, last, mystl::algo::greater_than(T(99))));
+      });
+  print_row<T>(
+      "count", bytes,
+      [&] { bench::do_not_optimize(std::count(first, last, T(7))); },
+      [&] { bench::do_not_optimize(mystl::algo::count(first, last, T(7))); });
+  print_row<T>(
+      "min_element", bytes,
+      [&] { bench::do_not_optimize(std::min_element(first, last)); },
+      [&] { bench::do_not_optimize(mystl::algo::min_element(first, last)); });
+  print_row<T>(
+      "max_element", bytes,
+      [&] { bench::do_not_optimize(std::max_element(first, last)); },
+      [&] { bench::do_not_optimize(mystl::algo::max_element(first, last)); });
+  print_row<T>(
+      "minmax_element", bytes,
+      [&] { bench::do_not_optimize(std::minmax_element(first, last)); },
+      [&] {
+        bench::do_not_optimize(mystl::algo::minmax_element(first, last));
+      });
+  // Both ranges are read.
+  print_row<T>(
+      "mismatch", 2 * bytes,
+      [&] { bench::do_not_optimize(std::mismatch(first, last, other.data())); },
+      [&] {
+        bench::do_not_optimize(
+            mystl::algo::mismatch(first, last, other.data()));
+      });
+  print_row<T>(
+      "equal", 2 * bytes,
+      [&] { bench::do_not_optimize(std::equal(first, last, other.data())); },
+      [&] {
+        bench::do_not_optimize(mystl::algo::equal(first, last, other.data()));
+      });
+}
+
+} // namespace
+
+void bench_search() {
+  bench_type<std::int32_t>("Searching 2^16 int32 (in L2)");
+  bench_type<float>("Searching 2^16 float (in L2)");
+  bench_type<std::uint8_t>("Searching 2^16 uint8 (in L1/L2)");
+}
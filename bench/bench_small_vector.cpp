@@ -0,0 +1,50 @@
+#include "MySTL/SmallVector.h"
+#include "MySTL/Vector.h"
+#include "bench.h"
+
+#include <cstdio>
+
+namespace {
+
+constexpr std::size_t round_count = 1000000;
+
+// Builds and drops `round_count` containers of `count` elements, the way a
+// request handler would.
+template <typename Vec>
+void build_and_drop(std::size_t count, double &nsPerVector,
+                    double &allocsPerVector) {
+  bench::AllocationStats::reset();
+  double seconds = bench::measure([count] {
+    for (std::size_t round = 0; round < round_count; ++round) {
+      Vec vec;
+      for (std::size_t i = 0; i < count; ++i) {
+        vec.push_back(static_cast<int>(i + round));
+      }
+      bench::do_not_optimize(vec.back());
+    }
+  });
+  nsPerVector = seconds * 1e9 / round_count;
+  allocsPerVector =
+      static_cast<double>(bench::AllocationStats::m_Allocations) / round_count;
+}
+
+} // namespace
+
+void bench_small_vector() {
+  using Vector = mystl::Vector<int, mystl::GeometricGrowth<>,
+                               bench::CountingAllocator<int>>;
+  using Small = mystl::SmallVector<int, 16, mystl::GeometricGrowth<>,
+                                   bench::CountingAllocator<int>>;
+
+  bench::print_header("SmallVector<int, 16> vs Vector<int>: build + drop");
+  std::printf("%10s %14s %14s %14s %14s\n", "elements", "Vector ns",
+              "Vector allocs", "Small ns", "Small allocs");
+
+  for (std::size_t count : {1, 4, 8, 16, 32}) {
+    double vecNs, vecAllocs, smallNs, smallAllocs;
+    build_and_drop<Vector>(count, vecNs, vecAllocs);
+    build_and_drop<Small>(count, smallNs, smallAllocs);
+    std::printf("%10zu %14.1f %14.1f %14.1f %14.1f\n", count, vecNs,
+                vecAllocs, smallNs, smallAllocs);
+  }
+}
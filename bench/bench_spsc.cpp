@@ -0,0 +1,95 @@
+#include "MySTL/SpscQueue.h"
+#include "bench.h"
+
+#include <cstdio>
+#include <span>
+#include <thread>
+
+namespace {
+
+constexpr std::size_t item_count = 10000000;
+constexpr std::size_t batch_size = 64;
+
+// Moves item_count integers from a producer thread to this thread, one at a
+// time, and returns items per second.
+template <typename Queue_t>
+double one_by_one(Queue_t &queue) {
+  std::size_t sum = 0;
+  double seconds = bench::measure([&] {
+    std::thread producer([&queue] {
+      for (std::size_t i = 0; i < item_count;) {
+        if (queue.try_push(i)) {
+          ++i;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+    for (std::size_t received = 0; received < item_count;) {
+      std::size_t value;
+      if (queue.try_pop(value)) {
+        sum += value;
+        ++received;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+  });
+  bench::do_not_optimize(sum);
+  return item_count / seconds;
+}
+
+// Same transfer in batches of batch_size through try_push_n / try_pop_n.
+double batched(mystl::SpscQueue<std::size_t> &queue) {
+  std::size_t sum = 0;
+  double seconds = bench::measure([&] {
+    std::thread producer([&queue] {
+      std::size_t batch[batch_size];
+      for (std::size_t i = 0; i < item_count;) {
+        std::size_t count = 0;
+        for (; count < batch_size && i + count < item_count; ++count) {
+          batch[count] = i + count;
+        }
+        std::size_t pushed =
+            queue.try_push_n(std::span<std::size_t const>{batch, count});
+        if (pushed == 0) {
+          std::this_thread::yield();
+        }
+        i += pushed;
+      }
+    });
+    std::size_t batch[batch_size];
+    for (std::size_t received = 0; received < item_count;) {
+      std::size_t count = queue.try_pop_n(batch);
+      if (count == 0) {
+        std::this_thread::yield();
+      }
+      for (std::size_t i = 0; i < count; ++i) {
+        sum += batch[i];
+      }
+      received += count;
+    }
+    producer.join();
+  });
+  bench::do_not_optimize(sum);
+  return item_count / seconds;
+}
+
+} // namespace
+
+void bench_spsc() {
+  bench::print_header("SPSC hand-off of 10M integers, capacity 1024");
+  std::printf("%28s %14s\n", "queue", "M items/s");
+
+  bench::LockedQueue<std::size_t> locked;
+  std::printf("%28s %14.1f\n", "mutex + Queue", one_by_one(locked) / 1e6);
+
+  mystl::SpscQueue<std::size_t, 1024> fixed;
+  std::printf("%28s %14.1f\n", "SpscQueue<1024>", one_by_one(fixed) / 1e6);
+
+  mystl::SpscQueue<std::size_t> dynamic(1024);
+  std::printf("%28s %14.1f\n", "SpscQueue(1024)", one_by_one(dynamic) / 1e6);
+  std::printf("%28s %14.1f\n", "SpscQueue(1024), batch 64",
+              batched(dynamic) / 1e6);
+}
@@ -0,0 +1,115 @@
+#include "MySTL/Vector.h"
+#include "bench.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+template <typename Vec>
+double push_back_rate(std::size_t count) {
+  double seconds = bench::measure([count] {
+    Vec vec;
+    for (std::size_t i = 0; i < count; ++i) {
+      vec.push_back(static_cast<int>(i));
+    }
+    bench::do_not_optimize(vec.size());
+  });
+  return static_cast<double>(count) / seconds / 1e6;
+}
+
+// Appends `batches` batches of decoded records, one element or one range at
+// a time.
+template <bool UseRange>
+double ingest_rate(std::size_t batches, std::size_t batchSize) {
+  mystl::Vector<int> batch(batchSize, 1);
+  double seconds = bench::measure([&] {
+    mystl::Vector<int> sink;
+    for (std::size_t b = 0; b < batches; ++b) {
+      if constexpr (UseRange) {
+        sink.append_range(batch);
+      } else {
+        for (int value : batch) {
+          sink.push_back(value);
+        }
+      }
+    }
+    bench::do_not_optimize(sink.size());
+  });
+  return static_cast<double>(batches * batchSize) / seconds / 1e6;
+}
+
+// Fills a fresh receive buffer of `bytes` from a fake socket.
+template <bool Overwrite>
+double receive_rate(std::size_t bytes, int rounds) {
+  mystl::Vector<char> source(bytes, 'x');
+  double seconds = bench::measure([&] {
+    for (int round = 0; round < rounds; ++round) {
+      mystl::Vector<char> buffer;
+      if constexpr (Overwrite) {
+        buffer.resize_and_overwrite(bytes, [&](char *data, std::size_t n) {
+          std::memcpy(data, source.data(), n);
+          return n;
+        });
+      } else {
+        buffer.resize(bytes);
+        std::memcpy(buffer.data(), source.data(), bytes);
+      }
+      bench::do_not_optimize(buffer.back());
+    }
+  });
+  return static_cast<double>(bytes) * rounds / seconds / 1e9;
+}
+
+} // namespace
+
+void bench_vector_overwrite() {
+  bench::print_header("Vector<char> receive buffer fill (GB/s)");
+  std::printf("%12s %12s %22s\n", "bytes", "resize",
+              "resize_and_overwrite");
+
+  for (std::size_t bytes : {4096, 65536, 1 << 20, 64 << 20}) {
+    int rounds = static_cast<int>((256u << 20) / bytes);
+    double resize = receive_rate<false>(bytes, rounds);
+    double overwrite = receive_rate<true>(bytes, rounds);
+    std::printf("%12zu %12.2f %22.2f\n", bytes, resize, overwrite);
+  }
+}
+
+void bench_vector_ingest() {
+  bench::print_header("Vector<int> batch ingest to 10^7 elements (Melem/s)");
+  std::printf("%12s %12s %14s\n", "batch size", "push_back", "append_range");
+
+  constexpr std::size_t total = 10000000;
+  for (std::size_t batchSize : {16, 256, 4096, 65536}) {
+    double single = ingest_rate<false>(total / batchSize, batchSize);
+    double range = ingest_rate<true>(total / batchSize, batchSize);
+    std::printf("%12zu %12.1f %14.1f\n", batchSize, single, range);
+  }
+}
+
+void bench_vector() {
+  bench::print_header("Vector<int>::push_back throughput (Melem/s)");
+  std::printf("%12s %12s %12s %12s %12s\n", "elements", "geometric",
+              "pow2", "step<50>", "std::vector");
+
+  for (std::size_t count = 1000; count <= 100000000; count *= 10) {
+    double geometric = push_back_rate<mystl::Vector<int>>(count);
+    double pow2 =
+        push_back_rate<mystl::Vector<int, mystl::PowerOfTwoGrowth>>(count);
+    double std = push_back_rate<std::vector<int>>(count);
+
+    // A fixed step is quadratic; past 10^6 it would take minutes.
+    if (count <= 1000000) {
+      double step =
+          push_back_rate<mystl::Vector<int, mystl::FixedStepGrowth<50>>>(
+              count);
+      std::printf("%12zu %12.1f %12.1f %12.1f %12.1f\n", count, geometric,
+                  pow2, step, std);
+    } else {
+      std::printf("%12zu %12.1f %12.1f %12s %12.1f\n", count, geometric, pow2,
+                  "-", std);
+    }
+  }
+}
@@ -0,0 +1,29 @@
+void bench_vector();
+void bench_vector_ingest();
+void bench_vector_overwrite();
+void bench_small_vector();
+void bench_allocator();
+void bench_spsc();
+void bench_mpmc();
+void bench_list();
+void bench_forward_list();
+void bench_algorithms();
+void bench_parallel_algorithms();
+void bench_sort();
+void bench_search();
+
+int main() {
+  bench_vector();
+  bench_vector_ingest();
+  bench_vector_overwrite();
+  bench_small_vector();
+  bench_allocator();
+  bench_spsc();
+  bench_mpmc();
+  bench_list();
+  bench_forward_list();
+  bench_algorithms();
+  bench_parallel_algorithms();
+  bench_sort();
+  bench_search();
+}
@@ -16,6 +16,24 @@ pub fn build(b: *std.Build) !void {
         .files = &.{
             "main.cpp",
             "test_array.cpp",
+            "test_vector.cpp",
+            "test_allocator.cpp",
+            "test_list.cpp",
+            "test_small_vector.cpp",
+            "test_inplace_vector.cpp",
+            "test_mapped_vector.cpp",
+            "test_ring_buffer.cpp",
+            "test_spsc_queue.cpp",
+            "test_mpmc_queue.cpp",
+            "test_work_stealing_deque.cpp",
+            "test_concurrent_stack.cpp",
+            "test_unrolled_list.cpp",
+            "test_intrusive_list.cpp",
+            "test_forward_list.cpp",
+            "test_algorithms.cpp",
+            "test_parallel_algorithms.cpp",
+            "test_sort.cpp",
+            "test_iterator.cpp",
         },
         .flags = &.{
             "-std=c++23",
@@ -29,4 +47,38 @@ pub fn build(b: *std.Build) !void {
     const run_test = b.addRunArtifact(my_test);
     const test_step = b.step("test", "Run unit tests");
     test_step.dependOn(&run_test.step);
+
+    const my_bench = b.addExecutable(.{
+        .name = "MySTL_bench",
+        .target = target,
+        .optimize = .ReleaseFast,
+    });
+    my_bench.linkLibCpp();
+    my_bench.addIncludePath(b.path("include"));
+    my_bench.addCSourceFiles(.{
+        .root = b.path("bench"),
+        .files = &.{
+            "main.cpp",
+            "bench_vector.cpp",
+            "bench_small_vector.cpp",
+            "bench_allocator.cpp",
+            "bench_spsc.cpp",
+            "bench_mpmc.cpp",
+            "bench_list.cpp",
+            "bench_forward_list.cpp",
+            "bench_algorithms.cpp",
+            "bench_parallel_algorithms.cpp",
+            "bench_sort.cpp",
+            "bench_search.cpp",
+        },
+        .flags = &.{
+            "-std=c++23",
+            "-Wall",
+            "-Wextra",
+        },
+    });
+
+    const run_bench = b.addRunArtifact(my_bench);
+    const bench_step = b.step("bench", "Run benchmarks");
+    bench_step.dependOn(&run_bench.step);
 }
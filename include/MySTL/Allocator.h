@@ -0,0 +1,271 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace mystl {
+
+// The default allocator for every container. Blocks come from malloc so that
+// a container of trivially relocatable elements can grow them with realloc.
+template <typename T>
+class Allocator {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal = std::true_type;
+
+public:
+  constexpr Allocator() = default;
+
+  template <typename U>
+  constexpr Allocator(Allocator<U> const &) {}
+
+  T *allocate(size_type count) {
+    if constexpr (m_OverAligned) {
+      return static_cast<T *>(
+          ::operator new(count * sizeof(T), std::align_val_t{alignof(T)}));
+    } else {
+      void *data = std::malloc(count * sizeof(T));
+      if (data == nullptr) {
+        throw std::bad_alloc();
+      }
+      return static_cast<T *>(data);
+    }
+  }
+
+  void deallocate(T *data, size_type count) {
+    if constexpr (m_OverAligned) {
+      ::operator delete(data, count * sizeof(T), std::align_val_t{alignof(T)});
+    } else {
+      (void)count;
+      std::free(static_cast<void *>(data));
+    }
+  }
+
+  // Resizes a block returned by allocate(), in place when the heap allows it.
+  // Elements are moved bytewise, so T must be trivially relocatable.
+  T *reallocate(T *data, size_type oldCount, size_type newCount) {
+    if constexpr (m_OverAligned) {
+      T *newData = allocate(newCount);
+      std::memcpy(static_cast<void *>(newData), static_cast<void *>(data),
+                  (oldCount < newCount ? oldCount : newCount) * sizeof(T));
+      deallocate(data, oldCount);
+      return newData;
+    } else {
+      void *newData =
+          std::realloc(static_cast<void *>(data), newCount * sizeof(T));
+      if (newData == nullptr) {
+        throw std::bad_alloc();
+      }
+      return static_cast<T *>(newData);
+    }
+  }
+
+  template <typename U>
+  friend constexpr bool operator==(Allocator const &, Allocator<U> const &) {
+    return true;
+  }
+
+private:
+  static constexpr bool m_OverAligned =
+      alignof(T) > alignof(std::max_align_t);
+};
+
+// Hands out blocks aligned to Alignment bytes (64 by default, a cache line
+// and an AVX-512 register), so data() can be fed to aligned SIMD loads.
+template <typename T, std::size_t Alignment = 64>
+class AlignedAllocator {
+public:
+  static_assert((Alignment & (Alignment - 1)) == 0,
+                "Alignment must be a power of two");
+  static_assert(Alignment >= alignof(T),
+                "Alignment must not be below the element's own");
+
+  using value_type = T;
+  using size_type = std::size_t;
+
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal = std::true_type;
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+public:
+  constexpr AlignedAllocator() = default;
+
+  template <typename U>
+  constexpr AlignedAllocator(AlignedAllocator<U, Alignment> const &) {}
+
+  T *allocate(size_type count) {
+    return static_cast<T *>(
+        ::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+  }
+
+  void deallocate(T *data, size_type count) {
+    ::operator delete(data, count * sizeof(T), std::align_val_t{Alignment});
+  }
+
+  template <typename U>
+  friend constexpr bool operator==(AlignedAllocator const &,
+                                   AlignedAllocator<U, Alignment> const &) {
+    return true;
+  }
+};
+
+// Aligned allocator that maps blocks of at least Threshold bytes straight
+// from the kernel, 2 MiB aligned and marked MADV_HUGEPAGE, so that multi-GB
+// buffers are backed by transparent huge pages and take far fewer TLB
+// misses. Mapped blocks are resized with mremap, which moves page tables
+// rather than bytes. Smaller blocks, and every block on systems without
+// mmap, behave as in AlignedAllocator.
+template <typename T, std::size_t Alignment = 64,
+          std::size_t Threshold = std::size_t{2} << 20>
+class HugePageAllocator {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal = std::true_type;
+
+  template <typename U>
+  struct rebind {
+    using other = HugePageAllocator<U, Alignment, Threshold>;
+  };
+
+  static constexpr size_type m_HugePageSize = std::size_t{2} << 20;
+
+public:
+  constexpr HugePageAllocator() = default;
+
+  template <typename U>
+  constexpr HugePageAllocator(
+      HugePageAllocator<U, Alignment, Threshold> const &) {}
+
+  T *allocate(size_type count) {
+    size_type bytes = count * sizeof(T);
+    if (!is_mapped(bytes)) {
+      return m_Small.allocate(count);
+    }
+    return static_cast<T *>(map(bytes));
+  }
+
+  void deallocate(T *data, size_type count) {
+    size_type bytes = count * sizeof(T);
+    if (!is_mapped(bytes)) {
+      m_Small.deallocate(data, count);
+      return;
+    }
+    unmap(data, bytes);
+  }
+
+  // Resizes a block from allocate(). Elements are moved bytewise, so T must
+  // be trivially relocatable.
+  T *reallocate(T *data, size_type oldCount, size_type newCount) {
+    size_type oldBytes = oldCount * sizeof(T);
+    size_type newBytes = newCount * sizeof(T);
+
+#if defined(__linux__)
+    if (is_mapped(oldBytes) && is_mapped(newBytes)) {
+      // In place if the pages after the block are free. Otherwise the pages
+      // move onto a fresh 2 MiB-aligned mapping, since wherever the kernel
+      // would pick need not be aligned and would lose the huge pages.
+      void *newData =
+          ::mremap(data, round_up(oldBytes), round_up(newBytes), 0);
+      if (newData == MAP_FAILED) {
+        void *target = map(newBytes);
+        newData = ::mremap(data, round_up(oldBytes), round_up(newBytes),
+                           MREMAP_MAYMOVE | MREMAP_FIXED, target);
+        if (newData == MAP_FAILED) {
+          ::munmap(target, round_up(newBytes));
+          throw std::bad_alloc();
+        }
+      }
+      ::madvise(newData, round_up(newBytes), MADV_HUGEPAGE);
+      return static_cast<T *>(newData);
+    }
+#endif
+
+    T *newData = allocate(newCount);
+    std::memcpy(static_cast<void *>(newData), static_cast<void *>(data),
+                (oldBytes < newBytes ? oldBytes : newBytes));
+    deallocate(data, oldCount);
+    return newData;
+  }
+
+  template <typename U>
+  friend constexpr bool
+  operator==(HugePageAllocator const &,
+             HugePageAllocator<U, Alignment, Threshold> const &) {
+    return true;
+  }
+
+private:
+  static constexpr bool is_mapped(size_type bytes) {
+#if defined(__linux__)
+    return bytes >= Threshold;
+#else
+    (void)bytes;
+    return false;
+#endif
+  }
+
+  static constexpr size_type round_up(size_type bytes) {
+    return (bytes + m_HugePageSize - 1) & ~(m_HugePageSize - 1);
+  }
+
+  static void *map(size_type bytes) {
+#if defined(__linux__)
+    // Over-map by one huge page, then trim both ends to a 2 MiB boundary.
+    size_type size = round_up(bytes);
+    void *raw = ::mmap(nullptr, size + m_HugePageSize, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+
+    auto begin = reinterpret_cast<std::uintptr_t>(raw);
+    auto aligned = (begin + m_HugePageSize - 1) & ~(m_HugePageSize - 1);
+    if (aligned != begin) {
+      ::munmap(raw, aligned - begin);
+    }
+    size_type tail = m_HugePageSize - (aligned - begin);
+    if (tail != 0) {
+      ::munmap(reinterpret_cast<void *>(aligned + size), tail);
+    }
+
+    void *data = reinterpret_cast<void *>(aligned);
+    ::madvise(data, size, MADV_HUGEPAGE);
+    return data;
+#else
+    (void)bytes;
+    return nullptr;
+#endif
+  }
+
+  static void unmap(T *data, size_type bytes) {
+#if defined(__linux__)
+    ::munmap(static_cast<void *>(data), round_up(bytes));
+#else
+    (void)data;
+    (void)bytes;
+#endif
+  }
+
+private:
+  [[no_unique_address]] AlignedAllocator<T, Alignment> m_Small;
+};
+
+} // namespace mystl
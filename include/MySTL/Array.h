@@ -42,7 +42,9 @@ public:
 
   constexpr iterator end() { return iterator{m_Data + Size}; }
   constexpr const_iterator end() const { return cend(); }
-  constexpr const_iterator cend() { return const_iterator{m_Data + Size}; }
+  constexpr const_iterator cend() const {
+    return const_iterator{m_Data + Size};
+  }
 
   template <typename Self>
   constexpr auto &&data(this Self &&self) {
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace mystl {
+
+// Granularity at which cores keep memory coherent. Fields written by
+// different threads are kept at least this far apart so that one thread's
+// stores do not keep invalidating the line another thread is reading
+// (false sharing). 64 bytes on x86-64 and most ARM cores.
+inline constexpr std::size_t cache_line_size = 64;
+
+// Tells the core we are spinning, so it can yield to its sibling
+// hyper-thread and skip the memory-order mis-speculation on exit.
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+namespace internal {
+
+// Parks threads until some condition they polled for may have changed. A
+// waiter calls prepare_wait(), re-checks its condition and then either
+// cancel_wait() or wait(); whoever changes the condition calls notify_one()
+// (or notify_all()). Notifying costs a fence and a load of a line nobody
+// writes while there are no waiters. Sleeping is a futex on Linux and
+// std::atomic::wait elsewhere.
+class event_count {
+public:
+  std::uint32_t prepare_wait() {
+    m_Waiters.fetch_add(1, std::memory_order_seq_cst);
+    // Pairs with the fence in notify_one(): either the notifier sees this
+    // waiter or the waiter's re-check sees the notifier's change.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return m_Epoch.load(std::memory_order_acquire);
+  }
+
+  void cancel_wait() { m_Waiters.fetch_sub(1, std::memory_order_relaxed); }
+
+  // Sleeps until notified after prepare_wait() returned `epoch`. May return
+  // spuriously.
+  void wait(std::uint32_t epoch) {
+#if defined(__linux__)
+    futex(FUTEX_WAIT_PRIVATE, epoch, nullptr);
+#else
+    m_Epoch.wait(epoch, std::memory_order_acquire);
+#endif
+    cancel_wait();
+  }
+
+  // As wait(), but gives up at `deadline`.
+  template <typename Clock, typename Duration>
+  void wait_until(std::uint32_t epoch,
+                  std::chrono::time_point<Clock, Duration> deadline) {
+    auto remaining = deadline - Clock::now();
+    if (remaining > remaining.zero()) {
+#if defined(__linux__)
+      auto ns =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(remaining);
+      timespec timeout{static_cast<std::time_t>(ns.count() / 1000000000),
+                       static_cast<long>(ns.count() % 1000000000)};
+      futex(FUTEX_WAIT_PRIVATE, epoch, &timeout);
+#else
+      // No portable timed atomic wait: poll with a short sleep.
+      while (m_Epoch.load(std::memory_order_acquire) == epoch &&
+             Clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+      }
+#endif
+    }
+    cancel_wait();
+  }
+
+  void notify_one() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_Waiters.load(std::memory_order_relaxed) != 0) {
+      m_Epoch.fetch_add(1, std::memory_order_release);
+#if defined(__linux__)
+      futex(FUTEX_WAKE_PRIVATE, 1, nullptr);
+#else
+      m_Epoch.notify_one();
+#endif
+    }
+  }
+
+  void notify_all() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_Waiters.load(std::memory_order_relaxed) != 0) {
+      m_Epoch.fetch_add(1, std::memory_order_release);
+#if defined(__linux__)
+      futex(FUTEX_WAKE_PRIVATE, INT_MAX, nullptr);
+#else
+      m_Epoch.notify_all();
+#endif
+    }
+  }
+
+private:
+#if defined(__linux__)
+  void futex(int op, std::uint32_t value, timespec const *timeout) {
+    static_assert(sizeof(m_Epoch) == sizeof(std::uint32_t));
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&m_Epoch), op,
+              value, timeout, nullptr, 0);
+  }
+#endif
+
+  std::atomic<std::uint32_t> m_Epoch{0};
+  std::atomic<std::uint32_t> m_Waiters{0};
+};
+
+} // namespace internal
+
+} // namespace mystl
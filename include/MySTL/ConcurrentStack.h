@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Concurrency.h"
+#include "HazardPointer.h"
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace mystl {
+
+// Lock-free LIFO stack (Treiber) for any number of threads. A popping
+// thread protects the top node with a hazard pointer before reading its
+// successor, so nodes are never read after being freed and a recycled node
+// address cannot fool the CAS (ABA). Popped nodes are freed once no thread
+// protects them.
+template <typename T>
+class ConcurrentStack {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+public:
+  ConcurrentStack() = default;
+
+  ConcurrentStack(ConcurrentStack const &) = delete;
+  ConcurrentStack &operator=(ConcurrentStack const &) = delete;
+
+  // No other thread may use the stack any more.
+  ~ConcurrentStack() {
+    Node *node = m_Head.load(std::memory_order_relaxed);
+    while (node != nullptr) {
+      delete std::exchange(node, node->m_Next);
+    }
+  }
+
+  // Only a snapshot while other threads are running.
+  bool empty() const {
+    return m_Head.load(std::memory_order_acquire) == nullptr;
+  }
+
+  void push(T const &val) { emplace(val); }
+
+  void push(T &&val) { emplace(std::move(val)); }
+
+  template <typename... Args>
+  void emplace(Args &&...args) {
+    Node *node = new Node{T{std::forward<Args>(args)...}, nullptr};
+    node->m_Next = m_Head.load(std::memory_order_relaxed);
+    while (!m_Head.compare_exchange_weak(node->m_Next, node,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+    }
+  }
+
+  // Moves the top element into `out`; false when the stack is empty.
+  bool try_pop(T &out) {
+    HazardPointer hazard;
+    Node *node;
+    for (;;) {
+      node = hazard.protect(m_Head);
+      if (node == nullptr) {
+        return false;
+      }
+      if (m_Head.compare_exchange_weak(node, node->m_Next,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    hazard.reset();
+
+    out = std::move(node->m_Value);
+    HazardPointer::retire(node);
+    return true;
+  }
+
+  // Detaches every element with a single exchange and passes them to
+  // `consume`, most recently pushed first. Returns how many there were.
+  template <typename Consume_t>
+  size_type pop_all(Consume_t consume) {
+    Node *node = m_Head.exchange(nullptr, std::memory_order_acquire);
+    size_type count = 0;
+    while (node != nullptr) {
+      Node *next = node->m_Next;
+      consume(std::move(node->m_Value));
+      // A concurrent try_pop() may still be looking at the old top.
+      HazardPointer::retire(node);
+      node = next;
+      ++count;
+    }
+    return count;
+  }
+
+private:
+  struct Node {
+    T m_Value;
+    Node *m_Next;
+  };
+
+  alignas(cache_line_size) std::atomic<Node *> m_Head{nullptr};
+};
+
+} // namespace mystl
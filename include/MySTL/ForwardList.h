@@ -0,0 +1,420 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Iterator.h"
+#include "LinkSort.h"
+#include "MemoryResource.h"
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace mystl {
+
+struct ForwardList_Node_Base {
+  ForwardList_Node_Base *next;
+};
+
+template <typename T>
+struct ForwardList_Node : ForwardList_Node_Base {
+  T data;
+
+  template <typename... Args>
+  ForwardList_Node(ForwardList_Node_Base *_next, Args &&...args)
+      : ForwardList_Node_Base{_next}, data(std::forward<Args>(args)...) {}
+
+  static T &value(ForwardList_Node_Base *link) {
+    return static_cast<ForwardList_Node *>(link)->data;
+  }
+};
+
+// Singly linked list: one link per node instead of List's two, for
+// sequences that are only walked forwards. Positions are named by the node
+// before them, so inserting and erasing take the iterator *before* the
+// element (before_begin() for the front). The last node links to nullptr,
+// which is end(). Like List, every list gets its own node pool by default.
+template <typename T, typename Allocator = mystl::PoolAllocator<T>>
+class ForwardList {
+public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = T const &;
+
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+
+  using allocator_type = Allocator;
+
+  using node_t = ForwardList_Node<T>;
+  using nodeptr_t = ForwardList_Node<T> *;
+  using linkptr_t = ForwardList_Node_Base *;
+  using linkptr_type = linkptr_t;
+
+  using iterator = ForwardIterator<ForwardList>;
+  using const_iterator = ConstForwardIterator<ForwardList>;
+
+public:
+  ForwardList() : m_Alloc(), m_Head{nullptr}, m_Size(0) {}
+
+  explicit ForwardList(Allocator const &alloc)
+      : m_Alloc(alloc), m_Head{nullptr}, m_Size(0) {}
+
+  ForwardList(size_type count, T const &val = T{},
+              Allocator const &alloc = Allocator{})
+      : ForwardList(alloc) {
+    for (size_type i = 0; i < count; ++i) {
+      push_front(val);
+    }
+  }
+
+  ForwardList(std::initializer_list<T> iList,
+              Allocator const &alloc = Allocator{})
+      : ForwardList(alloc) {
+    append_copies(iList.begin(), iList.end());
+  }
+
+  ForwardList(ForwardList const &copy)
+      : ForwardList(Allocator(
+            node_traits::select_on_container_copy_construction(copy.m_Alloc))) {
+    append_copies(copy.begin(), copy.end());
+  }
+
+  ForwardList(ForwardList &&move)
+      : m_Alloc(std::move(move.m_Alloc)), m_Head{nullptr}, m_Size(0) {
+    steal(move);
+  }
+
+  ~ForwardList() { clear(); }
+
+  ForwardList &operator=(ForwardList const &copy) {
+    if (this != &copy) {
+      clear();
+      if constexpr (node_traits::propagate_on_container_copy_assignment::
+                        value) {
+        m_Alloc = copy.m_Alloc;
+      }
+      append_copies(copy.begin(), copy.end());
+    }
+    return *this;
+  }
+
+  ForwardList &operator=(ForwardList &&move) {
+    if (this != &move) {
+      clear();
+      if constexpr (!node_traits::propagate_on_container_move_assignment::
+                        value) {
+        // The nodes belong to another allocator, so move the elements.
+        if (!(m_Alloc == move.m_Alloc)) {
+          splice_after(before_begin(), move);
+          return *this;
+        }
+      } else {
+        m_Alloc = std::move(move.m_Alloc);
+      }
+      steal(move);
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator() const { return allocator_type(m_Alloc); }
+
+  size_type size() const { return m_Size; }
+
+  bool empty() const { return (m_Size == 0); }
+
+  iterator before_begin() { return iterator(&m_Head); }
+  const_iterator before_begin() const { return const_iterator(head_link()); }
+  const_iterator cbefore_begin() const { return before_begin(); }
+
+  iterator begin() { return iterator(m_Head.next); }
+  const_iterator begin() const { return const_iterator(m_Head.next); }
+  const_iterator cbegin() const { return begin(); }
+
+  iterator end() { return iterator(nullptr); }
+  const_iterator end() const { return const_iterator(nullptr); }
+  const_iterator cend() const { return end(); }
+
+  T &front() {
+    assert(!empty());
+    return node_t::value(m_Head.next);
+  }
+
+  T const &front() const {
+    assert(!empty());
+    return node_t::value(m_Head.next);
+  }
+
+  // Modifiers
+
+  void clear() {
+    // Nothing to destroy and nobody else in the pool: drop whole chunks.
+    if constexpr (std::is_trivially_destructible_v<T> && m_CanReleasePool) {
+      if (m_Size == 0 || m_Alloc.release_if_unshared()) {
+        m_Head.next = nullptr;
+        m_Size = 0;
+        return;
+      }
+    }
+
+    linkptr_t link = m_Head.next;
+    while (link != nullptr) {
+      linkptr_t next = link->next;
+      destroy_node(link);
+      link = next;
+    }
+    m_Head.next = nullptr;
+    m_Size = 0;
+  }
+
+  void push_front(T const &val) { emplace_front(val); }
+
+  void push_front(T &&val) { emplace_front(std::move(val)); }
+
+  template <typename... Args>
+  void emplace_front(Args &&...args) {
+    emplace_after(cbefore_begin(), std::forward<Args>(args)...);
+  }
+
+  void pop_front() {
+    if (!empty()) {
+      erase_after(cbefore_begin());
+    }
+  }
+
+  iterator insert_after(const_iterator pos, T const &val) {
+    return emplace_after(pos, val);
+  }
+
+  iterator insert_after(const_iterator pos, T &&val) {
+    return emplace_after(pos, std::move(val));
+  }
+
+  template <typename... Args>
+  iterator emplace_after(const_iterator pos, Args &&...args) {
+    linkptr_t prev = pos.m_ProxyData;
+    nodeptr_t created = node_traits::allocate(m_Alloc, 1);
+    std::construct_at(created, prev->next, std::forward<Args>(args)...);
+    prev->next = created;
+    ++m_Size;
+    return iterator(created);
+  }
+
+  // Erases the element after `pos` and returns the one after that.
+  iterator erase_after(const_iterator pos) {
+    linkptr_t prev = pos.m_ProxyData;
+    linkptr_t target = prev->next;
+    prev->next = target->next;
+    destroy_node(target);
+    --m_Size;
+    return iterator(prev->next);
+  }
+
+  // Erases the elements strictly between `first` and `last`.
+  iterator erase_after(const_iterator first, const_iterator last) {
+    linkptr_t prev = first.m_ProxyData;
+    linkptr_t stop = last.m_ProxyData;
+    while (prev->next != stop) {
+      linkptr_t target = prev->next;
+      prev->next = target->next;
+      destroy_node(target);
+      --m_Size;
+    }
+    return iterator(stop);
+  }
+
+  // Operations
+
+  // Nodes are relinked, never copied, as long as both lists share an
+  // allocator (equal allocators). Otherwise the elements are moved into
+  // new nodes of this list. Finding the end of the moved run and counting
+  // it is O(length); moving a single element is O(1).
+
+  // Moves every element of `other` after `pos`.
+  void splice_after(const_iterator pos, ForwardList &other) {
+    assert(this != &other);
+    splice_after(pos, other, other.cbefore_begin(), other.cend());
+  }
+
+  void splice_after(const_iterator pos, ForwardList &&other) {
+    splice_after(pos, other);
+  }
+
+  // Moves the element after `it` to after `pos`.
+  void splice_after(const_iterator pos, ForwardList &other,
+                    const_iterator it) {
+    linkptr_t prev = it.m_ProxyData;
+    linkptr_t node = prev->next;
+    linkptr_t at = pos.m_ProxyData;
+    if (at == prev || at == node) {
+      return;
+    }
+
+    if (this != &other && !shares_nodes_with(other)) {
+      emplace_after(pos, std::move(node_t::value(node)));
+      other.erase_after(it);
+      return;
+    }
+
+    prev->next = node->next;
+    node->next = at->next;
+    at->next = node;
+    --other.m_Size;
+    ++m_Size;
+  }
+
+  void splice_after(const_iterator pos, ForwardList &&other,
+                    const_iterator it) {
+    splice_after(pos, other, it);
+  }
+
+  // Moves the elements strictly between `first` and `last` to after `pos`.
+  void splice_after(const_iterator pos, ForwardList &other,
+                    const_iterator first, const_iterator last) {
+    linkptr_t before = first.m_ProxyData;
+    linkptr_t stop = last.m_ProxyData;
+    if (before->next == stop) {
+      return;
+    }
+
+    if (this != &other && !shares_nodes_with(other)) {
+      const_iterator at = pos;
+      for (linkptr_t link = before->next; link != stop; link = link->next) {
+        at = emplace_after(at, std::move(node_t::value(link)));
+      }
+      other.erase_after(first, last);
+      return;
+    }
+
+    size_type count = 1;
+    linkptr_t back = before->next;
+    while (back->next != stop) {
+      back = back->next;
+      ++count;
+    }
+
+    linkptr_t at = pos.m_ProxyData;
+    back->next = at->next;
+    at->next = before->next;
+    before->next = stop;
+    other.m_Size -= count;
+    m_Size += count;
+  }
+
+  void splice_after(const_iterator pos, ForwardList &&other,
+                    const_iterator first, const_iterator last) {
+    splice_after(pos, other, first, last);
+  }
+
+  // Both lists must be sorted; `other` is left empty. Stable.
+  void merge(ForwardList &other) { merge(other, std::less<>()); }
+  void merge(ForwardList &&other) { merge(other, std::less<>()); }
+
+  template <typename Compare>
+  void merge(ForwardList &other, Compare comp) {
+    if (this == &other || other.empty()) {
+      return;
+    }
+
+    if (!shares_nodes_with(other)) {
+      ForwardList moved(get_allocator());
+      moved.splice_after(moved.cbefore_begin(), other);
+      merge(moved, comp);
+      return;
+    }
+
+    m_Head.next = internal::merge_link_chains<node_t>(
+        m_Head.next, other.m_Head.next, comp);
+    m_Size += other.m_Size;
+    other.m_Head.next = nullptr;
+    other.m_Size = 0;
+  }
+
+  template <typename Compare>
+  void merge(ForwardList &&other, Compare comp) {
+    merge(other, comp);
+  }
+
+  // Stable bottom-up merge sort: O(n log n), no allocation and no element
+  // copies. `comp` must not throw.
+  void sort() { sort(std::less<>()); }
+
+  template <typename Compare>
+  void sort(Compare comp) {
+    m_Head.next = internal::sort_link_chain<node_t>(m_Head.next, comp);
+  }
+
+  void reverse() {
+    linkptr_t reversed = nullptr;
+    linkptr_t link = m_Head.next;
+    while (link != nullptr) {
+      linkptr_t next = link->next;
+      link->next = reversed;
+      reversed = link;
+      link = next;
+    }
+    m_Head.next = reversed;
+  }
+
+private:
+  using node_allocator_t = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<node_t>;
+  using node_traits = std::allocator_traits<node_allocator_t>;
+
+  static constexpr bool m_CanReleasePool =
+      requires(node_allocator_t &alloc) {
+        { alloc.release_if_unshared() } -> std::same_as<bool>;
+      };
+
+  // Const iterators never write through the head link.
+  linkptr_t head_link() const { return const_cast<linkptr_t>(&m_Head); }
+
+  void destroy_node(linkptr_t link) {
+    nodeptr_t node = static_cast<nodeptr_t>(link);
+    std::destroy_at(node);
+    node_traits::deallocate(m_Alloc, node, 1);
+  }
+
+  bool shares_nodes_with(ForwardList const &other) const {
+    if constexpr (node_traits::is_always_equal::value) {
+      return true;
+    } else {
+      return m_Alloc == other.m_Alloc;
+    }
+  }
+
+  template <typename Iter_t>
+  void append_copies(Iter_t first, Iter_t last) {
+    const_iterator back = cbefore_begin();
+    for (; first != last; ++first) {
+      back = emplace_after(back, *first);
+    }
+  }
+
+  // Takes the nodes of `other`, which must use an equal allocator.
+  void steal(ForwardList &other) {
+    m_Head.next = other.m_Head.next;
+    m_Size = other.m_Size;
+    other.m_Head.next = nullptr;
+    other.m_Size = 0;
+  }
+
+private:
+  [[no_unique_address]] node_allocator_t m_Alloc;
+  ForwardList_Node_Base m_Head;
+  size_type m_Size;
+};
+
+namespace pmr {
+
+template <typename T>
+using ForwardList = mystl::ForwardList<T, PolymorphicAllocator<T>>;
+
+} // namespace pmr
+
+} // namespace mystl
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+
+namespace mystl {
+
+// A growth policy decides how much capacity a container reserves.
+//
+//   grow(capacity, required)  -> new capacity, always >= required
+//   shrink(size, capacity)    -> capacity to shrink to, or `capacity` to keep
+//
+// shrink() must leave a gap between the point where a buffer shrinks and the
+// point where it grows again, otherwise alternating push/pop around that
+// boundary reallocates on every call.
+
+// Multiplies the capacity by Numerator / Denominator (1.5 by default), which
+// gives amortized O(1) push_back.
+template <std::size_t Numerator = 3, std::size_t Denominator = 2>
+struct GeometricGrowth {
+  static_assert(Numerator > Denominator, "Growth factor must be above 1");
+
+  static constexpr std::size_t m_MinCapacity = 4;
+
+  static constexpr std::size_t grow(std::size_t capacity,
+                                    std::size_t required) {
+    std::size_t next = capacity / Denominator * Numerator +
+                       capacity % Denominator * Numerator / Denominator;
+    if (next < m_MinCapacity) {
+      next = m_MinCapacity;
+    }
+    return next < required ? required : next;
+  }
+
+  // Shrink once at most a quarter of the buffer is used, and only down to
+  // twice the size so the next growth is still several inserts away.
+  static constexpr std::size_t shrink(std::size_t size, std::size_t capacity) {
+    if (capacity <= m_MinCapacity || size > capacity / 4) {
+      return capacity;
+    }
+    return size * 2 < m_MinCapacity ? m_MinCapacity : size * 2;
+  }
+};
+
+// Adds Step elements at a time. Memory overhead is bounded by Step, but
+// filling the container is quadratic, so only use it for small sizes.
+template <std::size_t Step = 64>
+struct FixedStepGrowth {
+  static_assert(Step > 0, "Growth step must be positive");
+
+  static constexpr std::size_t grow(std::size_t capacity,
+                                    std::size_t required) {
+    std::size_t next = capacity + Step;
+    return next < required ? required : next;
+  }
+
+  static constexpr std::size_t shrink(std::size_t size, std::size_t capacity) {
+    if (capacity - size <= 2 * Step) {
+      return capacity;
+    }
+    return size + Step;
+  }
+};
+
+// Keeps the capacity a power of two, which lets callers index with a mask.
+struct PowerOfTwoGrowth {
+  static constexpr std::size_t grow(std::size_t capacity,
+                                    std::size_t required) {
+    std::size_t next = capacity == 0 ? 1 : capacity * 2;
+    return next < required ? std::bit_ceil(required) : next;
+  }
+
+  static constexpr std::size_t shrink(std::size_t size, std::size_t capacity) {
+    if (size > capacity / 4) {
+      return capacity;
+    }
+    return size == 0 ? 0 : std::bit_ceil(size * 2);
+  }
+};
+
+} // namespace mystl
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "Vector.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+namespace mystl {
+
+namespace internal {
+
+// One published "I am reading this node" slot. Records are owned by one
+// thread at a time and never freed, so there are as many as the peak number
+// of hazard pointers alive at once.
+struct hazard_record {
+  std::atomic<void const *> m_Pointer{nullptr};
+  std::atomic<bool> m_Active{false};
+  hazard_record *m_Next = nullptr;
+};
+
+// A node that has been unlinked but may still be read by another thread.
+struct retired_node {
+  void *m_Pointer;
+  void (*m_Deleter)(void *);
+};
+
+// The process-wide list of hazard records, plus nodes left behind by
+// threads that exited while the nodes were still protected.
+class hazard_domain {
+public:
+  static hazard_domain &instance() {
+    static hazard_domain domain;
+    return domain;
+  }
+
+  ~hazard_domain() {
+    // Every thread is gone, so nothing can be protected any more.
+    for (retired_node node : m_Orphans) {
+      node.m_Deleter(node.m_Pointer);
+    }
+    hazard_record *record = m_Records.load(std::memory_order_relaxed);
+    while (record != nullptr) {
+      delete std::exchange(record, record->m_Next);
+    }
+  }
+
+  hazard_record *acquire() {
+    for (hazard_record *record = m_Records.load(std::memory_order_acquire);
+         record != nullptr; record = record->m_Next) {
+      bool expected = false;
+      if (!record->m_Active.load(std::memory_order_relaxed) &&
+          record->m_Active.compare_exchange_strong(
+              expected, true, std::memory_order_acquire)) {
+        return record;
+      }
+    }
+
+    auto *record = new hazard_record;
+    record->m_Active.store(true, std::memory_order_relaxed);
+    record->m_Next = m_Records.load(std::memory_order_relaxed);
+    while (!m_Records.compare_exchange_weak(record->m_Next, record,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+    }
+    m_RecordCount.fetch_add(1, std::memory_order_relaxed);
+    return record;
+  }
+
+  void release(hazard_record *record) {
+    record->m_Pointer.store(nullptr, std::memory_order_release);
+    record->m_Active.store(false, std::memory_order_release);
+  }
+
+  std::size_t record_count() const {
+    return m_RecordCount.load(std::memory_order_relaxed);
+  }
+
+  // Replaces `into` with the pointers currently protected, sorted.
+  void protected_pointers(Vector<void const *> &into) const {
+    into.clear();
+    for (hazard_record *record = m_Records.load(std::memory_order_acquire);
+         record != nullptr; record = record->m_Next) {
+      void const *pointer = record->m_Pointer.load(std::memory_order_seq_cst);
+      if (pointer != nullptr) {
+        into.push_back(pointer);
+      }
+    }
+    std::sort(into.begin(), into.end());
+  }
+
+  void adopt_orphans(Vector<retired_node> &into) {
+    std::lock_guard lock(m_OrphanMutex);
+    for (retired_node node : m_Orphans) {
+      into.push_back(node);
+    }
+    m_Orphans.clear();
+  }
+
+  void leave_orphans(Vector<retired_node> &from) {
+    std::lock_guard lock(m_OrphanMutex);
+    for (retired_node node : from) {
+      m_Orphans.push_back(node);
+    }
+  }
+
+private:
+  hazard_domain() = default;
+
+  std::atomic<hazard_record *> m_Records{nullptr};
+  std::atomic<std::size_t> m_RecordCount{0};
+
+  std::mutex m_OrphanMutex;
+  Vector<retired_node> m_Orphans;
+};
+
+// The calling thread's spare hazard records and the nodes it has retired.
+class hazard_thread {
+public:
+  static hazard_thread &instance() {
+    static thread_local hazard_thread local;
+    return local;
+  }
+
+  ~hazard_thread() {
+    scan();
+    if (!m_Retired.empty()) {
+      m_Domain.leave_orphans(m_Retired);
+    }
+    for (hazard_record *record : m_Spare) {
+      m_Domain.release(record);
+    }
+  }
+
+  // A record no other hazard pointer is using. Records go back to this
+  // thread's spares rather than the domain, so after the first few this
+  // does not touch shared state.
+  hazard_record *acquire() {
+    if (m_Spare.empty()) {
+      return m_Domain.acquire();
+    }
+    hazard_record *record = m_Spare.back();
+    m_Spare.pop_back();
+    return record;
+  }
+
+  void release(hazard_record *record) {
+    record->m_Pointer.store(nullptr, std::memory_order_release);
+    m_Spare.push_back(record);
+  }
+
+  void retire(void *pointer, void (*deleter)(void *)) {
+    m_Retired.push_back({pointer, deleter});
+    // Twice the number of records keeps at least half of each scan's nodes
+    // freeable. A scan costs O(R log H) for R retired nodes and H records,
+    // so reclamation is amortized O(log H) per node.
+    if (m_Retired.size() >= 2 * m_Domain.record_count() + m_MinScan) {
+      scan();
+    }
+  }
+
+  // Frees every retired node that no thread protects. The hazard pointers
+  // are read once and looked up by binary search.
+  void scan() {
+    m_Domain.adopt_orphans(m_Retired);
+    m_Domain.protected_pointers(m_Protected);
+
+    Vector<retired_node> kept;
+    for (retired_node node : m_Retired) {
+      if (std::binary_search(m_Protected.begin(), m_Protected.end(),
+                             static_cast<void const *>(node.m_Pointer))) {
+        kept.push_back(node);
+      } else {
+        node.m_Deleter(node.m_Pointer);
+      }
+    }
+    m_Retired = std::move(kept);
+  }
+
+private:
+  hazard_thread() : m_Domain(hazard_domain::instance()) {}
+
+  static constexpr std::size_t m_MinScan = 64;
+
+  hazard_domain &m_Domain;
+  Vector<hazard_record *> m_Spare;
+  Vector<retired_node> m_Retired;
+  Vector<void const *> m_Protected;
+};
+
+} // namespace internal
+
+// Hazard pointers (Michael, 2004) for lock-free structures that free nodes
+// other threads may still be reading. A reader publishes the node it is about
+// to dereference with protect(); a writer that unlinked a node hands it to
+// retire(), which frees it only once no thread has it published.
+//
+// Every HazardPointer has a record of its own, so a thread can protect
+// several nodes at once, e.g. a node and its successor.
+class HazardPointer {
+public:
+  HazardPointer() : m_Record(*internal::hazard_thread::instance().acquire()) {}
+
+  HazardPointer(HazardPointer const &) = delete;
+  HazardPointer &operator=(HazardPointer const &) = delete;
+
+  ~HazardPointer() { internal::hazard_thread::instance().release(&m_Record); }
+
+  // Loads `source` and publishes the result, retrying until the published
+  // pointer is still the current value, so it cannot have been retired
+  // before it was protected.
+  template <typename T>
+  T *protect(std::atomic<T *> const &source) {
+    T *pointer = source.load(std::memory_order_relaxed);
+    for (;;) {
+      m_Record.m_Pointer.store(pointer, std::memory_order_seq_cst);
+      T *current = source.load(std::memory_order_seq_cst);
+      if (current == pointer) {
+        return pointer;
+      }
+      pointer = current;
+    }
+  }
+
+  void reset() {
+    m_Record.m_Pointer.store(nullptr, std::memory_order_release);
+  }
+
+  // Frees `pointer` with `delete` once no thread protects it.
+  template <typename T>
+  static void retire(T *pointer) {
+    internal::hazard_thread::instance().retire(
+        pointer, [](void *node) { delete static_cast<T *>(node); });
+  }
+
+private:
+  internal::hazard_record &m_Record;
+};
+
+} // namespace mystl
@@ -0,0 +1,305 @@
+#pragma once
+
+#include "Iterator.h"
+#include "MySTL/algorithms.h"
+#include <cassert>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace mystl {
+
+namespace internal {
+
+template <typename T>
+inline constexpr bool is_inplace_trivial_v =
+    std::is_trivially_default_constructible_v<T> &&
+    std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>;
+
+// Trivial elements live in a plain array, left uninitialized so that a new
+// vector costs nothing; constant evaluation only ever reads the slots below
+// size(). Everything else lives in a union so that slots past size() are
+// never constructed.
+template <typename T, std::size_t Capacity, bool = is_inplace_trivial_v<T>>
+struct inplace_storage {
+  union {
+    T m_Data[Capacity];
+  };
+
+  constexpr inplace_storage() {}
+  constexpr ~inplace_storage() {}
+};
+
+template <typename T, std::size_t Capacity>
+struct inplace_storage<T, Capacity, true> {
+  T m_Data[Capacity];
+};
+
+template <typename T>
+struct inplace_storage<T, 0, false> {
+  static constexpr T *m_Data = nullptr;
+};
+
+template <typename T>
+struct inplace_storage<T, 0, true> {
+  static constexpr T *m_Data = nullptr;
+};
+
+} // namespace internal
+
+// A vector with a fixed capacity and no heap at all, modelled on C++26
+// std::inplace_vector. push_back() throws std::bad_alloc when full,
+// try_push_back() returns nullptr instead and unchecked_push_back() asserts.
+// Usable in constant expressions.
+template <typename T, std::size_t Capacity>
+class InplaceVector {
+public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = T const &;
+
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+
+  using iterator = ContiguousIterator<InplaceVector>;
+  using const_iterator = ConstContiguousIterator<InplaceVector>;
+
+public:
+  constexpr explicit InplaceVector() : m_Size(0) {}
+
+  constexpr explicit InplaceVector(size_type size, const T &val = T{})
+      : InplaceVector{} {
+    resize(size, val);
+  }
+
+  constexpr explicit InplaceVector(std::initializer_list<T> iList)
+      : InplaceVector{} {
+    if (iList.size() > Capacity) {
+      throw std::bad_alloc();
+    }
+    for (const T &val : iList) {
+      unchecked_emplace_back(val);
+    }
+  }
+
+  constexpr InplaceVector(const InplaceVector &copy) : InplaceVector{} {
+    for (size_type i = 0; i < copy.m_Size; ++i) {
+      unchecked_emplace_back(copy.m_Storage.m_Data[i]);
+    }
+  }
+
+  constexpr InplaceVector(InplaceVector &&move) : InplaceVector{} {
+    for (size_type i = 0; i < move.m_Size; ++i) {
+      unchecked_emplace_back(std::move(move.m_Storage.m_Data[i]));
+    }
+    move.clear();
+  }
+
+  constexpr ~InplaceVector()
+    requires std::is_trivially_destructible_v<T>
+  = default;
+
+  constexpr ~InplaceVector() { clear(); }
+
+  constexpr InplaceVector &operator=(const InplaceVector &copy) {
+    if (this != &copy) {
+      clear();
+      for (size_type i = 0; i < copy.m_Size; ++i) {
+        unchecked_emplace_back(copy.m_Storage.m_Data[i]);
+      }
+    }
+    return *this;
+  }
+
+  constexpr InplaceVector &operator=(InplaceVector &&move) {
+    if (this != &move) {
+      clear();
+      for (size_type i = 0; i < move.m_Size; ++i) {
+        unchecked_emplace_back(std::move(move.m_Storage.m_Data[i]));
+      }
+      move.clear();
+    }
+    return *this;
+  }
+
+  static constexpr size_type capacity() { return Capacity; }
+  static constexpr size_type max_size() { return Capacity; }
+
+  constexpr size_type size() const { return m_Size; }
+
+  constexpr bool empty() const { return (m_Size == 0); }
+
+  constexpr pointer data() { return m_Storage.m_Data; }
+  constexpr const_pointer data() const { return m_Storage.m_Data; }
+
+  constexpr iterator begin() { return iterator{data()}; }
+  constexpr const_iterator begin() const { return cbegin(); }
+  constexpr const_iterator cbegin() const { return const_iterator{data()}; }
+
+  constexpr iterator end() { return iterator{data() + m_Size}; }
+  constexpr const_iterator end() const { return cend(); }
+  constexpr const_iterator cend() const {
+    return const_iterator{data() + m_Size};
+  }
+
+  template <typename Self>
+  constexpr auto &&operator[](this Self &&self, size_type index) {
+    if (index >= self.m_Size) {
+      throw std::out_of_range("InplaceVector index out of range");
+    }
+    return std::forward<Self>(self).m_Storage.m_Data[index];
+  }
+
+  template <typename Self>
+  constexpr auto &&front(this Self &&self) {
+    return std::forward<Self>(self)[0];
+  }
+
+  template <typename Self>
+  constexpr auto &&back(this Self &&self) {
+    return std::forward<Self>(self)[self.m_Size - 1];
+  }
+
+  // Modifiers
+
+  constexpr void clear() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (size_type i = 0; i < m_Size; ++i) {
+        std::destroy_at(data() + i);
+      }
+    }
+    m_Size = 0;
+  }
+
+  template <typename... Args>
+  constexpr reference emplace_back(Args &&...args) {
+    if (m_Size == Capacity) {
+      throw std::bad_alloc();
+    }
+    return unchecked_emplace_back(std::forward<Args>(args)...);
+  }
+
+  constexpr reference push_back(const T &val) { return emplace_back(val); }
+  constexpr reference push_back(T &&val) {
+    return emplace_back(std::move(val));
+  }
+
+  // Returns a pointer to the new element, or nullptr when full.
+  template <typename... Args>
+  constexpr pointer try_emplace_back(Args &&...args) {
+    if (m_Size == Capacity) {
+      return nullptr;
+    }
+    return &unchecked_emplace_back(std::forward<Args>(args)...);
+  }
+
+  constexpr pointer try_push_back(const T &val) {
+    return try_emplace_back(val);
+  }
+  constexpr pointer try_push_back(T &&val) {
+    return try_emplace_back(std::move(val));
+  }
+
+  // The caller guarantees there is room; no capacity check in release builds.
+  template <typename... Args>
+  constexpr reference unchecked_emplace_back(Args &&...args) {
+    assert(m_Size < Capacity);
+    construct_slot(m_Size, std::forward<Args>(args)...);
+    return m_Storage.m_Data[m_Size++];
+  }
+
+  constexpr reference unchecked_push_back(const T &val) {
+    return unchecked_emplace_back(val);
+  }
+  constexpr reference unchecked_push_back(T &&val) {
+    return unchecked_emplace_back(std::move(val));
+  }
+
+  constexpr void pop_back() {
+    if (m_Size <= 0) {
+      return;
+    }
+    --m_Size;
+    destroy_slot(m_Size);
+  }
+
+  constexpr void resize(size_type size, const T &val = T{}) {
+    if (size > Capacity) {
+      throw std::bad_alloc();
+    }
+    while (m_Size > size) {
+      pop_back();
+    }
+    while (m_Size < size) {
+      unchecked_emplace_back(val);
+    }
+  }
+
+  constexpr void insert(size_type pos, const T &val = T{},
+                        size_type count = 1) {
+    size_type newSize = algo::max(m_Size, pos) + count;
+    if (newSize > Capacity) {
+      throw std::bad_alloc();
+    }
+
+    // if pos > current size, default init the gap values
+    while (m_Size < pos) {
+      unchecked_emplace_back();
+    }
+
+    // shift the tail back to make room for the new values
+    for (size_type i = m_Size; i > pos; --i) {
+      construct_slot(i - 1 + count, std::move(m_Storage.m_Data[i - 1]));
+      destroy_slot(i - 1);
+    }
+
+    for (size_type i = pos; i < pos + count; ++i) {
+      construct_slot(i, val);
+    }
+    m_Size = newSize;
+  }
+
+  constexpr void erase(size_type pos, size_type count = 1) {
+    if (pos >= m_Size) {
+      return;
+    }
+
+    count = algo::min(m_Size - pos, count);
+
+    for (size_type i = pos; i < pos + count; ++i) {
+      destroy_slot(i);
+    }
+    for (size_type i = pos + count; i < m_Size; ++i) {
+      construct_slot(i - count, std::move(m_Storage.m_Data[i]));
+      destroy_slot(i);
+    }
+    m_Size -= count;
+  }
+
+private:
+  template <typename... Args>
+  constexpr void construct_slot(size_type index, Args &&...args) {
+    if constexpr (internal::is_inplace_trivial_v<T>) {
+      m_Storage.m_Data[index] = T{std::forward<Args>(args)...};
+    } else {
+      std::construct_at(data() + index, std::forward<Args>(args)...);
+    }
+  }
+
+  constexpr void destroy_slot(size_type index) {
+    if constexpr (!internal::is_inplace_trivial_v<T>) {
+      std::destroy_at(data() + index);
+    }
+  }
+
+private:
+  [[no_unique_address]] internal::inplace_storage<T, Capacity> m_Storage;
+  size_type m_Size;
+};
+
+} // namespace mystl
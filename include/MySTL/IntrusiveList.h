@@ -0,0 +1,285 @@
+#pragma once
+
+#include "Iterator.h"
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+namespace mystl {
+
+// The links an object embeds once for every IntrusiveList it can be in.
+// A hook that is in no list has null links. Copying an object does not
+// copy its list memberships.
+struct IntrusiveListHook {
+  IntrusiveListHook *prev = nullptr;
+  IntrusiveListHook *next = nullptr;
+
+  IntrusiveListHook() = default;
+
+  IntrusiveListHook(IntrusiveListHook const &) {}
+
+  IntrusiveListHook &operator=(IntrusiveListHook const &) { return *this; }
+
+  // Objects must leave their lists before they are destroyed.
+  ~IntrusiveListHook() { assert(!is_linked()); }
+
+  bool is_linked() const { return next != nullptr; }
+};
+
+namespace internal {
+
+// Finds the object a hook is embedded in. Member pointers have no portable
+// constant offset, so the hook's offset is measured on the first real object
+// that reaches a list of this type and kept for the iterators, which only
+// hold a hook. Objects enter a list through hook_of() before any hook is
+// turned back into one, and every T has the same offset, so later
+// measurements only ever rewrite the same value.
+template <typename T, IntrusiveListHook T::*Hook>
+struct intrusive_node {
+  static T &value(IntrusiveListHook *hook) {
+    return *reinterpret_cast<T *>(reinterpret_cast<std::byte *>(hook) -
+                                  m_Offset.load(std::memory_order_relaxed));
+  }
+
+  static IntrusiveListHook *hook_of(T &object) {
+    IntrusiveListHook *hook = &(object.*Hook);
+    std::ptrdiff_t offset = reinterpret_cast<std::byte *>(hook) -
+                            reinterpret_cast<std::byte *>(&object);
+    // Read first, so lists on several threads do not keep writing the
+    // shared line.
+    if (m_Offset.load(std::memory_order_relaxed) != offset) {
+      m_Offset.store(offset, std::memory_order_relaxed);
+    }
+    return hook;
+  }
+
+  static inline std::atomic<std::ptrdiff_t> m_Offset{0};
+};
+
+} // namespace internal
+
+// Doubly linked list of objects the caller owns, linked through the member
+// `Hook` of each object:
+//
+//   struct Entry {
+//     IntrusiveListHook m_Lru;
+//     IntrusiveListHook m_Timers;
+//   };
+//   IntrusiveList<Entry, &Entry::m_Lru> lru;
+//
+// An object with several hooks can be in several lists at once. The list
+// never allocates, copies or destroys the objects, and any object can be
+// unlinked in O(1) with erase(object). Objects must outlive their
+// membership; clear() or the destructor unlinks whatever is left.
+template <typename T, IntrusiveListHook T::*Hook>
+class IntrusiveList {
+public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = T const &;
+
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+
+  using node_t = internal::intrusive_node<T, Hook>;
+  using linkptr_t = IntrusiveListHook *;
+  using linkptr_type = linkptr_t;
+
+  using iterator = BidirectionalIterator<IntrusiveList>;
+  using const_iterator = ConstBidirectionalIterator<IntrusiveList>;
+
+public:
+  IntrusiveList() : m_Header(), m_Size(0) { reset_header(); }
+
+  IntrusiveList(IntrusiveList const &) = delete;
+  IntrusiveList &operator=(IntrusiveList const &) = delete;
+
+  IntrusiveList(IntrusiveList &&move) : m_Header(), m_Size(0) {
+    reset_header();
+    steal(move);
+  }
+
+  IntrusiveList &operator=(IntrusiveList &&move) {
+    if (this != &move) {
+      clear();
+      steal(move);
+    }
+    return *this;
+  }
+
+  ~IntrusiveList() {
+    clear();
+    // The header is a hook too; leave it unlinked for its own destructor.
+    m_Header.prev = nullptr;
+    m_Header.next = nullptr;
+  }
+
+  size_type size() const { return m_Size; }
+
+  bool empty() const { return (m_Size == 0); }
+
+  iterator begin() { return iterator(m_Header.next); }
+  const_iterator begin() const { return const_iterator(m_Header.next); }
+  const_iterator cbegin() const { return begin(); }
+
+  iterator end() { return iterator(end_link()); }
+  const_iterator end() const { return const_iterator(end_link()); }
+  const_iterator cend() const { return end(); }
+
+  // The position of an object that is in this list.
+  iterator iterator_to(T &object) { return iterator(node_t::hook_of(object)); }
+
+  T &front() {
+    assert(!empty());
+    return node_t::value(m_Header.next);
+  }
+
+  T const &front() const {
+    assert(!empty());
+    return node_t::value(m_Header.next);
+  }
+
+  T &back() {
+    assert(!empty());
+    return node_t::value(m_Header.prev);
+  }
+
+  T const &back() const {
+    assert(!empty());
+    return node_t::value(m_Header.prev);
+  }
+
+  // Modifiers
+
+  // Unlinks every object, in O(size()), so they can join lists again.
+  void clear() {
+    linkptr_t link = m_Header.next;
+    while (link != &m_Header) {
+      linkptr_t next = link->next;
+      link->prev = nullptr;
+      link->next = nullptr;
+      link = next;
+    }
+    reset_header();
+  }
+
+  // `object` must not be in a list through this hook already.
+  iterator insert(const_iterator pos, T &object) {
+    linkptr_t hook = node_t::hook_of(object);
+    assert(!hook->is_linked());
+    link_before(pos.m_ProxyData, hook);
+    return iterator(hook);
+  }
+
+  void push_back(T &object) { insert(end(), object); }
+
+  void push_front(T &object) { insert(begin(), object); }
+
+  void pop_back() {
+    if (!empty()) {
+      unlink(m_Header.prev);
+    }
+  }
+
+  void pop_front() {
+    if (!empty()) {
+      unlink(m_Header.next);
+    }
+  }
+
+  // Unlinks the object at `pos` and returns the position after it.
+  iterator erase(const_iterator pos) {
+    linkptr_t hook = pos.m_ProxyData;
+    if (hook == end_link()) {
+      return end();
+    }
+    linkptr_t next = hook->next;
+    unlink(hook);
+    return iterator(next);
+  }
+
+  // Unlinks `object`, which must be in this list.
+  void erase(T &object) { unlink(node_t::hook_of(object)); }
+
+  // Moves every object of `other` before `pos`.
+  void splice(const_iterator pos, IntrusiveList &other) {
+    assert(this != &other);
+    if (other.empty()) {
+      return;
+    }
+
+    linkptr_t first = other.m_Header.next;
+    linkptr_t last = other.m_Header.prev;
+    linkptr_t at = pos.m_ProxyData;
+
+    first->prev = at->prev;
+    last->next = at;
+    at->prev->next = first;
+    at->prev = last;
+
+    m_Size += other.m_Size;
+    other.reset_header();
+  }
+
+  // Moves the object at `it` from `other` (possibly this list) before
+  // `pos`, e.g. splice(begin(), *this, iterator_to(entry)) to mark a cache
+  // entry as most recently used.
+  void splice(const_iterator pos, IntrusiveList &other, const_iterator it) {
+    linkptr_t hook = it.m_ProxyData;
+    if (pos.m_ProxyData == hook || pos.m_ProxyData == hook->next) {
+      return;
+    }
+    other.unlink(hook);
+    link_before(pos.m_ProxyData, hook);
+  }
+
+private:
+  // Const traversal hands out the header through const_iterator, which
+  // never writes through it.
+  linkptr_t end_link() const { return const_cast<linkptr_t>(&m_Header); }
+
+  void reset_header() {
+    m_Header.prev = &m_Header;
+    m_Header.next = &m_Header;
+    m_Size = 0;
+  }
+
+  void link_before(linkptr_t pos, linkptr_t hook) {
+    hook->prev = pos->prev;
+    hook->next = pos;
+    pos->prev->next = hook;
+    pos->prev = hook;
+    ++m_Size;
+  }
+
+  void unlink(linkptr_t hook) {
+    hook->prev->next = hook->next;
+    hook->next->prev = hook->prev;
+    hook->prev = nullptr;
+    hook->next = nullptr;
+    --m_Size;
+  }
+
+  // The first and last objects point at the header, which lives inside the
+  // list.
+  void steal(IntrusiveList &other) {
+    if (other.empty()) {
+      return;
+    }
+    m_Header.prev = other.m_Header.prev;
+    m_Header.next = other.m_Header.next;
+    m_Header.next->prev = &m_Header;
+    m_Header.prev->next = &m_Header;
+    m_Size = other.m_Size;
+    other.reset_header();
+  }
+
+private:
+  IntrusiveListHook m_Header;
+  size_type m_Size;
+};
+
+} // namespace mystl
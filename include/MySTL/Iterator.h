@@ -1,64 +1,121 @@
 #pragma once
 
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
 namespace mystl {
 
 namespace internal {
 
-template <typename nodeptr_type, typename pointer_t, typename reference_t>
+// Standard input iterators (e.g. std::istream_iterator) can only be walked
+// once, so the length of their range is unknown until it has been consumed.
+// Every mystl iterator is multi-pass.
+template <typename Iter_t>
+concept single_pass_iterator =
+    requires { typename std::iterator_traits<Iter_t>::iterator_category; } &&
+    std::same_as<typename std::iterator_traits<Iter_t>::iterator_category,
+                 std::input_iterator_tag>;
+
+} // namespace internal
+
+// The iterators of every container come as a base class holding the
+// position and operators, and thin derived types the container befriends.
+// Each base takes its derived type (Derived_t) so that the operators return
+// it: ++it has to be an It& for It to model the std iterator concepts.
+
+template <typename Container_t>
+struct BidirectionalIterator;
+
+template <typename Container_t>
+struct ConstBidirectionalIterator;
+
+namespace internal {
+
+// Walks the links of a node-based container. Sentinel links without a
+// value can sit in the same chain; node_type::value(link) finds the element
+// a link belongs to.
+template <typename Derived_t, typename linkptr_type, typename node_type,
+          typename pointer_t, typename reference_t>
 class base_bidirect_iter {
 public:
+  using iterator_concept = std::bidirectional_iterator_tag;
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = std::remove_cvref_t<reference_t>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = pointer_t;
+  using reference = reference_t;
+
   constexpr explicit base_bidirect_iter() : m_ProxyData(nullptr) {}
 
-  constexpr explicit base_bidirect_iter(nodeptr_type proxyData)
+  constexpr explicit base_bidirect_iter(linkptr_type proxyData)
       : m_ProxyData(proxyData) {}
 
-  constexpr explicit base_bidirect_iter(const base_bidirect_iter &) = default;
+  constexpr base_bidirect_iter(const base_bidirect_iter &) = default;
+
+  constexpr base_bidirect_iter &
+  operator=(const base_bidirect_iter &) = default;
 
   constexpr ~base_bidirect_iter() = default;
 
-  constexpr pointer_t operator->() const { return &(m_ProxyData->data); }
+  constexpr pointer_t operator->() const {
+    return &node_type::value(m_ProxyData);
+  }
 
-  constexpr reference_t operator*() const { return m_ProxyData->data; }
+  constexpr reference_t operator*() const {
+    return node_type::value(m_ProxyData);
+  }
 
-  constexpr base_bidirect_iter &operator++() {
+  constexpr Derived_t &operator++() {
     m_ProxyData = m_ProxyData->next;
-    return *this;
+    return derived();
   }
 
-  constexpr base_bidirect_iter operator++(int) {
-    auto tmp = *this;
-    (*this).operator++();
+  constexpr Derived_t operator++(int) {
+    Derived_t tmp = derived();
+    ++(*this);
     return tmp;
   }
 
-  constexpr base_bidirect_iter operator--() {
+  constexpr Derived_t &operator--() {
     m_ProxyData = m_ProxyData->prev;
-    return *this;
+    return derived();
   }
 
-  constexpr base_bidirect_iter operator--(int) {
-    auto tmp = *this;
-    (*this).operator--();
+  constexpr Derived_t operator--(int) {
+    Derived_t tmp = derived();
+    --(*this);
     return tmp;
   }
 
-  constexpr bool operator==(const base_bidirect_iter &other) {
+  constexpr bool operator==(const base_bidirect_iter &other) const {
     return (m_ProxyData == other.m_ProxyData);
   }
 
+protected:
+  // Containers reach the node through the derived iterators' friendship.
+  linkptr_type m_ProxyData;
+
 private:
-  nodeptr_type m_ProxyData;
+  constexpr Derived_t &derived() { return static_cast<Derived_t &>(*this); }
 };
 
 template <typename Container_t>
 using BaseBidirectionalIterator_t =
-    base_bidirect_iter<typename Container_t::nodeptr_type,
+    base_bidirect_iter<BidirectionalIterator<Container_t>,
+                       typename Container_t::linkptr_type,
+                       typename Container_t::node_t,
                        typename Container_t::pointer,
                        typename Container_t::reference>;
 
 template <typename Container_t>
 using BaseConstBidirectionalIterator_t =
-    base_bidirect_iter<typename Container_t::nodeptr_type, // const_nodeptr_type
+    base_bidirect_iter<ConstBidirectionalIterator<Container_t>,
+                       typename Container_t::linkptr_type,
+                       typename Container_t::node_t,
                        typename Container_t::const_pointer,
                        typename Container_t::const_reference>;
 
@@ -69,8 +126,12 @@ struct BidirectionalIterator
     : public internal::BaseBidirectionalIterator_t<Container_t> {
   constexpr explicit BidirectionalIterator() = default;
 
-  explicit BidirectionalIterator(Container_t::nodeptr_type proxyData)
+  constexpr explicit BidirectionalIterator(Container_t::linkptr_type proxyData)
       : internal::BaseBidirectionalIterator_t<Container_t>{proxyData} {}
+
+private:
+  friend Container_t;
+  friend struct ConstBidirectionalIterator<Container_t>;
 };
 
 template <typename Container_t>
@@ -79,80 +140,215 @@ struct ConstBidirectionalIterator
   constexpr explicit ConstBidirectionalIterator() = default;
 
   constexpr explicit ConstBidirectionalIterator(
-      Container_t::nodeptr_type proxyData)
+      Container_t::linkptr_type proxyData)
       : internal::BaseConstBidirectionalIterator_t<Container_t>{proxyData} {}
+
+  constexpr ConstBidirectionalIterator(
+      BidirectionalIterator<Container_t> const &other)
+      : ConstBidirectionalIterator{other.m_ProxyData} {}
+
+private:
+  friend Container_t;
 };
 
+template <typename Container_t>
+struct ForwardIterator;
+
+template <typename Container_t>
+struct ConstForwardIterator;
+
 namespace internal {
 
-template <typename pointer_t, typename reference_t, typename difference_t>
+// Walks the `next` links of a singly linked container; otherwise the same
+// as base_bidirect_iter.
+template <typename Derived_t, typename linkptr_type, typename node_type,
+          typename pointer_t, typename reference_t>
+class base_forward_iter {
+public:
+  using iterator_concept = std::forward_iterator_tag;
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = std::remove_cvref_t<reference_t>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = pointer_t;
+  using reference = reference_t;
+
+  constexpr explicit base_forward_iter() : m_ProxyData(nullptr) {}
+
+  constexpr explicit base_forward_iter(linkptr_type proxyData)
+      : m_ProxyData(proxyData) {}
+
+  constexpr base_forward_iter(const base_forward_iter &) = default;
+
+  constexpr base_forward_iter &operator=(const base_forward_iter &) = default;
+
+  constexpr ~base_forward_iter() = default;
+
+  constexpr pointer_t operator->() const {
+    return &node_type::value(m_ProxyData);
+  }
+
+  constexpr reference_t operator*() const {
+    return node_type::value(m_ProxyData);
+  }
+
+  constexpr Derived_t &operator++() {
+    m_ProxyData = m_ProxyData->next;
+    return derived();
+  }
+
+  constexpr Derived_t operator++(int) {
+    Derived_t tmp = derived();
+    ++(*this);
+    return tmp;
+  }
+
+  constexpr bool operator==(const base_forward_iter &other) const {
+    return (m_ProxyData == other.m_ProxyData);
+  }
+
+protected:
+  // Containers reach the node through the derived iterators' friendship.
+  linkptr_type m_ProxyData;
+
+private:
+  constexpr Derived_t &derived() { return static_cast<Derived_t &>(*this); }
+};
+
+template <typename Container_t>
+using BaseForwardIterator_t =
+    base_forward_iter<ForwardIterator<Container_t>,
+                      typename Container_t::linkptr_type,
+                      typename Container_t::node_t,
+                      typename Container_t::pointer,
+                      typename Container_t::reference>;
+
+template <typename Container_t>
+using BaseConstForwardIterator_t =
+    base_forward_iter<ConstForwardIterator<Container_t>,
+                      typename Container_t::linkptr_type,
+                      typename Container_t::node_t,
+                      typename Container_t::const_pointer,
+                      typename Container_t::const_reference>;
+
+} // namespace internal
+
+template <typename Container_t>
+struct ForwardIterator : public internal::BaseForwardIterator_t<Container_t> {
+  constexpr explicit ForwardIterator() = default;
+
+  constexpr explicit ForwardIterator(Container_t::linkptr_type proxyData)
+      : internal::BaseForwardIterator_t<Container_t>{proxyData} {}
+
+private:
+  friend Container_t;
+  friend struct ConstForwardIterator<Container_t>;
+};
+
+template <typename Container_t>
+struct ConstForwardIterator
+    : public internal::BaseConstForwardIterator_t<Container_t> {
+  constexpr explicit ConstForwardIterator() = default;
+
+  constexpr explicit ConstForwardIterator(Container_t::linkptr_type proxyData)
+      : internal::BaseConstForwardIterator_t<Container_t>{proxyData} {}
+
+  constexpr ConstForwardIterator(ForwardIterator<Container_t> const &other)
+      : ConstForwardIterator{other.m_ProxyData} {}
+
+private:
+  friend Container_t;
+};
+
+template <typename Container_t>
+struct ContiguousIterator;
+
+template <typename Container_t>
+struct ConstContiguousIterator;
+
+namespace internal {
+
+// A pointer into an array. Models std::contiguous_iterator, so ranges of
+// it go into std::span and std::to_address, and the standard algorithms
+// take their pointer fast paths (memmove, memcmp) on them.
+template <typename Derived_t, typename pointer_t, typename reference_t,
+          typename difference_t>
 class base_cont_iter {
 public:
-  using pointer_type = pointer_t;
-  using reference_type = reference_t;
+  using iterator_concept = std::contiguous_iterator_tag;
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::remove_cvref_t<reference_t>;
+  using element_type = std::remove_reference_t<reference_t>;
   using difference_type = difference_t;
+  using pointer = pointer_t;
+  using reference = reference_t;
 
   constexpr explicit base_cont_iter() : m_ProxyData{nullptr} {}
 
   constexpr explicit base_cont_iter(pointer_t proyData)
       : m_ProxyData{proyData} {}
 
-  constexpr explicit base_cont_iter(const base_cont_iter &) = default;
+  constexpr base_cont_iter(const base_cont_iter &) = default;
+
+  constexpr base_cont_iter &operator=(const base_cont_iter &) = default;
 
-  ~base_cont_iter() {}
+  constexpr ~base_cont_iter() = default;
 
   constexpr pointer_t operator->() const { return m_ProxyData; }
 
   constexpr reference_t operator*() const { return *m_ProxyData; }
 
-  constexpr base_cont_iter &operator++() {
+  constexpr reference_t operator[](difference_t index) const {
+    return m_ProxyData[index];
+  }
+
+  constexpr Derived_t &operator++() {
     ++m_ProxyData;
-    return *this;
+    return derived();
   }
 
-  constexpr base_cont_iter operator++(int) {
-    base_cont_iter tmp = *this;
+  constexpr Derived_t operator++(int) {
+    Derived_t tmp = derived();
     ++(*this);
     return tmp;
   }
 
-  constexpr base_cont_iter &operator--() {
+  constexpr Derived_t &operator--() {
     --m_ProxyData;
-    return *this;
+    return derived();
   }
 
-  constexpr base_cont_iter operator--(int) {
-    auto tmp = *this;
-    ++(*this);
+  constexpr Derived_t operator--(int) {
+    Derived_t tmp = derived();
+    --(*this);
     return tmp;
   }
 
-  constexpr base_cont_iter &operator+=(difference_t offset) {
+  constexpr Derived_t &operator+=(difference_t offset) {
     m_ProxyData += offset;
-    return *this;
+    return derived();
   }
 
-  constexpr base_cont_iter &operator-=(difference_t offset) {
-    (*this) += -offset;
-    return *this;
+  constexpr Derived_t &operator-=(difference_t offset) {
+    m_ProxyData -= offset;
+    return derived();
   }
 
-  constexpr base_cont_iter operator+(difference_t offset) {
-    auto tmp = *this;
-    return tmp.operator+=(offset);
+  constexpr Derived_t operator+(difference_t offset) const {
+    Derived_t tmp = derived();
+    return tmp += offset;
   }
 
-  constexpr base_cont_iter operator-(difference_t offset) {
-    auto tmp = *this;
-    return tmp.operator-=(offset);
+  friend constexpr Derived_t operator+(difference_t offset,
+                                       Derived_t const &iter) {
+    return iter + offset;
   }
 
-  constexpr base_cont_iter &operator[](difference_t index) {
-    m_ProxyData += index;
-    return *this;
+  constexpr Derived_t operator-(difference_t offset) const {
+    Derived_t tmp = derived();
+    return tmp -= offset;
   }
 
-  constexpr difference_t operator-(const base_cont_iter &other) {
+  constexpr difference_t operator-(const base_cont_iter &other) const {
     return (m_ProxyData - other.m_ProxyData);
   }
 
@@ -164,19 +360,29 @@ public:
     return this->m_ProxyData <=> other.m_ProxyData;
   }
 
-private:
+protected:
+  // Containers reach the pointer through the derived iterators' friendship.
   pointer_t m_ProxyData;
+
+private:
+  constexpr Derived_t &derived() { return static_cast<Derived_t &>(*this); }
+
+  constexpr Derived_t const &derived() const {
+    return static_cast<Derived_t const &>(*this);
+  }
 };
 
 template <typename Container_t>
 using BaseContigiousIterator_t =
-    base_cont_iter<typename Container_t::pointer,
+    base_cont_iter<ContiguousIterator<Container_t>,
+                   typename Container_t::pointer,
                    typename Container_t::reference,
                    typename Container_t::difference_type>;
 
 template <typename Container_t>
 using BaseConstContiguousIterator_t =
-    base_cont_iter<typename Container_t::const_pointer,
+    base_cont_iter<ConstContiguousIterator<Container_t>,
+                   typename Container_t::const_pointer,
                    typename Container_t::const_reference,
                    typename Container_t::difference_type>;
 
@@ -189,6 +395,10 @@ struct ContiguousIterator
 
   constexpr explicit ContiguousIterator(Container_t::pointer proxyData)
       : internal::BaseContigiousIterator_t<Container_t>{proxyData} {}
+
+private:
+  friend Container_t;
+  friend struct ConstContiguousIterator<Container_t>;
 };
 
 template <typename Container_t>
@@ -199,6 +409,326 @@ struct ConstContiguousIterator
   constexpr explicit ConstContiguousIterator(
       Container_t::const_pointer proxyData)
       : internal::BaseConstContiguousIterator_t<Container_t>{proxyData} {}
+
+  constexpr ConstContiguousIterator(
+      ContiguousIterator<Container_t> const &other)
+      : ConstContiguousIterator{other.m_ProxyData} {}
+
+private:
+  friend Container_t;
 };
 
+template <typename Container_t>
+struct RingIterator;
+
+template <typename Container_t>
+struct ConstRingIterator;
+
+namespace internal {
+
+// Walks a ring buffer with power-of-two capacity. The position keeps counting
+// past the end of the storage and is wrapped with the mask on each access,
+// so end() of a full buffer is distinct from begin().
+template <typename Derived_t, typename pointer_t, typename reference_t,
+          typename difference_t>
+class base_ring_iter {
+public:
+  using iterator_concept = std::random_access_iterator_tag;
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::remove_cvref_t<reference_t>;
+  using difference_type = difference_t;
+  using pointer = pointer_t;
+  using reference = reference_t;
+
+  constexpr explicit base_ring_iter()
+      : m_ProxyData{nullptr}, m_Mask{0}, m_Position{0} {}
+
+  constexpr explicit base_ring_iter(pointer_t proxyData, std::size_t mask,
+                                    std::size_t position)
+      : m_ProxyData{proxyData}, m_Mask{mask}, m_Position{position} {}
+
+  constexpr base_ring_iter(const base_ring_iter &) = default;
+
+  constexpr base_ring_iter &operator=(const base_ring_iter &) = default;
+
+  constexpr ~base_ring_iter() = default;
+
+  constexpr pointer_t operator->() const {
+    return m_ProxyData + (m_Position & m_Mask);
+  }
+
+  constexpr reference_t operator*() const {
+    return m_ProxyData[m_Position & m_Mask];
+  }
+
+  constexpr Derived_t &operator++() {
+    ++m_Position;
+    return derived();
+  }
+
+  constexpr Derived_t operator++(int) {
+    Derived_t tmp = derived();
+    ++(*this);
+    return tmp;
+  }
+
+  constexpr Derived_t &operator--() {
+    --m_Position;
+    return derived();
+  }
+
+  constexpr Derived_t operator--(int) {
+    Derived_t tmp = derived();
+    --(*this);
+    return tmp;
+  }
+
+  constexpr Derived_t &operator+=(difference_t offset) {
+    m_Position += offset;
+    return derived();
+  }
+
+  constexpr Derived_t &operator-=(difference_t offset) {
+    m_Position -= offset;
+    return derived();
+  }
+
+  constexpr Derived_t operator+(difference_t offset) const {
+    Derived_t tmp = derived();
+    return tmp += offset;
+  }
+
+  friend constexpr Derived_t operator+(difference_t offset,
+                                       Derived_t const &iter) {
+    return iter + offset;
+  }
+
+  constexpr Derived_t operator-(difference_t offset) const {
+    Derived_t tmp = derived();
+    return tmp -= offset;
+  }
+
+  constexpr reference_t operator[](difference_t index) const {
+    return m_ProxyData[(m_Position + index) & m_Mask];
+  }
+
+  constexpr difference_t operator-(const base_ring_iter &other) const {
+    return static_cast<difference_t>(m_Position - other.m_Position);
+  }
+
+  constexpr bool operator==(base_ring_iter const &other) const {
+    return m_Position == other.m_Position;
+  }
+
+  constexpr auto operator<=>(base_ring_iter const &other) const {
+    return m_Position <=> other.m_Position;
+  }
+
+protected:
+  pointer_t m_ProxyData;
+  std::size_t m_Mask;
+  std::size_t m_Position;
+
+private:
+  constexpr Derived_t &derived() { return static_cast<Derived_t &>(*this); }
+
+  constexpr Derived_t const &derived() const {
+    return static_cast<Derived_t const &>(*this);
+  }
+};
+
+template <typename Container_t>
+using BaseRingIterator_t =
+    base_ring_iter<RingIterator<Container_t>, typename Container_t::pointer,
+                   typename Container_t::reference,
+                   typename Container_t::difference_type>;
+
+template <typename Container_t>
+using BaseConstRingIterator_t =
+    base_ring_iter<ConstRingIterator<Container_t>,
+                   typename Container_t::const_pointer,
+                   typename Container_t::const_reference,
+                   typename Container_t::difference_type>;
+
+} // namespace internal
+
+template <typename Container_t>
+struct RingIterator : public internal::BaseRingIterator_t<Container_t> {
+  constexpr explicit RingIterator() = default;
+
+  constexpr explicit RingIterator(Container_t::pointer proxyData,
+                                  std::size_t mask, std::size_t position)
+      : internal::BaseRingIterator_t<Container_t>{proxyData, mask, position} {}
+
+private:
+  friend Container_t;
+  friend struct ConstRingIterator<Container_t>;
+};
+
+template <typename Container_t>
+struct ConstRingIterator
+    : public internal::BaseConstRingIterator_t<Container_t> {
+  constexpr explicit ConstRingIterator() = default;
+
+  constexpr explicit ConstRingIterator(Container_t::const_pointer proxyData,
+                                       std::size_t mask, std::size_t position)
+      : internal::BaseConstRingIterator_t<Container_t>{proxyData, mask,
+                                                       position} {}
+
+  constexpr ConstRingIterator(RingIterator<Container_t> const &other)
+      : ConstRingIterator{other.m_ProxyData, other.m_Mask, other.m_Position} {}
+
+private:
+  friend Container_t;
+};
+
+template <typename Container_t>
+struct UnrolledIterator;
+
+template <typename Container_t>
+struct ConstUnrolledIterator;
+
+namespace internal {
+
+// Walks an unrolled list: a node and an index into its elements. Stepping
+// past the last element of a node moves to index 0 of the next one, so the
+// end position is index 0 of the list's header. Nodes are never empty.
+template <typename Derived_t, typename linkptr_type, typename nodeptr_type,
+          typename pointer_t, typename reference_t>
+class base_unrolled_iter {
+public:
+  using iterator_concept = std::bidirectional_iterator_tag;
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = std::remove_cvref_t<reference_t>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = pointer_t;
+  using reference = reference_t;
+
+  constexpr explicit base_unrolled_iter() : m_Node(nullptr), m_Index(0) {}
+
+  constexpr explicit base_unrolled_iter(linkptr_type node, std::size_t index)
+      : m_Node(node), m_Index(index) {}
+
+  constexpr base_unrolled_iter(const base_unrolled_iter &) = default;
+
+  constexpr base_unrolled_iter &
+  operator=(const base_unrolled_iter &) = default;
+
+  constexpr ~base_unrolled_iter() = default;
+
+  constexpr pointer_t operator->() const {
+    return static_cast<nodeptr_type>(m_Node)->data() + m_Index;
+  }
+
+  constexpr reference_t operator*() const {
+    return static_cast<nodeptr_type>(m_Node)->data()[m_Index];
+  }
+
+  constexpr Derived_t &operator++() {
+    if (++m_Index == static_cast<nodeptr_type>(m_Node)->m_Count) {
+      m_Node = m_Node->next;
+      m_Index = 0;
+    }
+    return derived();
+  }
+
+  constexpr Derived_t operator++(int) {
+    Derived_t tmp = derived();
+    ++(*this);
+    return tmp;
+  }
+
+  constexpr Derived_t &operator--() {
+    if (m_Index == 0) {
+      m_Node = m_Node->prev;
+      m_Index = static_cast<nodeptr_type>(m_Node)->m_Count;
+    }
+    --m_Index;
+    return derived();
+  }
+
+  constexpr Derived_t operator--(int) {
+    Derived_t tmp = derived();
+    --(*this);
+    return tmp;
+  }
+
+  constexpr bool operator==(const base_unrolled_iter &other) const {
+    return m_Node == other.m_Node && m_Index == other.m_Index;
+  }
+
+protected:
+  linkptr_type m_Node;
+  std::size_t m_Index;
+
+private:
+  constexpr Derived_t &derived() { return static_cast<Derived_t &>(*this); }
+
+  constexpr Derived_t const &derived() const {
+    return static_cast<Derived_t const &>(*this);
+  }
+};
+
+template <typename Container_t>
+using BaseUnrolledIterator_t =
+    base_unrolled_iter<UnrolledIterator<Container_t>,
+                       typename Container_t::linkptr_type,
+                       typename Container_t::nodeptr_type,
+                       typename Container_t::pointer,
+                       typename Container_t::reference>;
+
+template <typename Container_t>
+using BaseConstUnrolledIterator_t =
+    base_unrolled_iter<ConstUnrolledIterator<Container_t>,
+                       typename Container_t::linkptr_type,
+                       typename Container_t::nodeptr_type,
+                       typename Container_t::const_pointer,
+                       typename Container_t::const_reference>;
+
+} // namespace internal
+
+template <typename Container_t>
+struct UnrolledIterator : public internal::BaseUnrolledIterator_t<Container_t> {
+  constexpr explicit UnrolledIterator() = default;
+
+  constexpr explicit UnrolledIterator(Container_t::linkptr_type node,
+                                      std::size_t index)
+      : internal::BaseUnrolledIterator_t<Container_t>{node, index} {}
+
+private:
+  friend Container_t;
+  friend struct ConstUnrolledIterator<Container_t>;
+};
+
+template <typename Container_t>
+struct ConstUnrolledIterator
+    : public internal::BaseConstUnrolledIterator_t<Container_t> {
+  constexpr explicit ConstUnrolledIterator() = default;
+
+  constexpr explicit ConstUnrolledIterator(Container_t::linkptr_type node,
+                                           std::size_t index)
+      : internal::BaseConstUnrolledIterator_t<Container_t>{node, index} {}
+
+  constexpr ConstUnrolledIterator(UnrolledIterator<Container_t> const &other)
+      : ConstUnrolledIterator{other.m_Node, other.m_Index} {}
+
+private:
+  friend Container_t;
+};
+
+namespace internal {
+
+// The raw pointer behind a contiguous iterator, ours or the standard
+// library's; other iterators pass through unchanged.
+template <typename Iter_t>
+constexpr auto unwrap_contiguous(Iter_t iter) {
+  if constexpr (std::contiguous_iterator<Iter_t>) {
+    return std::to_address(iter);
+  } else {
+    return iter;
+  }
+}
+
+} // namespace internal
+
 } // namespace mystl
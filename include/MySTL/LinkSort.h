@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+namespace mystl {
+
+namespace internal {
+
+// Sorting for node-based containers on chains of links that end in
+// nullptr and are joined through `next` only; `prev` links, if any, are
+// left for the container to rebuild. Node_t::value(link) gives a link's
+// element. Nothing is allocated or copied, and `comp` must not throw.
+
+// Merges two sorted chains; on ties the node from `a` goes first.
+template <typename Node_t, typename Link_t, typename Compare>
+Link_t *merge_link_chains(Link_t *a, Link_t *b, Compare &comp) {
+  Link_t *head = nullptr;
+  Link_t **tail = &head;
+
+  while (a != nullptr && b != nullptr) {
+    if (comp(Node_t::value(b), Node_t::value(a))) {
+      *tail = b;
+      b = b->next;
+    } else {
+      *tail = a;
+      a = a->next;
+    }
+    tail = &(*tail)->next;
+  }
+
+  *tail = (a != nullptr) ? a : b;
+  return head;
+}
+
+// Stable bottom-up merge sort in O(n log n) with O(1) extra space.
+template <typename Node_t, typename Link_t, typename Compare>
+Link_t *sort_link_chain(Link_t *first, Compare &comp) {
+  // bins[i] is empty or a sorted run of 2^i nodes, all of which come
+  // before the nodes of bins[i - 1]. Each node is merged into the bins
+  // like a binary counter being incremented.
+  Link_t *bins[std::numeric_limits<std::size_t>::digits] = {};
+
+  while (first != nullptr) {
+    Link_t *run = first;
+    first = first->next;
+    run->next = nullptr;
+
+    std::size_t i = 0;
+    for (; bins[i] != nullptr; ++i) {
+      run = merge_link_chains<Node_t>(bins[i], run, comp);
+      bins[i] = nullptr;
+    }
+    bins[i] = run;
+  }
+
+  Link_t *sorted = nullptr;
+  for (Link_t *bin : bins) {
+    if (bin != nullptr) {
+      sorted = merge_link_chains<Node_t>(bin, sorted, comp);
+    }
+  }
+  return sorted;
+}
+
+} // namespace internal
+
+} // namespace mystl
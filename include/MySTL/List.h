@@ -1,87 +1,94 @@
 #pragma once
 
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
 #include <initializer_list>
+#include <memory>
+#include <type_traits>
 #include <utility>
+#include "Allocator.h"
 #include "Iterator.h"
+#include "LinkSort.h"
+#include "MemoryResource.h"
 
-template <typename T>
-struct List_Node
-{
-    // List_Node's data has to be in this order so it could be
-    // reinterpret-casted correctly to List_Node_No_Value.
-
-    List_Node* prev;
-    List_Node* next;
-    T data;
+namespace mystl {
 
-    List_Node()
-        : data(T()), prev(nullptr), next(nullptr) {}
-
-    List_Node(List_Node* _prev, List_Node* _next)
-        : prev(_prev), next(_next) {}
-
-    List_Node(const T& _data, List_Node* _prev, List_Node* _next)
-        :  data(_data), prev(_prev), next(_next) {}
-
-    List_Node(T&& _data, List_Node* _prev, List_Node* _next)
-        : data(std::move(_data)), prev(_prev), next(_next) {}
+// The links every list node starts with. A List owns one of these as its
+// header: header.next is the first node, header.prev the last, and an empty
+// list's header points at itself.
+struct List_Node_Base
+{
+    List_Node_Base* prev;
+    List_Node_Base* next;
 };
 
 template <typename T>
-struct List_Node_No_Value
+struct List_Node : List_Node_Base
 {
-    List_Node<T>* prev;
-    List_Node<T>* next;
+    T data;
 
-    List_Node_No_Value()
-        : prev(nullptr), next(nullptr) {}
+    template <typename... Args>
+    List_Node(List_Node_Base* _prev, List_Node_Base* _next, Args&&... args)
+        : List_Node_Base{_prev, _next}, data(std::forward<Args>(args)...) {}
 
-    List_Node_No_Value(List_Node<T>* _prev, List_Node<T>* _next)
-        : prev(_prev), next(_next) {}
+    static T& value(List_Node_Base* link) { return static_cast<List_Node*>(link)->data; }
 };
 
-template <typename T>
+// Doubly linked list. By default every list gets its own node pool
+// (PoolAllocator), so nodes come from contiguous chunks and are recycled
+// through a free list rather than one malloc/free each.
+//
+// The nodes form a ring through a header inside the list, so end() is the
+// header itself and linking or unlinking a node never has to special-case
+// the first or last position.
+template <typename T, typename Allocator = mystl::PoolAllocator<T>>
 class List
 {
 public:
 
-    using value_t           = T;
-    using pointer_t         = T*;
-    using const_pointer_t   = const T*;
-    using reference_t       = T&;
+    using value_type        = T;
+    using pointer           = T*;
+    using const_pointer     = const T*;
+    using reference         = T&;
+    using const_reference   = const T&;
+    using size_type         = std::size_t;
+    using difference_type   = std::ptrdiff_t;
+    using allocator_type    = Allocator;
+
     using node_t            = List_Node<T>;
     using nodeptr_t         = List_Node<T>*;
+    using nodeptr_type      = nodeptr_t;
+    using linkptr_t         = List_Node_Base*;
+    using linkptr_type      = linkptr_t;
 
 public:
 
-    using iterator          = BidirectionalIterator<List<T>>;
-    using const_iterator    = ConstBidirectionalIterator<List<T>>;
+    using iterator          = BidirectionalIterator<List>;
+    using const_iterator    = ConstBidirectionalIterator<List>;
 
-    iterator begin() { return iterator(m_Head); }
-    const_iterator begin() const { return const_iterator(m_Head); }
-
-    iterator end()
-    {
-        m_End = List_Node_No_Value<T>(m_Tail, nullptr);
-        return (nodeptr_t)&m_End;
-    }
+    iterator begin() { return iterator(m_Header.next); }
+    const_iterator begin() const { return const_iterator(m_Header.next); }
+    const_iterator cbegin() const { return begin(); }
 
-    const_iterator end() const
-    {
-        m_End = List_Node_No_Value<T>(m_Tail, nullptr);
-        return (nodeptr_t)&m_End;
-    }
+    iterator end() { return iterator(end_node()); }
+    const_iterator end() const { return const_iterator(end_node()); }
+    const_iterator cend() const { return end(); }
 
 public:
 
 	// Constructors - destructor
 
     List()
-        :m_Head(nullptr), m_Tail(nullptr), m_Size(0) {}
+        :m_Alloc(), m_Header{&m_Header, &m_Header}, m_Size(0) {}
 
-    List(std::size_t count, const T& val = T());
+    explicit List(const Allocator& alloc)
+        :m_Alloc(alloc), m_Header{&m_Header, &m_Header}, m_Size(0) {}
 
-    List(std::initializer_list<T> iList);
+    List(std::size_t count, const T& val = T(), const Allocator& alloc = Allocator());
+
+    List(std::initializer_list<T> iList, const Allocator& alloc = Allocator());
 
     List(const List& copy);
 
@@ -95,6 +102,8 @@ public:
 
     List& operator=(List&& move);
 
+    allocator_type get_allocator() const { return allocator_type(m_Alloc); }
+
     // Capacity
 
     std::size_t size() const { return m_Size; }
@@ -113,14 +122,14 @@ public:
 
     void clear();
 
-    void erase(const_iterator pos);
-    void erase(const_iterator begin, const_iterator end);
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator begin, const_iterator end);
 
-    void insert(const_iterator pos, const T& val);
-    void insert(const_iterator pos, T&& val);
+    iterator insert(const_iterator pos, const T& val);
+    iterator insert(const_iterator pos, T&& val);
 
     template <typename... Args>
-    void emplace(const_iterator pos, Args&&... args);
+    iterator emplace(const_iterator pos, Args&&... args);
 
     void push_back(const T& val);
     void push_back(T&& val);
@@ -140,371 +149,660 @@ public:
 
     // Operations
 
-    // void merge(List& other)
-    // void merge(List&& other)
+    // Nodes are relinked, never copied, as long as both lists share an
+    // allocator (equal allocators). Otherwise the elements are moved into
+    // new nodes of this list.
 
-    // std::size_t remove(const T& compareData);
+    void splice(const_iterator pos, List& other);
+    void splice(const_iterator pos, List&& other) { splice(pos, other); }
+
+    void splice(const_iterator pos, List& other, const_iterator it);
+    void splice(const_iterator pos, List&& other, const_iterator it) { splice(pos, other, it); }
+
+    // O(1) within one list; O(distance(first, last)) between lists to keep
+    // the sizes up to date.
+    void splice(const_iterator pos, List& other, const_iterator first, const_iterator last);
+    void splice(const_iterator pos, List&& other, const_iterator first, const_iterator last)
+    {
+        splice(pos, other, first, last);
+    }
 
-    // template<typename Predicate>
-    // std::size_t remove_if(Predicate pre);
+    // Both lists must be sorted; `other` is left empty. Stable.
+    void merge(List& other) { merge(other, std::less<>()); }
+    void merge(List&& other) { merge(other, std::less<>()); }
 
-    // std::size_t unique();
-    // template<typename Predicate>
-    // std::size_t unique(Predicate pre);
+    template <typename Compare>
+    void merge(List& other, Compare comp);
 
-    // void reverse();
+    template <typename Compare>
+    void merge(List&& other, Compare comp) { merge(other, comp); }
 
-    // void sort();
+    std::size_t remove(const T& val);
+
+    template <typename Predicate>
+    std::size_t remove_if(Predicate pred);
+
+    std::size_t unique() { return unique(std::equal_to<>()); }
+
+    template <typename BinaryPredicate>
+    std::size_t unique(BinaryPredicate pred);
+
+    void reverse();
+
+    // Stable bottom-up merge sort: O(n log n), no allocation and no element
+    // copies. `comp` must not throw.
+    void sort() { sort(std::less<>()); }
+
+    template <typename Compare>
+    void sort(Compare comp);
 
 private:
 
-    void link_node(bool atTail, nodeptr_t val);
+    using node_allocator_t  = typename std::allocator_traits<Allocator>::template rebind_alloc<node_t>;
+    using node_traits       = std::allocator_traits<node_allocator_t>;
+
+    static constexpr bool m_CanReleasePool = requires(node_allocator_t& alloc) {
+        { alloc.release_if_unshared() } -> std::same_as<bool>;
+    };
+
+    // Const traversal hands out the header through const_iterator, which
+    // never writes through it.
+    linkptr_t end_node() const { return const_cast<linkptr_t>(&m_Header); }
+
+    static T& value(linkptr_t link) { return node_t::value(link); }
+
+    template <typename... Args>
+    nodeptr_t create_node(Args&&... args);
+
+    void destroy_node(linkptr_t node);
+
+    void link_before(linkptr_t pos, linkptr_t val);
+
+    void unlink_node(linkptr_t val);
+
+    void reset_header();
+
+    void steal(List& other);
+
+    bool shares_nodes_with(const List& other) const;
+
+    linkptr_t detach_range(linkptr_t first, linkptr_t last, std::size_t count);
+
+    void attach_range(linkptr_t pos, linkptr_t first, linkptr_t last, std::size_t count);
+
+    void adopt_chain(linkptr_t first, std::size_t count);
+
+    void destroy_chain(linkptr_t first);
 
 private:
 
-    nodeptr_t m_Head;
-    nodeptr_t m_Tail;
-    std::size_t m_Size;
+    [[no_unique_address]] node_allocator_t m_Alloc;
 
-    mutable List_Node_No_Value<T> m_End;
+    List_Node_Base m_Header;
+    std::size_t m_Size;
 };
 
-template <typename T>
-void List<T>::link_node(bool atTail, nodeptr_t val)
+template <typename T, typename Allocator>
+template <typename... Args>
+typename List<T, Allocator>::nodeptr_t List<T, Allocator>::create_node(Args&&... args)
+{
+    nodeptr_t node = node_traits::allocate(m_Alloc, 1);
+    std::construct_at(node, nullptr, nullptr, std::forward<Args>(args)...);
+    return node;
+}
+
+template <typename T, typename Allocator>
+void List<T, Allocator>::destroy_node(linkptr_t link)
 {
-    if (m_Head == nullptr)
-        m_Head = m_Tail = val;
+    nodeptr_t node = static_cast<nodeptr_t>(link);
+    std::destroy_at(node);
+    node_traits::deallocate(m_Alloc, node, 1);
+}
+
+template <typename T, typename Allocator>
+void List<T, Allocator>::link_before(linkptr_t pos, linkptr_t val)
+{
+    val->prev = pos->prev;
+    val->next = pos;
+    pos->prev->next = val;
+    pos->prev = val;
+    m_Size++;
+}
+
+template <typename T, typename Allocator>
+void List<T, Allocator>::unlink_node(linkptr_t val)
+{
+    val->prev->next = val->next;
+    val->next->prev = val->prev;
+    m_Size--;
+}
+
+template <typename T, typename Allocator>
+void List<T, Allocator>::reset_header()
+{
+    m_Header.prev = &m_Header;
+    m_Header.next = &m_Header;
+    m_Size = 0;
+}
+
+template <typename T, typename Allocator>
+void List<T, Allocator>::steal(List& other)
+{
+    if (other.empty())
+    {
+        reset_header();
+        return;
+    }
+
+    // The first and last nodes point at the header, which lives inside the
+    // list.
+    m_Header = other.m_Header;
+    m_Header.next->prev = &m_Header;
+    m_Header.prev->next = &m_Header;
+    m_Size = other.m_Size;
+
+    other.reset_header();
+}
+
+template <typename T, typename Allocator>
+bool List<T, Allocator>::shares_nodes_with(const List& other) const
+{
+    if constexpr (node_traits::is_always_equal::value)
+        return true;
     else
+        return m_Alloc == other.m_Alloc;
+}
+
+// Unlinks the `count` nodes [first, last) and returns the last of them.
+template <typename T, typename Allocator>
+typename List<T, Allocator>::linkptr_t
+List<T, Allocator>::detach_range(linkptr_t first, linkptr_t last, std::size_t count)
+{
+    linkptr_t lastNode = last->prev;
+
+    first->prev->next = last;
+    last->prev = first->prev;
+
+    m_Size -= count;
+    return lastNode;
+}
+
+// Links the chain first..last (inclusive) of `count` nodes before `pos`.
+template <typename T, typename Allocator>
+void List<T, Allocator>::attach_range(linkptr_t pos, linkptr_t first, linkptr_t last, std::size_t count)
+{
+    first->prev = pos->prev;
+    last->next = pos;
+    pos->prev->next = first;
+    pos->prev = last;
+
+    m_Size += count;
+}
+
+// Takes a nullptr-terminated chain linked through `next` as the whole list
+// and rebuilds the `prev` links.
+template <typename T, typename Allocator>
+void List<T, Allocator>::adopt_chain(linkptr_t first, std::size_t count)
+{
+    linkptr_t prev = &m_Header;
+
+    for (linkptr_t node = first; node != nullptr; node = node->next)
     {
-        if (atTail)
-        {
-            m_Tail->next = val;
-            m_Tail = val;
-        }
-        else
-        {
-            m_Head->prev = val;
-            m_Head = val;
-        }
+        node->prev = prev;
+        prev->next = node;
+        prev = node;
     }
-    m_Size++;
+
+    prev->next = &m_Header;
+    m_Header.prev = prev;
+    m_Size = count;
 }
 
-template <typename T>
-List<T>::List(std::size_t count, const T& val)
-    :List()
+template <typename T, typename Allocator>
+void List<T, Allocator>::destroy_chain(linkptr_t first)
+{
+    while (first != nullptr)
+    {
+        linkptr_t next = first->next;
+        destroy_node(first);
+        first = next;
+    }
+}
+
+template <typename T, typename Allocator>
+List<T, Allocator>::List(std::size_t count, const T& val, const Allocator& alloc)
+    :List(alloc)
 {
     for (std::size_t i = 0; i < count; ++i)
         push_back(val);
 }
 
-template <typename T>
-List<T>::List(std::initializer_list<T> iList)
-    :List()
+template <typename T, typename Allocator>
+List<T, Allocator>::List(std::initializer_list<T> iList, const Allocator& alloc)
+    :List(alloc)
 {
     const T* begin = iList.begin();
 
     for (std::size_t i = 0; i < iList.size(); ++i)
-        push_back(std::move(begin[i]));
+        push_back(begin[i]);
 }
 
-template <typename T>
-List<T>::List(const List<T>& copy)
-    :List()
+template <typename T, typename Allocator>
+List<T, Allocator>::List(const List& copy)
+    :List(Allocator(node_traits::select_on_container_copy_construction(copy.m_Alloc)))
 {
-    nodeptr_t copyP = copy.m_Head;
-
-    while (copyP != nullptr)
-    {
-        reference_t data = copyP->data;
-        push_back(data);
-        copyP = copyP->next;
-    }
+    for (const T& val : copy)
+        push_back(val);
 }
 
-template <typename T>
-List<T>::List(List<T>&& move)
-    :m_Size(move.m_Size), m_Head(move.m_Head), m_Tail(move.m_Tail)
+template <typename T, typename Allocator>
+List<T, Allocator>::List(List&& move)
+    :m_Alloc(std::move(move.m_Alloc))
 {
-    move.m_Size = 0;
-    move.m_Head = nullptr;
-    move.m_Tail = nullptr;
+    steal(move);
 }
 
-template <typename T>
-List<T>::~List<T>()
+template <typename T, typename Allocator>
+List<T, Allocator>::~List()
 {
     clear();
 }
 
-template <typename T>
-List<T>& List<T>::operator=(const List<T>& copy)
+template <typename T, typename Allocator>
+List<T, Allocator>& List<T, Allocator>::operator=(const List& copy)
 {
     if (this != &copy)
     {
         clear();
 
-        nodeptr_t copyP = copy.m_Head;
+        if constexpr (node_traits::propagate_on_container_copy_assignment::value)
+            m_Alloc = copy.m_Alloc;
 
-        while (copyP != nullptr)
-        {
-            reference_t data = copyP->data;
-            push_back(data);
-            copyP = copyP->next;
-        }
+        for (const T& val : copy)
+            push_back(val);
     }
 
     return *this;
 }
 
-template <typename T>
-List<T>& List<T>::operator=(List<T>&& move)
+template <typename T, typename Allocator>
+List<T, Allocator>& List<T, Allocator>::operator=(List&& move)
 {
     if (this != &move)
     {
         clear();
 
-        m_Size = move.m_Size;
-        m_Head = move.m_Head;
-        m_Tail = move.m_Tail;
-
-        move.m_Size = 0;
-        move.m_Head = nullptr;
-        move.m_Tail = nullptr;
+        if constexpr (node_traits::propagate_on_container_move_assignment::value)
+            m_Alloc = std::move(move.m_Alloc);
+        else if (!(m_Alloc == move.m_Alloc))
+        {
+            // Nodes belong to another allocator, so move the values over.
+            while (!move.empty())
+            {
+                push_back(std::move(move.front()));
+                move.pop_front();
+            }
+            return *this;
+        }
 
+        steal(move);
     }
 
     return *this;
 }
 
-template <typename T>
-T& List<T>::back()
+template <typename T, typename Allocator>
+T& List<T, Allocator>::back()
 {
     assert(!empty());
 
-    return m_Tail->data;
+    return value(m_Header.prev);
 }
 
-template <typename T>
-const T& List<T>::back() const
+template <typename T, typename Allocator>
+const T& List<T, Allocator>::back() const
 {
     assert(!empty());
 
-    return m_Tail->data;
+    return value(m_Header.prev);
 }
 
-template <typename T>
-T& List<T>::front()
+template <typename T, typename Allocator>
+T& List<T, Allocator>::front()
 {
     assert(!empty());
 
-    return m_Head->data;
+    return value(m_Header.next);
 }
 
-template <typename T>
-const T& List<T>::front() const
+template <typename T, typename Allocator>
+const T& List<T, Allocator>::front() const
 {
     assert(!empty());
 
-    return m_Head->data;
+    return value(m_Header.next);
 }
 
-template <typename T>
-void List<T>::clear()
+template <typename T, typename Allocator>
+void List<T, Allocator>::clear()
 {
-    nodeptr_t iter = m_Head;
-    nodeptr_t next = nullptr;
+    // Nothing to destroy and nobody else in the pool: drop whole chunks.
+    if constexpr (std::is_trivially_destructible_v<T> && m_CanReleasePool)
+    {
+        if (m_Size == 0 || m_Alloc.release_if_unshared())
+        {
+            reset_header();
+            return;
+        }
+    }
+
+    linkptr_t iter = m_Header.next;
 
-    while (iter != nodeptr_t(&m_End))
+    while (iter != &m_Header)
     {
-        next = iter->next;
-        delete iter;
+        linkptr_t next = iter->next;
+        destroy_node(iter);
         iter = next;
     }
 
-    m_Size = 0;
-    m_Head = nullptr;
-    m_Tail = nullptr;
+    reset_header();
 }
 
-template <typename T>
-void List<T>::erase(const_iterator pos)
+template <typename T, typename Allocator>
+typename List<T, Allocator>::iterator List<T, Allocator>::erase(const_iterator pos)
 {
-    if (empty())
-        return;
+    linkptr_t curr = pos.m_ProxyData;
+    if (curr == end_node())
+        return end();
 
-    nodeptr_t curr = pos.m_ProxyData;
-    nodeptr_t prev = curr->prev;
-    nodeptr_t next = curr->next;
+    linkptr_t next = curr->next;
 
-    delete curr;
-    prev->next = next;
-    next->prev = prev;
-    m_Size--;
+    unlink_node(curr);
+    destroy_node(curr);
+
+    return iterator(next);
 }
 
-template <typename T>
-void List<T>::erase(const_iterator begin, const_iterator end)
+template <typename T, typename Allocator>
+typename List<T, Allocator>::iterator List<T, Allocator>::erase(const_iterator begin, const_iterator end)
 {
-    if (empty() || !begin.m_ProxyData)
-        return;
-
-    nodeptr_t iter = begin.m_ProxyData;
-    nodeptr_t first = iter->prev;
-    nodeptr_t last = (end.m_ProxyData) ? (end.m_ProxyData)->next : nodeptr_t(&m_End);
-    nodeptr_t next = nullptr;
+    linkptr_t iter = begin.m_ProxyData;
+    linkptr_t last = end.m_ProxyData;
 
     while (iter != last)
     {
-        next = iter->next;
-        delete iter;
+        linkptr_t next = iter->next;
+        unlink_node(iter);
+        destroy_node(iter);
         iter = next;
-        m_Size--;
     }
 
-    if (first)
-        first->next = last;
-    else
-        m_Head->next = last;
+    return iterator(last);
+}
 
-    if (last)
-        last->prev = first;
-    else
-        m_Tail = first;
+template <typename T, typename Allocator>
+typename List<T, Allocator>::iterator List<T, Allocator>::insert(const_iterator pos, const T& val)
+{
+    return emplace(pos, val);
+}
 
+template <typename T, typename Allocator>
+typename List<T, Allocator>::iterator List<T, Allocator>::insert(const_iterator pos, T&& val)
+{
+    return emplace(pos, std::move(val));
 }
 
-template <typename T>
-void List<T>::insert(const_iterator pos, const T& val)
+template <typename T, typename Allocator>
+template <typename... Args>
+typename List<T, Allocator>::iterator List<T, Allocator>::emplace(const_iterator pos, Args&&... args)
 {
-    nodeptr_t curr = pos.m_ProxyData;
-    if (curr == nullptr)
-    {
-        push_back(val);
-        return;
-    }
+    nodeptr_t newNode = create_node(std::forward<Args>(args)...);
 
-    nodeptr_t newNode = new node_t(val, curr, curr->next);
+    link_before(pos.m_ProxyData, newNode);
 
-    curr->next = newNode;
-    m_Size++;
+    return iterator(newNode);
 }
 
-template <typename T>
-void List<T>::insert(const_iterator pos, T&& val)
+template <typename T, typename Allocator>
+void List<T, Allocator>::push_back(const T& val)
 {
-    nodeptr_t curr = pos.m_ProxyData;
-    if (curr == nullptr)
-    {
-        push_back(val);
-        return;
-    }
+    link_before(&m_Header, create_node(val));
+}
 
-    nodeptr_t newNode = (nodeptr_t)::operator new(sizeof(node_t));
+template <typename T, typename Allocator>
+void List<T, Allocator>::push_back(T&& val)
+{
+    link_before(&m_Header, create_node(std::move(val)));
+}
 
-    new(newNode) node_t(T(std::forward<T>(val)), curr, curr->next);
-    curr->next = newNode;
-    m_Size++;
+template <typename T, typename Allocator>
+void List<T, Allocator>::push_front(const T& val)
+{
+    link_before(m_Header.next, create_node(val));
 }
 
-template <typename T>
+template <typename T, typename Allocator>
+void List<T, Allocator>::push_front(T&& val)
+{
+    link_before(m_Header.next, create_node(std::move(val)));
+}
+
+template <typename T, typename Allocator>
 template <typename... Args>
-void List<T>::emplace(const_iterator pos, Args&&... args)
+void List<T, Allocator>::emplace_back(Args&&... args)
 {
-    nodeptr_t curr = pos.m_ProxyData;
-    if (curr == nullptr)
-    {
-        push_back(args...);
+    link_before(&m_Header, create_node(std::forward<Args>(args)...));
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+void List<T, Allocator>::emplace_front(Args&&... args)
+{
+    link_before(m_Header.next, create_node(std::forward<Args>(args)...));
+}
+
+template <typename T, typename Allocator>
+void List<T, Allocator>::pop_back()
+{
+    if (empty())
         return;
-    }
 
-    nodeptr_t newNode = (nodeptr_t)::operator new(sizeof(node_t));
+    linkptr_t prevTail = m_Header.prev;
+    unlink_node(prevTail);
+    destroy_node(prevTail);
+}
 
-    new(newNode) node_t(T(std::forward<Args>(args)...), curr, curr->next);
-    curr->next = newNode;
-    m_Size++;
+template <typename T, typename Allocator>
+void List<T, Allocator>::pop_front()
+{
+    if (empty())
+        return;
+
+    linkptr_t prevHead = m_Header.next;
+    unlink_node(prevHead);
+    destroy_node(prevHead);
 }
 
-template <typename T>
-void List<T>::push_back(const T& val)
+template <typename T, typename Allocator>
+void List<T, Allocator>::splice(const_iterator pos, List& other)
 {
-    nodeptr_t newNode = new node_t(val, m_Tail, nodeptr_t(&m_End));
+    assert(this != &other);
 
-    link_node(true, newNode);
+    if (other.empty())
+        return;
+
+    splice(pos, other, other.begin(), other.end());
 }
 
-template <typename T>
-void List<T>::push_back(T&& val)
+template <typename T, typename Allocator>
+void List<T, Allocator>::splice(const_iterator pos, List& other, const_iterator it)
 {
-    nodeptr_t newNode = (nodeptr_t)::operator new(sizeof(node_t));
+    linkptr_t node = it.m_ProxyData;
 
-    new(newNode) node_t(T{ std::forward<T>(val) }, m_Tail, nodeptr_t(&m_End));
+    if (this == &other && (pos.m_ProxyData == node || pos.m_ProxyData == node->next))
+        return;
 
-    link_node(true, newNode);
+    splice(pos, other, it, const_iterator(node->next));
 }
 
-template <typename T>
-void List<T>::push_front(const T& val)
+template <typename T, typename Allocator>
+void List<T, Allocator>::splice(const_iterator pos, List& other, const_iterator first, const_iterator last)
 {
-    nodeptr_t newNode = new node_t(val, nullptr, m_Head);
+    linkptr_t firstNode = first.m_ProxyData;
+    linkptr_t lastNode = last.m_ProxyData;
+
+    if (firstNode == lastNode)
+        return;
+
+    if (this != &other && !shares_nodes_with(other))
+    {
+        for (linkptr_t node = firstNode; node != lastNode; node = node->next)
+            emplace(pos, std::move(value(node)));
+
+        other.erase(first, last);
+        return;
+    }
+
+    std::size_t count = 0;
+
+    if (this != &other)
+    {
+        if (firstNode == other.m_Header.next && lastNode == other.end_node())
+            count = other.m_Size;
+        else
+            for (linkptr_t node = firstNode; node != lastNode; node = node->next)
+                ++count;
+    }
 
-    link_node(false, newNode);
+    linkptr_t back = other.detach_range(firstNode, lastNode, count);
+    attach_range(pos.m_ProxyData, firstNode, back, count);
 }
 
-template <typename T>
-void List<T>::push_front(T&& val)
+template <typename T, typename Allocator>
+template <typename Compare>
+void List<T, Allocator>::merge(List& other, Compare comp)
 {
-    nodeptr_t newNode = (nodeptr_t)::operator new(sizeof(node_t));
+    if (this == &other || other.empty())
+        return;
+
+    if (!shares_nodes_with(other))
+    {
+        List moved(get_allocator());
+        moved.splice(moved.end(), other);
+        merge(moved, comp);
+        return;
+    }
 
-    new(newNode) node_t(T(std::forward<T>(val)), nullptr, m_Head);
+    // Break both rings into nullptr-terminated chains.
+    linkptr_t first = empty() ? nullptr : m_Header.next;
+    m_Header.prev->next = nullptr;
+    other.m_Header.prev->next = nullptr;
 
-    link_node(false, newNode);
+    std::size_t count = m_Size + other.m_Size;
+    first = internal::merge_link_chains<node_t>(first, other.m_Header.next, comp);
+
+    other.reset_header();
+    adopt_chain(first, count);
 }
 
-template <typename T>
-template <typename... Args>
-void List<T>::emplace_back(Args&&... args)
+template <typename T, typename Allocator>
+std::size_t List<T, Allocator>::remove(const T& val)
 {
-    nodeptr_t newNode = (nodeptr_t)::operator new(sizeof(node_t));
+    return remove_if([&val](const T& elem) { return elem == val; });
+}
 
-    new(newNode) node_t(T(std::forward<Args>(args)...), m_Tail, nodeptr_t(&m_End));
+template <typename T, typename Allocator>
+template <typename Predicate>
+std::size_t List<T, Allocator>::remove_if(Predicate pred)
+{
+    // Removed nodes are destroyed only at the end, since the predicate may
+    // refer to one of them (remove(front())).
+    linkptr_t removed = nullptr;
+    std::size_t count = 0;
+
+    for (linkptr_t node = m_Header.next; node != &m_Header;)
+    {
+        linkptr_t next = node->next;
 
-    link_node(true, newNode);
+        if (pred(value(node)))
+        {
+            unlink_node(node);
+            node->next = removed;
+            removed = node;
+            ++count;
+        }
+
+        node = next;
+    }
+
+    destroy_chain(removed);
+    return count;
 }
 
-template <typename T>
-template <typename... Args>
-void List<T>::emplace_front(Args&&... args)
+template <typename T, typename Allocator>
+template <typename BinaryPredicate>
+std::size_t List<T, Allocator>::unique(BinaryPredicate pred)
 {
-    nodeptr_t newNode = (nodeptr_t)::operator new(sizeof(node_t));
+    if (m_Size < 2)
+        return 0;
+
+    linkptr_t removed = nullptr;
+    std::size_t count = 0;
+    linkptr_t kept = m_Header.next;
 
-    new(newNode) node_t(T(std::forward<Args>(args)...), nullptr, m_Head);
+    for (linkptr_t node = kept->next; node != &m_Header;)
+    {
+        linkptr_t next = node->next;
+
+        if (pred(value(kept), value(node)))
+        {
+            unlink_node(node);
+            node->next = removed;
+            removed = node;
+            ++count;
+        }
+        else
+            kept = node;
+
+        node = next;
+    }
 
-    link_node(false, newNode);
+    destroy_chain(removed);
+    return count;
 }
 
-template <typename T>
-void List<T>::pop_back()
+template <typename T, typename Allocator>
+void List<T, Allocator>::reverse()
 {
-    if (empty())
-        return;
+    // Swapping the links of every node on the ring, header included,
+    // reverses it.
+    linkptr_t node = &m_Header;
 
-    nodeptr_t prevTail = m_Tail->prev;
-    prevTail->next = nullptr;
-    delete m_Tail;
-    m_Tail = prevTail;
-    m_Size--;
+    do
+    {
+        std::swap(node->prev, node->next);
+        node = node->prev;
+    } while (node != &m_Header);
 }
 
-template <typename T>
-void List<T>::pop_front()
+template <typename T, typename Allocator>
+template <typename Compare>
+void List<T, Allocator>::sort(Compare comp)
 {
-    if (empty())
+    if (m_Size < 2)
         return;
 
-    nodeptr_t nextHead = m_Head->next;
-    nextHead->prev = nullptr;
-    delete m_Head;
-    m_Head = nextHead;
-    m_Size--;
+    m_Header.prev->next = nullptr;
+    linkptr_t sorted = internal::sort_link_chain<node_t>(m_Header.next, comp);
+
+    adopt_chain(sorted, m_Size);
 }
+
+namespace pmr {
+
+template <typename T>
+using List = mystl::List<T, PolymorphicAllocator<T>>;
+
+} // namespace pmr
+
+} // namespace mystl
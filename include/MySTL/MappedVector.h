@@ -0,0 +1,304 @@
+#pragma once
+
+#include "GrowthPolicy.h"
+#include "Iterator.h"
+#include <cerrno>
+#include <cstddef>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mystl {
+
+enum class MapMode {
+  // Maps an existing file; the elements are const.
+  ReadOnly,
+  // Opens or creates the file; the vector can be written and grown, and
+  // changes land in the file.
+  ReadWrite,
+};
+
+// A vector whose elements live in a memory-mapped file, so opening a dataset
+// of any size is O(1): pages are read in by the kernel on first touch. The
+// file is a raw array of T with no header. In ReadWrite mode the file grows
+// with ftruncate + mremap and is cut back to size() on close(). The mode is
+// part of the type: a ReadOnly vector hands out only const elements and has
+// no modifiers, so writing to read-only pages does not compile.
+template <typename T, MapMode Mode = MapMode::ReadOnly,
+          typename GrowthPolicy = GeometricGrowth<>>
+class MappedVector {
+public:
+  static_assert(std::is_trivially_copyable_v<T>,
+                "MappedVector elements are stored as raw bytes");
+
+  static constexpr bool m_Writable = Mode == MapMode::ReadWrite;
+
+  using value_type = T;
+  using pointer = std::conditional_t<m_Writable, T *, T const *>;
+  using const_pointer = const T *;
+  using reference = std::conditional_t<m_Writable, T &, T const &>;
+  using const_reference = T const &;
+
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+
+  using iterator = ContiguousIterator<MappedVector>;
+  using const_iterator = ConstContiguousIterator<MappedVector>;
+
+public:
+  constexpr explicit MappedVector()
+      : m_File(-1), m_Capacity(0), m_Size(0), m_Data(nullptr) {}
+
+  explicit MappedVector(char const *path) : MappedVector{} { open(path); }
+
+  MappedVector(MappedVector const &) = delete;
+  MappedVector &operator=(MappedVector const &) = delete;
+
+  MappedVector(MappedVector &&move) : MappedVector{} { swap(move); }
+
+  MappedVector &operator=(MappedVector &&move) {
+    if (this != &move) {
+      close();
+      swap(move);
+    }
+    return *this;
+  }
+
+  ~MappedVector() { close(); }
+
+  void open(char const *path) {
+    close();
+
+    int flags = m_Writable ? O_RDWR | O_CREAT : O_RDONLY;
+    m_File = ::open(path, flags | O_CLOEXEC, 0644);
+    if (m_File < 0) {
+      throw_errno("open");
+    }
+
+    struct stat info;
+    if (::fstat(m_File, &info) != 0) {
+      int error = errno;
+      close();
+      throw std::system_error(error, std::generic_category(), "fstat");
+    }
+
+    auto bytes = static_cast<size_type>(info.st_size);
+    if (bytes % sizeof(T) != 0) {
+      close();
+      throw std::runtime_error("MappedVector file size is not a multiple of "
+                               "the element size");
+    }
+
+    // Nothing is committed until the mapping exists, so a failed open
+    // leaves the vector closed and empty.
+    size_type count = bytes / sizeof(T);
+    pointer data = nullptr;
+    if (count != 0) {
+      try {
+        data = static_cast<pointer>(map(count));
+      } catch (...) {
+        close();
+        throw;
+      }
+    }
+    m_Data = data;
+    m_Size = count;
+    m_Capacity = count;
+  }
+
+  // Unmaps the file and, in ReadWrite mode, trims it to size().
+  void close() {
+    if (m_Data != nullptr) {
+      ::munmap(const_cast<T *>(m_Data), m_Capacity * sizeof(T));
+    }
+    if (m_File >= 0) {
+      if (m_Writable && m_Capacity != m_Size) {
+        // Nothing useful to do if this fails while closing.
+        (void)::ftruncate(m_File, static_cast<off_t>(m_Size * sizeof(T)));
+      }
+      ::close(m_File);
+    }
+    m_File = -1;
+    m_Capacity = 0;
+    m_Size = 0;
+    m_Data = nullptr;
+  }
+
+  bool is_open() const { return m_File >= 0; }
+
+  static constexpr MapMode mode() { return Mode; }
+
+  // Writes dirty pages back to the file. With `wait` false the kernel only
+  // schedules the write-back.
+  void sync(bool wait = true) {
+    if (m_Data == nullptr) {
+      return;
+    }
+    if (::msync(const_cast<T *>(m_Data), m_Size * sizeof(T),
+                wait ? MS_SYNC : MS_ASYNC) != 0) {
+      throw_errno("msync");
+    }
+  }
+
+  size_type capacity() const { return m_Capacity; }
+
+  size_type size() const { return m_Size; }
+
+  bool empty() const { return (m_Size == 0); }
+
+  pointer data() { return m_Data; }
+  const_pointer data() const { return m_Data; }
+
+  iterator begin() { return iterator{m_Data}; }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator cbegin() const { return const_iterator{m_Data}; }
+
+  iterator end() { return iterator{m_Data + m_Size}; }
+  const_iterator end() const { return cend(); }
+  const_iterator cend() const { return const_iterator{m_Data + m_Size}; }
+
+  template <typename Self>
+  auto &&operator[](this Self &&self, size_type index) {
+    if (index >= self.m_Size) {
+      throw std::out_of_range("MappedVector index out of range");
+    }
+    return std::forward<Self>(self).m_Data[index];
+  }
+
+  template <typename Self>
+  auto &&front(this Self &&self) {
+    return std::forward<Self>(self)[0];
+  }
+
+  template <typename Self>
+  auto &&back(this Self &&self) {
+    return std::forward<Self>(self)[self.m_Size - 1];
+  }
+
+  // Modifiers, ReadWrite mode only
+
+  void reserve(size_type capacity)
+    requires m_Writable
+  {
+    if (capacity > m_Capacity) {
+      remap(capacity);
+    }
+  }
+
+  // Gives the spare file space back; size() is unchanged.
+  void shrink_to_fit()
+    requires m_Writable
+  {
+    if (m_Size < m_Capacity) {
+      remap(m_Size);
+    }
+  }
+
+  void resize(size_type size, const T &val = T{})
+    requires m_Writable
+  {
+    if (size > m_Capacity) {
+      remap(GrowthPolicy::grow(m_Capacity, size));
+    }
+    for (size_type i = m_Size; i < size; ++i) {
+      m_Data[i] = val;
+    }
+    m_Size = size;
+  }
+
+  void push_back(const T &val)
+    requires m_Writable
+  {
+    if (m_Size == m_Capacity) {
+      remap(GrowthPolicy::grow(m_Capacity, m_Size + 1));
+    }
+    m_Data[m_Size++] = val;
+  }
+
+  template <typename... Args>
+  void emplace_back(Args &&...args)
+    requires m_Writable
+  {
+    push_back(T{std::forward<Args>(args)...});
+  }
+
+  void pop_back()
+    requires m_Writable
+  {
+    if (m_Size > 0) {
+      --m_Size;
+    }
+  }
+
+  void clear()
+    requires m_Writable
+  {
+    m_Size = 0;
+  }
+
+private:
+  void *map(size_type capacity) {
+    int protection = m_Writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *data = ::mmap(nullptr, capacity * sizeof(T), protection, MAP_SHARED,
+                        m_File, 0);
+    if (data == MAP_FAILED) {
+      throw_errno("mmap");
+    }
+    return data;
+  }
+
+  // Resizes the file to `capacity` elements and maps it again.
+  void remap(size_type capacity) {
+    if (::ftruncate(m_File, static_cast<off_t>(capacity * sizeof(T))) != 0) {
+      throw_errno("ftruncate");
+    }
+
+    if (capacity == 0) {
+      if (m_Data != nullptr) {
+        ::munmap(const_cast<T *>(m_Data), m_Capacity * sizeof(T));
+      }
+      m_Data = nullptr;
+    } else if (m_Data == nullptr) {
+      m_Data = static_cast<pointer>(map(capacity));
+    } else {
+#if defined(__linux__)
+      void *data = ::mremap(const_cast<T *>(m_Data),
+                            m_Capacity * sizeof(T), capacity * sizeof(T),
+                            MREMAP_MAYMOVE);
+      if (data == MAP_FAILED) {
+        throw_errno("mremap");
+      }
+#else
+      ::munmap(const_cast<T *>(m_Data), m_Capacity * sizeof(T));
+      void *data = map(capacity);
+#endif
+      m_Data = static_cast<pointer>(data);
+    }
+    m_Capacity = capacity;
+  }
+
+  void swap(MappedVector &other) {
+    std::swap(m_File, other.m_File);
+    std::swap(m_Capacity, other.m_Capacity);
+    std::swap(m_Size, other.m_Size);
+    std::swap(m_Data, other.m_Data);
+  }
+
+  [[noreturn]] static void throw_errno(char const *what) {
+    throw std::system_error(errno, std::generic_category(), what);
+  }
+
+private:
+  int m_File;
+  size_type m_Capacity;
+  size_type m_Size;
+  pointer m_Data;
+};
+
+} // namespace mystl
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "algorithms.h"
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace mystl {
+
+// Tag for constructors that default-initialize their elements, leaving
+// trivially default constructible ones (ints, floats, PODs) uninitialized.
+struct default_init_t {
+  explicit default_init_t() = default;
+};
+
+inline constexpr default_init_t default_init{};
+
+// A type is trivially relocatable when moving it to a new address and
+// destroying the original is equivalent to copying its bytes. Every
+// trivially copyable type qualifies. Types that own resources but hold no
+// pointers into themselves (e.g. a unique_ptr-like handle) can opt in:
+//
+//   template <>
+//   struct mystl::is_trivially_relocatable<Handle> : std::true_type {};
+template <typename T>
+struct is_trivially_relocatable
+    : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+// Moves `count` objects from `first` to `dest` and ends the lifetime of the
+// originals, so the source is left as raw memory and the destination must
+// be raw memory. The two ranges may overlap.
+template <typename T>
+constexpr void relocate(T *first, std::size_t count, T *dest) {
+  if (count == 0 || first == dest) {
+    return;
+  }
+
+  if constexpr (is_trivially_relocatable_v<T>) {
+    if (!std::is_constant_evaluated()) {
+      std::memmove(static_cast<void *>(dest), static_cast<void *>(first),
+                   count * sizeof(T));
+      return;
+    }
+  }
+
+  if (dest < first) {
+    for (std::size_t i = 0; i < count; ++i) {
+      std::construct_at(dest + i, std::move(first[i]));
+      std::destroy_at(first + i);
+    }
+  } else {
+    for (std::size_t i = count; i > 0; --i) {
+      std::construct_at(dest + i - 1, std::move(first[i - 1]));
+      std::destroy_at(first + i - 1);
+    }
+  }
+}
+
+// Move-assigns `count` objects from `first` onto the live objects at `dest`
+// and ends the lifetime of the originals, e.g. to hand elements out of a
+// queue into a caller's array. The ranges must not overlap.
+template <typename T>
+constexpr void relocate_assign(T *first, std::size_t count, T *dest) {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    if (!std::is_constant_evaluated()) {
+      if (count != 0) {
+        std::memcpy(static_cast<void *>(dest), static_cast<void *>(first),
+                    count * sizeof(T));
+      }
+      return;
+    }
+  }
+
+  for (std::size_t i = 0; i < count; ++i) {
+    dest[i] = std::move(first[i]);
+    std::destroy_at(first + i);
+  }
+}
+
+// Constructs copies of `value` in the raw memory [first, last).
+template <typename T>
+constexpr void uninitialized_fill(T *first, T *last, T const &value) {
+  if constexpr (std::is_trivially_copyable_v<T> &&
+                std::is_trivially_default_constructible_v<T>) {
+    algo::fill(first, last, value);
+  } else {
+    for (; first != last; ++first) {
+      std::construct_at(first, value);
+    }
+  }
+}
+
+// Default-initializes the raw memory [first, last). A no-op for trivially
+// default constructible types, which is the point: no memory pass.
+template <typename T>
+constexpr void uninitialized_default_construct(T *first, T *last) {
+  if constexpr (!std::is_trivially_default_constructible_v<T>) {
+    for (; first != last; ++first) {
+      ::new (static_cast<void *>(first)) T;
+    }
+  }
+}
+
+// Copy-constructs [fromBegin, fromEnd) into the raw memory at `to`.
+template <typename FromIter_t, typename T>
+constexpr void uninitialized_copy(FromIter_t fromBegin, FromIter_t fromEnd,
+                                  T *to) {
+  if constexpr (std::is_trivially_copyable_v<T> &&
+                std::is_trivially_default_constructible_v<T>) {
+    algo::copy(fromBegin, fromEnd, to);
+  } else {
+    for (; fromBegin != fromEnd; ++fromBegin, ++to) {
+      std::construct_at(to, *fromBegin);
+    }
+  }
+}
+
+// Destroys [first, last) without releasing the memory.
+template <typename T>
+constexpr void destroy(T *first, T *last) {
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    for (; first != last; ++first) {
+      std::destroy_at(first);
+    }
+  }
+}
+
+// Copy-constructs `count` elements starting at `from` into the raw memory at
+// `to`. Pointers to trivially copyable elements become a single memcpy.
+// If a copy throws, the elements already made are destroyed.
+template <typename FromIter_t, typename T>
+constexpr void uninitialized_copy_n(FromIter_t from, std::size_t count,
+                                    T *to) {
+  using from_value_t = std::remove_cv_t<std::remove_pointer_t<FromIter_t>>;
+
+  if constexpr (std::is_pointer_v<FromIter_t> &&
+                std::is_same_v<from_value_t, T> &&
+                std::is_trivially_copyable_v<T>) {
+    if (!std::is_constant_evaluated()) {
+      if (count != 0) {
+        std::memcpy(static_cast<void *>(to), static_cast<void const *>(from),
+                    count * sizeof(T));
+      }
+      return;
+    }
+  }
+
+  std::size_t i = 0;
+  try {
+    for (; i < count; ++i, ++from) {
+      std::construct_at(to + i, *from);
+    }
+  } catch (...) {
+    destroy(to, to + i);
+    throw;
+  }
+}
+
+} // namespace mystl
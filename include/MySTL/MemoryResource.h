@@ -0,0 +1,480 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace mystl {
+
+// Type-erased source of raw memory, in the spirit of std::pmr.
+// Containers reach it through PolymorphicAllocator.
+class MemoryResource {
+public:
+  static constexpr std::size_t m_DefaultAlignment = alignof(std::max_align_t);
+
+  virtual ~MemoryResource() = default;
+
+  void *allocate(std::size_t bytes,
+                 std::size_t alignment = m_DefaultAlignment) {
+    return do_allocate(bytes, alignment);
+  }
+
+  void deallocate(void *data, std::size_t bytes,
+                  std::size_t alignment = m_DefaultAlignment) {
+    do_deallocate(data, bytes, alignment);
+  }
+
+  bool is_equal(MemoryResource const &other) const {
+    return do_is_equal(other);
+  }
+
+private:
+  virtual void *do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+
+  virtual void do_deallocate(void *data, std::size_t bytes,
+                             std::size_t alignment) = 0;
+
+  virtual bool do_is_equal(MemoryResource const &other) const {
+    return this == &other;
+  }
+};
+
+inline bool operator==(MemoryResource const &a, MemoryResource const &b) {
+  return &a == &b || a.is_equal(b);
+}
+
+namespace internal {
+
+class new_delete_resource final : public MemoryResource {
+private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    return ::operator new(bytes, std::align_val_t{alignment});
+  }
+
+  void do_deallocate(void *data, std::size_t bytes,
+                     std::size_t alignment) override {
+    ::operator delete(data, bytes, std::align_val_t{alignment});
+  }
+
+  bool do_is_equal(MemoryResource const &other) const override {
+    return dynamic_cast<new_delete_resource const *>(&other) != nullptr;
+  }
+};
+
+constexpr std::size_t align_up(std::size_t value, std::size_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace internal
+
+// The global heap, used as the upstream of every other resource by default.
+inline MemoryResource *default_resource() {
+  static internal::new_delete_resource resource;
+  return &resource;
+}
+
+// Bump-pointer arena. deallocate() is a no-op; everything is handed back to
+// the upstream resource at once by release() or the destructor. Chunks grow
+// geometrically, and an optional initial buffer (e.g. on the stack) is used
+// before the upstream is ever touched.
+class MonotonicResource : public MemoryResource {
+public:
+  explicit MonotonicResource(MemoryResource *upstream = default_resource())
+      : MonotonicResource(nullptr, 0, upstream) {}
+
+  explicit MonotonicResource(std::size_t initialSize,
+                             MemoryResource *upstream = default_resource())
+      : MonotonicResource(nullptr, 0, upstream) {
+    m_NextChunkSize = initialSize < m_MinChunkSize ? m_MinChunkSize
+                                                   : initialSize;
+  }
+
+  MonotonicResource(void *buffer, std::size_t size,
+                    MemoryResource *upstream = default_resource())
+      : m_Upstream(upstream), m_Chunks(nullptr), m_InitialBuffer(buffer),
+        m_InitialSize(size), m_Current(static_cast<std::byte *>(buffer)),
+        m_Remaining(size), m_NextChunkSize(m_MinChunkSize) {}
+
+  MonotonicResource(MonotonicResource const &) = delete;
+  MonotonicResource &operator=(MonotonicResource const &) = delete;
+
+  ~MonotonicResource() override { release(); }
+
+  // Frees every chunk and rewinds to the initial buffer.
+  void release() {
+    while (m_Chunks != nullptr) {
+      chunk_header *prev = m_Chunks->prev;
+      m_Upstream->deallocate(m_Chunks, m_Chunks->size);
+      m_Chunks = prev;
+    }
+    m_Current = static_cast<std::byte *>(m_InitialBuffer);
+    m_Remaining = m_InitialSize;
+  }
+
+  MemoryResource *upstream_resource() const { return m_Upstream; }
+
+private:
+  struct chunk_header {
+    chunk_header *prev;
+    std::size_t size;
+  };
+
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    void *data = bump(bytes, alignment);
+    if (data == nullptr) {
+      add_chunk(bytes + alignment);
+      data = bump(bytes, alignment);
+    }
+    return data;
+  }
+
+  void do_deallocate(void *, std::size_t, std::size_t) override {}
+
+  void *bump(std::size_t bytes, std::size_t alignment) {
+    auto address = reinterpret_cast<std::uintptr_t>(m_Current);
+    std::size_t padding = internal::align_up(address, alignment) - address;
+    if (m_Current == nullptr || padding + bytes > m_Remaining) {
+      return nullptr;
+    }
+    std::byte *data = m_Current + padding;
+    m_Current = data + bytes;
+    m_Remaining -= padding + bytes;
+    return data;
+  }
+
+  void add_chunk(std::size_t minBytes) {
+    std::size_t size = m_NextChunkSize;
+    while (size < minBytes + sizeof(chunk_header)) {
+      size *= 2;
+    }
+    m_NextChunkSize = size * 2;
+
+    auto *chunk = static_cast<chunk_header *>(m_Upstream->allocate(size));
+    chunk->prev = m_Chunks;
+    chunk->size = size;
+    m_Chunks = chunk;
+
+    m_Current = reinterpret_cast<std::byte *>(chunk) + sizeof(chunk_header);
+    m_Remaining = size - sizeof(chunk_header);
+  }
+
+private:
+  static constexpr std::size_t m_MinChunkSize = 1024;
+
+  MemoryResource *m_Upstream;
+  chunk_header *m_Chunks;
+  void *m_InitialBuffer;
+  std::size_t m_InitialSize;
+  std::byte *m_Current;
+  std::size_t m_Remaining;
+  std::size_t m_NextChunkSize;
+};
+
+// Hands out blocks of one fixed size, carved from chunks that start at
+// blocksPerChunk blocks and double up to m_MaxBlocksPerChunk, and recycled
+// through an intrusive free list. A block size of 0 takes the size of the
+// first request. Blocks are aligned to the alignment of the first request
+// (at most m_DefaultAlignment), so 24-byte nodes of 8-byte alignment pack at
+// 24 bytes. Requests that do not fit a block go straight to the upstream
+// resource. release() or the destructor frees all chunks at once,
+// in O(chunks).
+class PoolResource : public MemoryResource {
+public:
+  explicit PoolResource(std::size_t blockSize,
+                        std::size_t blocksPerChunk = 64,
+                        MemoryResource *upstream = default_resource())
+      : m_Upstream(upstream), m_BlockSize(blockSize), m_BlockAlignment(0),
+        m_BlocksPerChunk(blocksPerChunk == 0 ? 1 : blocksPerChunk),
+        m_NextChunkBlocks(m_BlocksPerChunk), m_Chunks(nullptr),
+        m_FreeList(nullptr), m_Current(nullptr), m_Remaining(0) {}
+
+  PoolResource(PoolResource const &) = delete;
+  PoolResource &operator=(PoolResource const &) = delete;
+
+  ~PoolResource() override { release(); }
+
+  void release() {
+    while (m_Chunks != nullptr) {
+      chunk_header *prev = m_Chunks->prev;
+      m_Upstream->deallocate(m_Chunks, m_Chunks->bytes);
+      m_Chunks = prev;
+    }
+    m_NextChunkBlocks = m_BlocksPerChunk;
+    m_FreeList = nullptr;
+    m_Current = nullptr;
+    m_Remaining = 0;
+  }
+
+  // Final once the first block has been handed out.
+  std::size_t block_size() const { return m_BlockSize; }
+
+  std::size_t block_alignment() const { return m_BlockAlignment; }
+
+  MemoryResource *upstream_resource() const { return m_Upstream; }
+
+private:
+  struct free_block {
+    free_block *next;
+  };
+
+  struct alignas(std::max_align_t) chunk_header {
+    chunk_header *prev;
+    std::size_t bytes;
+  };
+
+  static std::size_t round_block_size(std::size_t bytes,
+                                      std::size_t alignment) {
+    return internal::align_up(
+        bytes < sizeof(free_block) ? sizeof(free_block) : bytes, alignment);
+  }
+
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    // The first request that can be pooled fixes the block layout. Chunks
+    // start on m_DefaultAlignment, so every block up to that is aligned.
+    if (m_BlockAlignment == 0 && alignment <= m_DefaultAlignment) {
+      m_BlockAlignment =
+          alignment < alignof(free_block) ? alignof(free_block) : alignment;
+      m_BlockSize = round_block_size(m_BlockSize == 0 ? bytes : m_BlockSize,
+                                     m_BlockAlignment);
+    }
+    if (bytes > m_BlockSize || alignment > m_BlockAlignment) {
+      return m_Upstream->allocate(bytes, alignment);
+    }
+
+    if (m_FreeList != nullptr) {
+      free_block *block = m_FreeList;
+      m_FreeList = block->next;
+      return block;
+    }
+
+    if (m_Remaining == 0) {
+      add_chunk();
+    }
+    std::byte *block = m_Current;
+    m_Current += m_BlockSize;
+    --m_Remaining;
+    return block;
+  }
+
+  void do_deallocate(void *data, std::size_t bytes,
+                     std::size_t alignment) override {
+    if (bytes > m_BlockSize || alignment > m_BlockAlignment) {
+      m_Upstream->deallocate(data, bytes, alignment);
+      return;
+    }
+
+    auto *block = static_cast<free_block *>(data);
+    block->next = m_FreeList;
+    m_FreeList = block;
+  }
+
+  void add_chunk() {
+    std::size_t blocks = m_NextChunkBlocks;
+    if (m_NextChunkBlocks < m_MaxBlocksPerChunk) {
+      m_NextChunkBlocks *= 2;
+    }
+
+    std::size_t bytes = sizeof(chunk_header) + m_BlockSize * blocks;
+    auto *chunk = static_cast<chunk_header *>(m_Upstream->allocate(bytes));
+    chunk->prev = m_Chunks;
+    chunk->bytes = bytes;
+    m_Chunks = chunk;
+
+    m_Current = reinterpret_cast<std::byte *>(chunk + 1);
+    m_Remaining = blocks;
+  }
+
+private:
+  static constexpr std::size_t m_MaxBlocksPerChunk = 4096;
+
+  MemoryResource *m_Upstream;
+  std::size_t m_BlockSize;
+  std::size_t m_BlockAlignment;
+  std::size_t m_BlocksPerChunk;
+  std::size_t m_NextChunkBlocks;
+  chunk_header *m_Chunks;
+  free_block *m_FreeList;
+  std::byte *m_Current;
+  std::size_t m_Remaining;
+};
+
+// Allocator that forwards to a MemoryResource chosen at run time, so
+// containers using different resources still share one type.
+template <typename T>
+class PolymorphicAllocator {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  // Like std::pmr, the resource stays with the container it was given to.
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+
+public:
+  PolymorphicAllocator() : m_Resource(default_resource()) {}
+
+  PolymorphicAllocator(MemoryResource *resource) : m_Resource(resource) {}
+
+  template <typename U>
+  PolymorphicAllocator(PolymorphicAllocator<U> const &other)
+      : m_Resource(other.resource()) {}
+
+  T *allocate(size_type count) {
+    return static_cast<T *>(
+        m_Resource->allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *data, size_type count) {
+    m_Resource->deallocate(data, count * sizeof(T), alignof(T));
+  }
+
+  MemoryResource *resource() const { return m_Resource; }
+
+  // Copies of a container go back to the default resource.
+  PolymorphicAllocator select_on_container_copy_construction() const {
+    return PolymorphicAllocator{};
+  }
+
+  template <typename U>
+  friend bool operator==(PolymorphicAllocator const &a,
+                         PolymorphicAllocator<U> const &b) {
+    return *a.resource() == *b.resource();
+  }
+
+private:
+  MemoryResource *m_Resource;
+};
+
+namespace internal {
+
+// The pool behind a family of PoolAllocator copies, freed with the last one.
+// Copies may be destroyed on different threads, so the count is atomic.
+struct pool_allocator_state {
+  PoolResource m_Pool{0};
+  std::atomic<std::size_t> m_References{1};
+};
+
+} // namespace internal
+
+// Allocator that gives each container its own PoolResource, so node-based
+// containers get single objects from contiguous chunks and a free list
+// instead of one malloc per node. The pool is sized by the first
+// single-object request (after rebinding, the node); arrays go to the
+// default resource.
+//
+// The pool is created on first use, so an empty container costs nothing.
+// Copies and rebinds share it, and it is released in O(chunks) when the
+// last of them goes away. Moving hands the pool over: the source is left
+// with none and starts a fresh one if used again, so a moved-from container
+// shares nothing with the one it was moved into. Allocating is not
+// thread-safe: containers sharing a pool must stay on one thread.
+template <typename T>
+class PoolAllocator {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  // Nodes live in the pool, so moving a container must move the pool too.
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+public:
+  PoolAllocator() = default;
+
+  PoolAllocator(PoolAllocator const &other) : m_State(other.state()) {
+    m_State->m_References.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  template <typename U>
+  PoolAllocator(PoolAllocator<U> const &other) : m_State(other.state()) {
+    m_State->m_References.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  PoolAllocator(PoolAllocator &&other) noexcept
+      : m_State(std::exchange(other.m_State, nullptr)) {}
+
+  template <typename U>
+  PoolAllocator(PoolAllocator<U> &&other) noexcept
+      : m_State(std::exchange(other.m_State, nullptr)) {}
+
+  PoolAllocator &operator=(PoolAllocator const &other) {
+    PoolAllocator copy(other);
+    std::swap(m_State, copy.m_State);
+    return *this;
+  }
+
+  PoolAllocator &operator=(PoolAllocator &&other) noexcept {
+    PoolAllocator moved(std::move(other));
+    std::swap(m_State, moved.m_State);
+    return *this;
+  }
+
+  ~PoolAllocator() {
+    if (m_State != nullptr &&
+        m_State->m_References.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete m_State;
+    }
+  }
+
+  T *allocate(size_type count) {
+    if (count != 1) {
+      return static_cast<T *>(
+          default_resource()->allocate(count * sizeof(T), alignof(T)));
+    }
+    return static_cast<T *>(state()->m_Pool.allocate(sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *data, size_type count) {
+    if (count != 1) {
+      default_resource()->deallocate(data, count * sizeof(T), alignof(T));
+      return;
+    }
+    m_State->m_Pool.deallocate(data, sizeof(T), alignof(T));
+  }
+
+  // Frees every chunk at once if no other container shares the pool. The
+  // caller promises that none of its objects needs destroying.
+  bool release_if_unshared() {
+    if (m_State == nullptr) {
+      return true;
+    }
+    if (m_State->m_References.load(std::memory_order_acquire) != 1) {
+      return false;
+    }
+    m_State->m_Pool.release();
+    return true;
+  }
+
+  // Copies of a container get a pool of their own.
+  PoolAllocator select_on_container_copy_construction() const {
+    return PoolAllocator{};
+  }
+
+  template <typename U>
+  friend bool operator==(PoolAllocator const &a, PoolAllocator<U> const &b) {
+    return a.state() == b.state();
+  }
+
+private:
+  template <typename U>
+  friend class PoolAllocator;
+
+  // Creates the pool on first use. Allocators without one are not equal to
+  // anything yet, so comparing them creates it too.
+  internal::pool_allocator_state *state() const {
+    if (m_State == nullptr) {
+      m_State = new internal::pool_allocator_state;
+    }
+    return m_State;
+  }
+
+  mutable internal::pool_allocator_state *m_State = nullptr;
+};
+
+} // namespace mystl
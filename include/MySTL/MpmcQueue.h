@@ -0,0 +1,228 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Concurrency.h"
+#include "Memory.h"
+#include "MySTL/algorithms.h"
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+namespace mystl {
+
+// Bounded lock-free queue for any number of producer and consumer threads,
+// after Dmitry Vyukov's design. Every slot carries a sequence number that
+// says whose turn it is: a producer may fill slot i of lap n when it reads
+// i + n * capacity, a consumer may empty it when it reads one more. A thread
+// claims a slot with one CAS on the shared tail (or head) index and never
+// waits on another thread that has claimed a different slot.
+//
+// try_push() / try_pop() fail immediately when the queue is full / empty.
+// push() / pop() spin and yield briefly, then sleep on a futex until the
+// other side makes room; the _for() variants give up after a timeout.
+template <typename T>
+class MpmcQueue {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+public:
+  // The capacity is rounded up to a power of two, at least 2.
+  explicit MpmcQueue(size_type capacity)
+      : m_Mask(std::bit_ceil(algo::max(capacity, size_type{2})) - 1),
+        m_Cells(cell_allocator{}.allocate(m_Mask + 1)) {
+    for (size_type i = 0; i <= m_Mask; ++i) {
+      std::construct_at(m_Cells + i, i);
+    }
+  }
+
+  MpmcQueue(MpmcQueue const &) = delete;
+  MpmcQueue &operator=(MpmcQueue const &) = delete;
+
+  ~MpmcQueue() {
+    size_type head = m_Head.load(std::memory_order_relaxed);
+    size_type tail = m_Tail.load(std::memory_order_relaxed);
+    for (; head != tail; ++head) {
+      std::destroy_at(m_Cells[head & m_Mask].value());
+    }
+    for (size_type i = 0; i <= m_Mask; ++i) {
+      std::destroy_at(m_Cells + i);
+    }
+    cell_allocator{}.deallocate(m_Cells, m_Mask + 1);
+  }
+
+  size_type capacity() const { return m_Mask + 1; }
+
+  // Only a snapshot while other threads are running.
+  size_type size() const {
+    size_type head = m_Head.load(std::memory_order_acquire);
+    size_type tail = m_Tail.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  // Producer side
+
+  template <typename... Args>
+  bool try_emplace(Args &&...args) {
+    size_type pos = m_Tail.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+      cell = &m_Cells[pos & m_Mask];
+      size_type sequence = cell->m_Sequence.load(std::memory_order_acquire);
+      auto lag = static_cast<std::intptr_t>(sequence - pos);
+      if (lag == 0) {
+        if (m_Tail.compare_exchange_weak(pos, pos + 1,
+                                         std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (lag < 0) {
+        // The slot still holds last lap's element: full.
+        return false;
+      } else {
+        pos = m_Tail.load(std::memory_order_relaxed);
+      }
+    }
+
+    new (cell->value()) T{std::forward<Args>(args)...};
+    cell->m_Sequence.store(pos + 1, std::memory_order_release);
+    m_NotEmpty.notify_one();
+    return true;
+  }
+
+  bool try_push(T const &val) { return try_emplace(val); }
+
+  bool try_push(T &&val) { return try_emplace(std::move(val)); }
+
+  void push(T const &val) {
+    wait_for_turn(m_NotFull, [&] { return try_emplace(val); });
+  }
+
+  void push(T &&val) {
+    wait_for_turn(m_NotFull, [&] { return try_emplace(std::move(val)); });
+  }
+
+  template <typename Rep, typename Period>
+  bool try_push_for(T const &val,
+                    std::chrono::duration<Rep, Period> timeout) {
+    return wait_for_turn(m_NotFull, [&] { return try_emplace(val); },
+                         std::chrono::steady_clock::now() + timeout);
+  }
+
+  template <typename Rep, typename Period>
+  bool try_push_for(T &&val, std::chrono::duration<Rep, Period> timeout) {
+    return wait_for_turn(
+        m_NotFull, [&] { return try_emplace(std::move(val)); },
+        std::chrono::steady_clock::now() + timeout);
+  }
+
+  // Consumer side
+
+  bool try_pop(T &out) {
+    size_type pos = m_Head.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+      cell = &m_Cells[pos & m_Mask];
+      size_type sequence = cell->m_Sequence.load(std::memory_order_acquire);
+      auto lag = static_cast<std::intptr_t>(sequence - (pos + 1));
+      if (lag == 0) {
+        if (m_Head.compare_exchange_weak(pos, pos + 1,
+                                         std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (lag < 0) {
+        // Nothing has been written to the slot this lap: empty.
+        return false;
+      } else {
+        pos = m_Head.load(std::memory_order_relaxed);
+      }
+    }
+
+    relocate_assign(cell->value(), 1, &out);
+    cell->m_Sequence.store(pos + m_Mask + 1, std::memory_order_release);
+    m_NotFull.notify_one();
+    return true;
+  }
+
+  void pop(T &out) {
+    wait_for_turn(m_NotEmpty, [&] { return try_pop(out); });
+  }
+
+  template <typename Rep, typename Period>
+  bool try_pop_for(T &out, std::chrono::duration<Rep, Period> timeout) {
+    return wait_for_turn(m_NotEmpty, [&] { return try_pop(out); },
+                         std::chrono::steady_clock::now() + timeout);
+  }
+
+private:
+  struct Cell {
+    explicit Cell(size_type sequence) : m_Sequence(sequence) {}
+
+    T *value() { return std::launder(reinterpret_cast<T *>(m_Storage)); }
+
+    std::atomic<size_type> m_Sequence;
+    alignas(T) std::byte m_Storage[sizeof(T)];
+  };
+
+  using cell_allocator = mystl::Allocator<Cell>;
+  using time_point = std::chrono::steady_clock::time_point;
+
+  // Retries `attempt` until it succeeds: a short spin, then a few yields so
+  // that a descheduled peer can run, then parking on `event`. Returns false
+  // once `deadline` has passed.
+  template <typename Attempt_t>
+  bool wait_for_turn(internal::event_count &event, Attempt_t attempt,
+                     time_point deadline = time_point::max()) {
+    for (int spin = 0; spin < m_SpinCount; ++spin) {
+      if (attempt()) {
+        return true;
+      }
+      cpu_relax();
+    }
+    for (int yield = 0; yield < m_YieldCount; ++yield) {
+      if (attempt()) {
+        return true;
+      }
+      std::this_thread::yield();
+    }
+
+    for (;;) {
+      std::uint32_t epoch = event.prepare_wait();
+      if (attempt()) {
+        event.cancel_wait();
+        return true;
+      }
+      if (deadline == time_point::max()) {
+        event.wait(epoch);
+      } else if (std::chrono::steady_clock::now() < deadline) {
+        event.wait_until(epoch, deadline);
+      } else {
+        event.cancel_wait();
+        return false;
+      }
+    }
+  }
+
+private:
+  static constexpr int m_SpinCount = 64;
+  static constexpr int m_YieldCount = 16;
+
+  size_type const m_Mask;
+  Cell *const m_Cells;
+
+  alignas(cache_line_size) std::atomic<size_type> m_Tail{0};
+  alignas(cache_line_size) std::atomic<size_type> m_Head{0};
+
+  // Consumers sleep on m_NotEmpty, producers on m_NotFull.
+  alignas(cache_line_size) internal::event_count m_NotEmpty;
+  alignas(cache_line_size) internal::event_count m_NotFull;
+};
+
+} // namespace mystl
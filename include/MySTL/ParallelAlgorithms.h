@@ -0,0 +1,318 @@
+#pragma once
+
+#include "ThreadPool.h"
+#include "Vector.h"
+#include "algorithms.h"
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace mystl {
+
+namespace execution {
+
+// Run the algorithm on the calling thread, exactly like the overload
+// without a policy.
+class sequenced_policy {};
+
+// Split the range across a ThreadPool: the default one, or the one given
+// to on(). The element functions may run concurrently, so they must not
+// race with each other. par_unseq additionally allows them to be
+// interleaved within a thread (vectorized); here it is scheduled like par,
+// whose per-chunk loops the compiler is already free to vectorize.
+template <bool Unsequenced>
+class basic_parallel_policy {
+public:
+  constexpr basic_parallel_policy() = default;
+
+  // The same policy, running on `pool`.
+  basic_parallel_policy on(ThreadPool &pool) const {
+    basic_parallel_policy policy;
+    policy.m_Pool = &pool;
+    return policy;
+  }
+
+  ThreadPool &pool() const {
+    return m_Pool != nullptr ? *m_Pool : default_thread_pool();
+  }
+
+private:
+  ThreadPool *m_Pool = nullptr;
+};
+
+using parallel_policy = basic_parallel_policy<false>;
+using parallel_unsequenced_policy = basic_parallel_policy<true>;
+
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+inline constexpr parallel_unsequenced_policy par_unseq{};
+
+template <typename T>
+struct is_execution_policy : std::false_type {};
+
+template <>
+struct is_execution_policy<sequenced_policy> : std::true_type {};
+
+template <bool Unsequenced>
+struct is_execution_policy<basic_parallel_policy<Unsequenced>>
+    : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_execution_policy_v = is_execution_policy<T>::value;
+
+} // namespace execution
+
+namespace algo {
+
+template <typename Policy>
+concept execution_policy =
+    execution::is_execution_policy_v<std::remove_cvref_t<Policy>>;
+
+// Overloads of the algorithms that take an execution policy first. With a
+// parallel policy, ranges behind raw pointers or ContiguousIterator are cut
+// into chunks of about parallel_chunk_bytes, small enough to stay in the
+// core's L2 while it works on them, and the chunks run on the policy's
+// pool. Sequential policies and other iterators use the plain algorithm.
+
+namespace internal {
+
+inline constexpr std::size_t parallel_chunk_bytes = std::size_t{64} << 10;
+
+template <typename Policy, typename... Iters>
+inline constexpr bool runs_in_parallel_v =
+    !std::is_same_v<std::remove_cvref_t<Policy>,
+                    execution::sequenced_policy> &&
+    (std::is_pointer_v<decltype(mystl::internal::unwrap_contiguous(
+         std::declval<Iters>()))> &&
+     ...);
+
+// [0, count) in chunks of about parallel_chunk_bytes worth of Elem_t.
+template <typename Elem_t>
+struct chunking {
+  explicit chunking(std::size_t count)
+      : m_Count(count),
+        m_Length(algo::max(parallel_chunk_bytes / sizeof(Elem_t),
+                           std::size_t{1})),
+        m_Chunks((count + m_Length - 1) / m_Length) {}
+
+  std::size_t begin(std::size_t chunk) const { return chunk * m_Length; }
+
+  std::size_t end(std::size_t chunk) const {
+    return algo::min(begin(chunk) + m_Length, m_Count);
+  }
+
+  std::size_t m_Count;
+  std::size_t m_Length;
+  std::size_t m_Chunks;
+};
+
+// Runs body(begin, end) for every chunk of [0, count) on `pool`.
+template <typename Elem_t, typename Fn>
+void for_each_chunk(ThreadPool &pool, std::size_t count, Fn &&body) {
+  chunking<Elem_t> chunks(count);
+  pool.parallel_for(chunks.m_Chunks, [&](std::size_t chunk) {
+    body(chunks.begin(chunk), chunks.end(chunk));
+  });
+}
+
+// Folds each chunk on its own and then the chunk results, in order, into
+// `init`. `fold(begin, end)` reduces the non-empty [begin, end) to a T.
+template <typename Elem_t, typename T, typename BinaryOp, typename Fold>
+T reduce_chunks(ThreadPool &pool, std::size_t count, T init, BinaryOp &op,
+                Fold &&fold) {
+  chunking<Elem_t> chunks(count);
+  Vector<std::optional<T>> partials(chunks.m_Chunks);
+  pool.parallel_for(chunks.m_Chunks, [&](std::size_t chunk) {
+    partials[chunk].emplace(fold(chunks.begin(chunk), chunks.end(chunk)));
+  });
+  for (std::optional<T> &partial : partials) {
+    init = op(std::move(init), std::move(*partial));
+  }
+  return init;
+}
+
+} // namespace internal
+
+template <execution_policy Policy, typename Iter_t, typename Fn>
+void for_each(Policy &&policy, Iter_t first, Iter_t last, Fn fn) {
+  if constexpr (internal::runs_in_parallel_v<Policy, Iter_t>) {
+    auto *data = mystl::internal::unwrap_contiguous(first);
+    using elem_t = std::remove_pointer_t<decltype(data)>;
+    internal::for_each_chunk<elem_t>(
+        policy.pool(), static_cast<std::size_t>(last - first),
+        [&](std::size_t begin, std::size_t end) {
+          algo::for_each(data + begin, data + end, fn);
+        });
+  } else {
+    algo::for_each(first, last, fn);
+  }
+}
+
+template <execution_policy Policy, typename FromIter_t, typename ToIter_t,
+          typename UnaryOp>
+ToIter_t transform(Policy &&policy, FromIter_t first, FromIter_t last,
+                   ToIter_t dest, UnaryOp op) {
+  if constexpr (internal::runs_in_parallel_v<Policy, FromIter_t, ToIter_t>) {
+    auto count = static_cast<std::size_t>(last - first);
+    auto *from = mystl::internal::unwrap_contiguous(first);
+    auto *to = mystl::internal::unwrap_contiguous(dest);
+    using elem_t = std::remove_pointer_t<decltype(from)>;
+    internal::for_each_chunk<elem_t>(
+        policy.pool(), count, [&](std::size_t begin, std::size_t end) {
+          algo::transform(from + begin, from + end, to + begin, op);
+        });
+    return dest + count;
+  } else {
+    return algo::transform(first, last, dest, op);
+  }
+}
+
+template <execution_policy Policy, typename Iter_t, typename T,
+          typename BinaryOp = std::plus<>>
+T reduce(Policy &&policy, Iter_t first, Iter_t last, T init,
+         BinaryOp op = {}) {
+  if constexpr (internal::runs_in_parallel_v<Policy, Iter_t>) {
+    auto *data = mystl::internal::unwrap_contiguous(first);
+    using elem_t = std::remove_pointer_t<decltype(data)>;
+    return internal::reduce_chunks<elem_t>(
+        policy.pool(), static_cast<std::size_t>(last - first),
+        std::move(init), op, [&](std::size_t begin, std::size_t end) {
+          return algo::reduce(data + begin + 1, data + end, T(data[begin]),
+                              op);
+        });
+  } else {
+    return algo::reduce(first, last, std::move(init), op);
+  }
+}
+
+template <execution_policy Policy, typename Iter_t, typename T,
+          typename BinaryOp, typename UnaryOp>
+T transform_reduce(Policy &&policy, Iter_t first, Iter_t last, T init,
+                   BinaryOp reduceOp, UnaryOp transformOp) {
+  if constexpr (internal::runs_in_parallel_v<Policy, Iter_t>) {
+    auto *data = mystl::internal::unwrap_contiguous(first);
+    using elem_t = std::remove_pointer_t<decltype(data)>;
+    return internal::reduce_chunks<elem_t>(
+        policy.pool(), static_cast<std::size_t>(last - first),
+        std::move(init), reduceOp, [&](std::size_t begin, std::size_t end) {
+          return algo::transform_reduce(data + begin + 1, data + end,
+                                        T(transformOp(data[begin])), reduceOp,
+                                        transformOp);
+        });
+  } else {
+    return algo::transform_reduce(first, last, std::move(init), reduceOp,
+                                  transformOp);
+  }
+}
+
+template <execution_policy Policy, typename Iter1_t, typename Iter2_t,
+          typename T, typename BinaryOp = std::plus<>,
+          typename BinaryTransform = std::multiplies<>>
+  requires requires(Iter2_t iter) { *iter; }
+T transform_reduce(Policy &&policy, Iter1_t first1, Iter1_t last1,
+                   Iter2_t first2, T init, BinaryOp reduceOp = {},
+                   BinaryTransform transformOp = {}) {
+  if constexpr (internal::runs_in_parallel_v<Policy, Iter1_t, Iter2_t>) {
+    auto *left = mystl::internal::unwrap_contiguous(first1);
+    auto *right = mystl::internal::unwrap_contiguous(first2);
+    using elem_t = std::remove_pointer_t<decltype(left)>;
+    return internal::reduce_chunks<elem_t>(
+        policy.pool(), static_cast<std::size_t>(last1 - first1),
+        std::move(init), reduceOp, [&](std::size_t begin, std::size_t end) {
+          return algo::transform_reduce(
+              left + begin + 1, left + end, right + begin + 1,
+              T(transformOp(left[begin], right[begin])), reduceOp,
+              transformOp);
+        });
+  } else {
+    return algo::transform_reduce(first1, last1, first2, std::move(init),
+                                  reduceOp, transformOp);
+  }
+}
+
+// Two passes over the chunks: one for their totals, then, after a serial
+// scan of those totals, one writing each chunk's running totals starting
+// from everything before it.
+template <execution_policy Policy, typename FromIter_t, typename ToIter_t,
+          typename BinaryOp = std::plus<>>
+ToIter_t inclusive_scan(Policy &&policy, FromIter_t first, FromIter_t last,
+                        ToIter_t dest, BinaryOp op = {}) {
+  if constexpr (internal::runs_in_parallel_v<Policy, FromIter_t, ToIter_t>) {
+    auto count = static_cast<std::size_t>(last - first);
+    auto *from = mystl::internal::unwrap_contiguous(first);
+    auto *to = mystl::internal::unwrap_contiguous(dest);
+    using elem_t = std::remove_pointer_t<decltype(from)>;
+    using value_t = std::remove_cv_t<elem_t>;
+
+    internal::chunking<elem_t> chunks(count);
+    ThreadPool &pool = policy.pool();
+    if (chunks.m_Chunks <= 1) {
+      return algo::inclusive_scan(first, last, dest, op);
+    }
+
+    // carries[c] is the total of every chunk before c.
+    Vector<std::optional<value_t>> carries(chunks.m_Chunks);
+    pool.parallel_for(chunks.m_Chunks - 1, [&](std::size_t chunk) {
+      std::size_t begin = chunks.begin(chunk);
+      std::size_t end = chunks.end(chunk);
+      carries[chunk + 1].emplace(
+          algo::reduce(from + begin + 1, from + end, value_t(from[begin]), op));
+    });
+    for (std::size_t chunk = 2; chunk < chunks.m_Chunks; ++chunk) {
+      carries[chunk] = op(*carries[chunk - 1], std::move(*carries[chunk]));
+    }
+
+    pool.parallel_for(chunks.m_Chunks, [&](std::size_t chunk) {
+      std::size_t begin = chunks.begin(chunk);
+      std::size_t end = chunks.end(chunk);
+      value_t total =
+          chunk == 0 ? value_t(from[begin]) : op(*carries[chunk], from[begin]);
+      to[begin] = total;
+      for (std::size_t i = begin + 1; i < end; ++i) {
+        total = op(std::move(total), from[i]);
+        to[i] = total;
+      }
+    });
+    return dest + count;
+  } else {
+    return algo::inclusive_scan(first, last, dest, op);
+  }
+}
+
+// Every chunk goes through the single-threaded fill/copy, so each one still
+// uses the memset/memmove/SIMD paths.
+template <execution_policy Policy, typename Iter_t, typename T>
+void fill(Policy &&policy, Iter_t first, Iter_t last, T const &value) {
+  if constexpr (internal::runs_in_parallel_v<Policy, Iter_t>) {
+    auto *data = mystl::internal::unwrap_contiguous(first);
+    using elem_t = std::remove_pointer_t<decltype(data)>;
+    internal::for_each_chunk<elem_t>(
+        policy.pool(), static_cast<std::size_t>(last - first),
+        [&](std::size_t begin, std::size_t end) {
+          algo::fill(data + begin, data + end, value);
+        });
+  } else {
+    algo::fill(first, last, value);
+  }
+}
+
+template <execution_policy Policy, typename FromIter_t, typename ToIter_t>
+void copy(Policy &&policy, FromIter_t first, FromIter_t last, ToIter_t dest) {
+  if constexpr (internal::runs_in_parallel_v<Policy, FromIter_t, ToIter_t>) {
+    auto *from = mystl::internal::unwrap_contiguous(first);
+    auto *to = mystl::internal::unwrap_contiguous(dest);
+    using elem_t = std::remove_pointer_t<decltype(from)>;
+    internal::for_each_chunk<elem_t>(
+        policy.pool(), static_cast<std::size_t>(last - first),
+        [&](std::size_t begin, std::size_t end) {
+          algo::copy(from + begin, from + end, to + begin);
+        });
+  } else {
+    algo::copy(first, last, dest);
+  }
+}
+
+} // namespace algo
+
+} // namespace mystl
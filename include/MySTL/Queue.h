@@ -1,17 +1,23 @@
 #pragma once
 
-#include "Vector.h"
+#include "RingBuffer.h"
+#include <concepts>
+#include <memory>
+#include <utility>
 
 namespace mystl {
 
-template <typename T, typename Container_t = Vector<T>>
+// First-in first-out adaptor. The container needs push_back() and
+// pop_front(); the default RingBuffer makes both O(1).
+template <typename T, typename Container_t = RingBuffer<T>>
 class Queue {
 public:
-  using value_type = typename Container_t::value_t;
-  using pointer = typename Container_t::pointer_t;
-  using const_pointer_t = typename Container_t::const_pointer_t;
-  using reference = typename Container_t::reference_t;
-  using const_reference = typename Container_t::reference_type;
+  using container_type = Container_t;
+  using value_type = typename Container_t::value_type;
+  using pointer = typename Container_t::pointer;
+  using const_pointer = typename Container_t::const_pointer;
+  using reference = typename Container_t::reference;
+  using const_reference = typename Container_t::const_reference;
   using size_type = typename Container_t::size_type;
 
   using iterator = typename Container_t::iterator;
@@ -23,6 +29,13 @@ public:
   constexpr explicit Queue(Container_t const &containter)
       : m_Underlying(containter) {}
 
+  // Builds the underlying container on the given allocator. Only allocators
+  // the container uses take part, so a Queue is not built from an int.
+  template <typename Allocator>
+    requires std::uses_allocator_v<Container_t, Allocator> &&
+             std::constructible_from<Container_t, Allocator const &>
+  constexpr explicit Queue(Allocator const &alloc) : m_Underlying(alloc) {}
+
   constexpr size_type size() const { return m_Underlying.size(); }
 
   constexpr bool empty() const { return m_Underlying.empty(); }
@@ -37,12 +50,12 @@ public:
 
   template <typename Self>
   constexpr auto &&front(this Self &&self) {
-    return std::forward<Self>(self).front();
+    return std::forward<Self>(self).m_Underlying.front();
   }
 
   template <typename Self>
   constexpr auto &&back(this Self &&self) {
-    return std::forward<Self>(self).back();
+    return std::forward<Self>(self).m_Underlying.back();
   }
 
   constexpr void push(T const &val) { m_Underlying.push_back(val); }
@@ -53,10 +66,17 @@ public:
     m_Underlying.emplace_back(std::forward<Args>(args)...);
   }
 
-  constexpr void pop() { m_Underlying.pop_back(); }
+  constexpr void pop() { m_Underlying.pop_front(); }
 
 private:
   Container_t m_Underlying;
 };
 
+namespace pmr {
+
+template <typename T, typename Container_t = pmr::RingBuffer<T>>
+using Queue = mystl::Queue<T, Container_t>;
+
+} // namespace pmr
+
 } // namespace mystl
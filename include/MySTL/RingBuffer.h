@@ -0,0 +1,320 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Iterator.h"
+#include "Memory.h"
+#include "MemoryResource.h"
+#include "MySTL/algorithms.h"
+#include <bit>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace mystl {
+
+// A double-ended queue in one contiguous buffer. The capacity is always a
+// power of two, so the element at logical index i lives at
+// (head + i) & (capacity - 1) and no push or pop ever moves other elements.
+// Growing unwraps the contents to the start of a new buffer.
+template <typename T, typename Allocator = mystl::Allocator<T>>
+class RingBuffer {
+public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = T const &;
+
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+
+  using allocator_type = Allocator;
+
+  using iterator = RingIterator<RingBuffer>;
+  using const_iterator = ConstRingIterator<RingBuffer>;
+
+public:
+  constexpr explicit RingBuffer() : RingBuffer(Allocator{}) {}
+
+  constexpr explicit RingBuffer(Allocator const &alloc)
+      : m_Allocator(alloc), m_Capacity(0), m_Head(0), m_Size(0),
+        m_Data(nullptr) {}
+
+  constexpr explicit RingBuffer(std::initializer_list<T> iList,
+                                Allocator const &alloc = Allocator{})
+      : RingBuffer(alloc) {
+    push_n(std::span<T const>{iList.begin(), iList.size()});
+  }
+
+  constexpr explicit RingBuffer(const RingBuffer &copy)
+      : RingBuffer(alloc_traits::select_on_container_copy_construction(
+            copy.m_Allocator)) {
+    copy_from(copy);
+  }
+
+  constexpr explicit RingBuffer(RingBuffer &&move)
+      : RingBuffer(std::move(move.m_Allocator)) {
+    steal(move);
+  }
+
+  constexpr ~RingBuffer() {
+    clear();
+    deallocate();
+  }
+
+  constexpr RingBuffer &operator=(const RingBuffer &copy) {
+    if (this != &copy) {
+      clear();
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                        value) {
+        deallocate();
+        m_Capacity = 0;
+        m_Data = nullptr;
+        m_Allocator = copy.m_Allocator;
+      }
+      copy_from(copy);
+    }
+    return *this;
+  }
+
+  constexpr RingBuffer &operator=(RingBuffer &&move) {
+    if (this != &move) {
+      clear();
+      if constexpr (!alloc_traits::propagate_on_container_move_assignment::
+                        value) {
+        // The buffer belongs to another resource, so move the elements.
+        if (!(m_Allocator == move.m_Allocator)) {
+          grow_to(move.m_Size);
+          move.unwrap_into(m_Data);
+          m_Size = move.m_Size;
+          move.m_Head = 0;
+          move.m_Size = 0;
+          return *this;
+        }
+      } else {
+        m_Allocator = std::move(move.m_Allocator);
+      }
+      deallocate();
+      steal(move);
+    }
+    return *this;
+  }
+
+  constexpr allocator_type get_allocator() const { return m_Allocator; }
+
+  constexpr size_type capacity() const { return m_Capacity; }
+
+  constexpr size_type size() const { return m_Size; }
+
+  constexpr bool empty() const { return (m_Size == 0); }
+
+  constexpr iterator begin() { return iterator{m_Data, mask(), m_Head}; }
+  constexpr const_iterator begin() const { return cbegin(); }
+  constexpr const_iterator cbegin() const {
+    return const_iterator{m_Data, mask(), m_Head};
+  }
+
+  constexpr iterator end() {
+    return iterator{m_Data, mask(), m_Head + m_Size};
+  }
+  constexpr const_iterator end() const { return cend(); }
+  constexpr const_iterator cend() const {
+    return const_iterator{m_Data, mask(), m_Head + m_Size};
+  }
+
+  // Rounds the capacity up to the next power of two.
+  constexpr void reserve(size_type capacity) { grow_to(capacity); }
+
+  constexpr void shrink_to_fit() {
+    size_type capacity = m_Size == 0 ? 0 : std::bit_ceil(m_Size);
+    if (capacity < m_Capacity) {
+      reallocate(capacity);
+    }
+  }
+
+  template <typename Self>
+  constexpr auto &&operator[](this Self &&self, size_type index) {
+    if (index >= self.m_Size) {
+      throw std::out_of_range("RingBuffer index out of range");
+    }
+    return std::forward<Self>(self).m_Data[(self.m_Head + index) & self.mask()];
+  }
+
+  template <typename Self>
+  constexpr auto &&front(this Self &&self) {
+    return std::forward<Self>(self)[0];
+  }
+
+  template <typename Self>
+  constexpr auto &&back(this Self &&self) {
+    return std::forward<Self>(self)[self.m_Size - 1];
+  }
+
+  // Modifiers
+
+  // Destroys the elements but keeps the buffer, so a drained queue does not
+  // allocate again when it refills.
+  constexpr void clear() {
+    size_type first = first_run(m_Head, m_Size);
+    destroy(m_Data + m_Head, m_Data + m_Head + first);
+    destroy(m_Data, m_Data + (m_Size - first));
+    m_Head = 0;
+    m_Size = 0;
+  }
+
+  constexpr void push_back(const T &val) { emplace_back(val); }
+
+  constexpr void push_back(T &&val) { emplace_back(std::move(val)); }
+
+  template <typename... Args>
+  constexpr void emplace_back(Args &&...args) {
+    grow_to(m_Size + 1);
+    new (m_Data + ((m_Head + m_Size) & mask())) T{std::forward<Args>(args)...};
+    m_Size++;
+  }
+
+  constexpr void push_front(const T &val) { emplace_front(val); }
+
+  constexpr void push_front(T &&val) { emplace_front(std::move(val)); }
+
+  template <typename... Args>
+  constexpr void emplace_front(Args &&...args) {
+    grow_to(m_Size + 1);
+    size_type head = (m_Head - 1) & mask();
+    new (m_Data + head) T{std::forward<Args>(args)...};
+    m_Head = head;
+    m_Size++;
+  }
+
+  constexpr void pop_front() {
+    if (m_Size <= 0) {
+      return;
+    }
+
+    m_Data[m_Head].~T();
+    m_Head = (m_Head + 1) & mask();
+    --m_Size;
+  }
+
+  constexpr void pop_back() {
+    if (m_Size <= 0) {
+      return;
+    }
+
+    m_Data[(m_Head + m_Size - 1) & mask()].~T();
+    --m_Size;
+  }
+
+  // Appends copies of `values` with at most two bulk copies, growing once.
+  constexpr void push_n(std::span<T const> values) {
+    size_type count = values.size();
+    grow_to(m_Size + count);
+
+    size_type tail = (m_Head + m_Size) & mask();
+    size_type first = first_run(tail, count);
+    uninitialized_copy_n(values.data(), first, m_Data + tail);
+    uninitialized_copy_n(values.data() + first, count - first, m_Data);
+    m_Size += count;
+  }
+
+  // Moves up to out.size() elements from the front into `out` and returns
+  // how many were taken.
+  constexpr size_type pop_n(std::span<T> out) {
+    size_type count = algo::min(out.size(), m_Size);
+
+    size_type first = first_run(m_Head, count);
+    relocate_assign(m_Data + m_Head, first, out.data());
+    relocate_assign(m_Data, count - first, out.data() + first);
+    m_Head = (m_Head + count) & mask();
+    m_Size -= count;
+    return count;
+  }
+
+private:
+  constexpr size_type mask() const { return m_Capacity - 1; }
+
+  // Number of the `count` slots starting at physical index `start` that lie
+  // before the end of the buffer; the rest wrap around to index 0.
+  constexpr size_type first_run(size_type start, size_type count) const {
+    return algo::min(count, m_Capacity - start);
+  }
+
+  // Relocates the elements, in order, to the start of the raw memory `dest`.
+  void unwrap_into(pointer dest) {
+    size_type first = first_run(m_Head, m_Size);
+    relocate(m_Data + m_Head, first, dest);
+    relocate(m_Data, m_Size - first, dest + first);
+  }
+
+  void copy_from(const RingBuffer &other) {
+    grow_to(other.m_Size);
+    size_type first = other.first_run(other.m_Head, other.m_Size);
+    uninitialized_copy_n(other.m_Data + other.m_Head, first, m_Data);
+    uninitialized_copy_n(other.m_Data, other.m_Size - first, m_Data + first);
+    m_Size = other.m_Size;
+  }
+
+  // Takes the buffer of `other`, which must use an equal allocator.
+  void steal(RingBuffer &other) {
+    m_Capacity = other.m_Capacity;
+    m_Head = other.m_Head;
+    m_Size = other.m_Size;
+    m_Data = other.m_Data;
+    other.m_Capacity = 0;
+    other.m_Head = 0;
+    other.m_Size = 0;
+    other.m_Data = nullptr;
+  }
+
+  void reallocate(size_type newCapacity) {
+    pointer newData = nullptr;
+    if (newCapacity != 0) {
+      newData = alloc_traits::allocate(m_Allocator, newCapacity);
+    }
+    unwrap_into(newData);
+
+    deallocate();
+    m_Data = newData;
+    m_Capacity = newCapacity;
+    m_Head = 0;
+  }
+
+  // Makes room for at least `required` elements; capacities are powers of
+  // two and at least m_MinCapacity.
+  void grow_to(size_type required) {
+    if (required > m_Capacity) {
+      reallocate(std::bit_ceil(algo::max(required, m_MinCapacity)));
+    }
+  }
+
+  void deallocate() {
+    // Deallocate does not attemp to set m_Capacity and m_Data to valid data
+    if (m_Data != nullptr) {
+      alloc_traits::deallocate(m_Allocator, m_Data, m_Capacity);
+    }
+  }
+
+private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  static constexpr size_type m_MinCapacity = 4;
+
+  [[no_unique_address]] Allocator m_Allocator;
+  size_type m_Capacity;
+  size_type m_Head;
+  size_type m_Size;
+  pointer m_Data;
+};
+
+namespace pmr {
+
+template <typename T>
+using RingBuffer = mystl::RingBuffer<T, PolymorphicAllocator<T>>;
+
+} // namespace pmr
+
+} // namespace mystl
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MYSTL_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace mystl {
+
+namespace internal {
+
+// Hand-written x86 kernels. SSE2 is part of x86-64, so it is the baseline;
+// AVX2 kernels are compiled for that target alone and picked at run time,
+// so one binary runs everywhere and uses the wider registers where they
+// exist. Elsewhere the callers fall back to portable loops.
+
+#if defined(MYSTL_X86_SIMD)
+
+inline bool cpu_has_sse42() {
+  static bool const hasSse42 = __builtin_cpu_supports("sse4.2");
+  return hasSse42;
+}
+
+inline bool cpu_has_avx2() {
+  static bool const hasAvx2 = __builtin_cpu_supports("avx2");
+  return hasAvx2;
+}
+
+// AVX-512 kernels use byte and word lanes too, so they need BW besides F.
+inline bool cpu_has_avx512() {
+  static bool const hasAvx512 = __builtin_cpu_supports("avx512f") &&
+                                __builtin_cpu_supports("avx512bw");
+  return hasAvx512;
+}
+
+// Past this size a fill would evict the whole cache, so the stores bypass
+// it (non-temporal) instead of reading every line in first.
+inline constexpr std::size_t streaming_fill_bytes = std::size_t{4} << 20;
+
+// Fills `bytes` bytes at `dest` by repeating the 32-byte `pattern`. Any
+// tail shorter than a vector is copied from the start of the pattern, so a
+// pattern of whole elements leaves whole elements.
+__attribute__((target("avx2"))) inline void
+fill_pattern_avx2(unsigned char *dest, std::size_t bytes,
+                  unsigned char const *pattern) {
+  __m256i value =
+      _mm256_loadu_si256(reinterpret_cast<__m256i const *>(pattern));
+  std::size_t i = 0;
+
+  if (bytes >= streaming_fill_bytes) {
+    // Head up to 32-byte alignment; the pattern is rotated to match.
+    std::size_t head = (32 - reinterpret_cast<std::uintptr_t>(dest) % 32) % 32;
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest), value);
+    unsigned char rotated[64];
+    std::memcpy(rotated, pattern, 32);
+    std::memcpy(rotated + 32, pattern, 32);
+    value =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const *>(rotated + head));
+    for (i = head; i + 32 <= bytes; i += 32) {
+      _mm256_stream_si256(reinterpret_cast<__m256i *>(dest + i), value);
+    }
+    _mm_sfence();
+    std::memcpy(dest + i, rotated + head, bytes - i);
+    return;
+  }
+
+  for (; i + 32 <= bytes; i += 32) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i), value);
+  }
+  std::memcpy(dest + i, pattern, bytes - i);
+}
+
+// The pattern spans two registers, stored alternately, so a 32-byte
+// element is not cut in half.
+inline void fill_pattern_sse2(unsigned char *dest, std::size_t bytes,
+                              unsigned char const *pattern) {
+  __m128i low = _mm_loadu_si128(reinterpret_cast<__m128i const *>(pattern));
+  __m128i high =
+      _mm_loadu_si128(reinterpret_cast<__m128i const *>(pattern + 16));
+  std::size_t i = 0;
+  for (; i + 32 <= bytes; i += 32) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), low);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i + 16), high);
+  }
+  if (i + 16 <= bytes) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), low);
+    i += 16;
+  }
+  std::memcpy(dest + i, pattern + i % 32, bytes - i);
+}
+
+#endif
+
+// Writes `count` copies of the `size`-byte object at `value` to `dest`.
+// `size` must divide 32.
+inline void fill_pattern(void *dest, std::size_t count, void const *value,
+                         std::size_t size) {
+  unsigned char pattern[32];
+  for (std::size_t i = 0; i < sizeof(pattern); i += size) {
+    std::memcpy(pattern + i, value, size);
+  }
+
+  auto *out = static_cast<unsigned char *>(dest);
+  std::size_t bytes = count * size;
+#if defined(MYSTL_X86_SIMD)
+  if (cpu_has_avx2()) {
+    fill_pattern_avx2(out, bytes, pattern);
+  } else {
+    fill_pattern_sse2(out, bytes, pattern);
+  }
+#else
+  std::size_t i = 0;
+  for (; i + sizeof(pattern) <= bytes; i += sizeof(pattern)) {
+    std::memcpy(out + i, pattern, sizeof(pattern));
+  }
+  std::memcpy(out + i, pattern, bytes - i);
+#endif
+}
+
+} // namespace internal
+
+} // namespace mystl
@@ -0,0 +1,995 @@
+#pragma once
+
+#include "Simd.h"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+namespace mystl {
+
+namespace internal {
+
+// Scans over arrays of integers, floats and doubles, behind find, count,
+// min_element/max_element and mismatch in algorithms.h. Each kernel comes
+// in SSE4.2, AVX2 and AVX-512 variants, compiled for that target alone and
+// picked at run time: the widest the CPU has that the array fills at least
+// once. Shorter arrays and other targets take the scalar loops.
+//
+// Kernels never read outside the array: the last vector is loaded so that
+// it ends with the array, overlapping elements that were already looked at.
+
+enum class simd_compare {
+  equal,
+  not_equal,
+  less,
+  less_equal,
+  greater,
+  greater_equal
+};
+
+// `element op value` for the std comparison objects; no member otherwise.
+template <typename Compare>
+struct simd_compare_of {};
+
+template <>
+struct simd_compare_of<std::equal_to<>> {
+  static constexpr simd_compare value = simd_compare::equal;
+};
+
+template <>
+struct simd_compare_of<std::not_equal_to<>> {
+  static constexpr simd_compare value = simd_compare::not_equal;
+};
+
+template <>
+struct simd_compare_of<std::less<>> {
+  static constexpr simd_compare value = simd_compare::less;
+};
+
+template <>
+struct simd_compare_of<std::less_equal<>> {
+  static constexpr simd_compare value = simd_compare::less_equal;
+};
+
+template <>
+struct simd_compare_of<std::greater<>> {
+  static constexpr simd_compare value = simd_compare::greater;
+};
+
+template <>
+struct simd_compare_of<std::greater_equal<>> {
+  static constexpr simd_compare value = simd_compare::greater_equal;
+};
+
+template <simd_compare Op, typename T>
+constexpr bool compare_scalar(T a, T b) {
+  if constexpr (Op == simd_compare::equal) {
+    return a == b;
+  } else if constexpr (Op == simd_compare::not_equal) {
+    return a != b;
+  } else if constexpr (Op == simd_compare::less) {
+    return a < b;
+  } else if constexpr (Op == simd_compare::less_equal) {
+    return a <= b;
+  } else if constexpr (Op == simd_compare::greater) {
+    return a > b;
+  } else {
+    return a >= b;
+  }
+}
+
+// Element types with vector compares, min and max (bool has no order
+// worth vectorising, long double no vector lanes).
+template <typename T>
+inline constexpr bool is_simd_searchable_v =
+    (std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8) ||
+    std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+// The signed integer of T's size, to broadcast T's bits with set1.
+template <typename T>
+using lane_int_t = std::conditional_t<
+    sizeof(T) == 1, std::int8_t,
+    std::conditional_t<sizeof(T) == 2, std::int16_t,
+                       std::conditional_t<sizeof(T) == 4, std::int32_t,
+                                          std::int64_t>>>;
+
+// Unsigned lanes XORed with this compare correctly as signed ones.
+template <typename T>
+inline constexpr T sign_bit = static_cast<T>(std::uint64_t{1}
+                                             << (8 * sizeof(T) - 1));
+
+// Folds the per-lane minima and maxima left by min_max_*.
+template <typename T>
+void reduce_min_max(T const *lows, T const *highs, std::size_t count, T &min,
+                    T &max) {
+  T low = lows[0];
+  T high = highs[0];
+  for (std::size_t i = 1; i < count; ++i) {
+    low = lows[i] < low ? lows[i] : low;
+    high = highs[i] > high ? highs[i] : high;
+  }
+  min = low;
+  max = high;
+}
+
+#if defined(MYSTL_X86_SIMD)
+
+#define MYSTL_TARGET_SSE42 __attribute__((target("sse4.2")))
+#define MYSTL_TARGET_AVX2 __attribute__((target("avx2")))
+#define MYSTL_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+
+// One vector of T for each instruction set. SSE and AVX2 compares yield
+// all-ones lanes, turned into masks with a bit per byte (`stride` bits per
+// lane); AVX-512 compares yield a bit per lane directly.
+
+template <typename T>
+struct sse42_lanes {
+  static constexpr std::size_t count = 16 / sizeof(T);
+  static constexpr int stride = sizeof(T);
+  static constexpr std::uint64_t all = 0xffff;
+
+  MYSTL_TARGET_SSE42 static __m128i load(T const *data) {
+    return _mm_loadu_si128(reinterpret_cast<__m128i const *>(data));
+  }
+
+  MYSTL_TARGET_SSE42 static void store(T *out, __m128i lanes) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), lanes);
+  }
+
+  MYSTL_TARGET_SSE42 static __m128i broadcast(T value) {
+    auto bits = std::bit_cast<lane_int_t<T>>(value);
+    if constexpr (sizeof(T) == 1) {
+      return _mm_set1_epi8(bits);
+    } else if constexpr (sizeof(T) == 2) {
+      return _mm_set1_epi16(bits);
+    } else if constexpr (sizeof(T) == 4) {
+      return _mm_set1_epi32(bits);
+    } else {
+      return _mm_set1_epi64x(bits);
+    }
+  }
+
+  MYSTL_TARGET_SSE42 static std::uint64_t bits(__m128i lanes) {
+    return static_cast<std::uint16_t>(_mm_movemask_epi8(lanes));
+  }
+
+  MYSTL_TARGET_SSE42 static __m128i equal(__m128i a, __m128i b) {
+    if constexpr (std::is_same_v<T, float>) {
+      return _mm_castps_si128(
+          _mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+    } else if constexpr (std::is_same_v<T, double>) {
+      return _mm_castpd_si128(
+          _mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+    } else if constexpr (sizeof(T) == 1) {
+      return _mm_cmpeq_epi8(a, b);
+    } else if constexpr (sizeof(T) == 2) {
+      return _mm_cmpeq_epi16(a, b);
+    } else if constexpr (sizeof(T) == 4) {
+      return _mm_cmpeq_epi32(a, b);
+    } else {
+      return _mm_cmpeq_epi64(a, b);
+    }
+  }
+
+  MYSTL_TARGET_SSE42 static __m128i greater(__m128i a, __m128i b) {
+    if constexpr (std::is_same_v<T, float>) {
+      return _mm_castps_si128(
+          _mm_cmpgt_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+    } else if constexpr (std::is_same_v<T, double>) {
+      return _mm_castpd_si128(
+          _mm_cmpgt_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+    } else {
+      if constexpr (std::is_unsigned_v<T>) {
+        __m128i flip = broadcast(sign_bit<T>);
+        a = _mm_xor_si128(a, flip);
+        b = _mm_xor_si128(b, flip);
+      }
+      if constexpr (sizeof(T) == 1) {
+        return _mm_cmpgt_epi8(a, b);
+      } else if constexpr (sizeof(T) == 2) {
+        return _mm_cmpgt_epi16(a, b);
+      } else if constexpr (sizeof(T) == 4) {
+        return _mm_cmpgt_epi32(a, b);
+      } else {
+        return _mm_cmpgt_epi64(a, b);
+      }
+    }
+  }
+
+  // Not simply !(b > a): that would hold for NaNs.
+  MYSTL_TARGET_SSE42 static __m128i greater_equal(__m128i a, __m128i b) {
+    if constexpr (std::is_same_v<T, float>) {
+      return _mm_castps_si128(
+          _mm_cmpge_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+    } else if constexpr (std::is_same_v<T, double>) {
+      return _mm_castpd_si128(
+          _mm_cmpge_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+    } else {
+      return _mm_xor_si128(greater(b, a), _mm_set1_epi32(-1));
+    }
+  }
+
+  template <simd_compare Op>
+  MYSTL_TARGET_SSE42 static std::uint64_t compare(__m128i a, __m128i b) {
+    if constexpr (Op == simd_compare::equal) {
+      return bits(equal(a, b));
+    } else if constexpr (Op == simd_compare::not_equal) {
+      return bits(equal(a, b)) ^ all;
+    } else if constexpr (Op == simd_compare::less) {
+      return bits(greater(b, a));
+    } else if constexpr (Op == simd_compare::less_equal) {
+      return bits(greater_equal(b, a));
+    } else if constexpr (Op == simd_compare::greater) {
+      return bits(greater(a, b));
+    } else {
+      return bits(greater_equal(a, b));
+    }
+  }
+
+  MYSTL_TARGET_SSE42 static __m128i min(__m128i a, __m128i b) {
+    if constexpr (std::is_same_v<T, float>) {
+      return _mm_castps_si128(
+          _mm_min_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+    } else if constexpr (std::is_same_v<T, double>) {
+      return _mm_castpd_si128(
+          _mm_min_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+    } else if constexpr (sizeof(T) == 1) {
+      return std::is_signed_v<T> ? _mm_min_epi8(a, b) : _mm_min_epu8(a, b);
+    } else if constexpr (sizeof(T) == 2) {
+      return std::is_signed_v<T> ? _mm_min_epi16(a, b) : _mm_min_epu16(a, b);
+    } else if constexpr (sizeof(T) == 4) {
+      return std::is_signed_v<T> ? _mm_min_epi32(a, b) : _mm_min_epu32(a, b);
+    } else {
+      return _mm_blendv_epi8(a, b, greater(a, b));
+    }
+  }
+
+  MYSTL_TARGET_SSE42 static __m128i max(__m128i a, __m128i b) {
+    if constexpr (std::is_same_v<T, float>) {
+      return _mm_castps_si128(
+          _mm_max_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+    } else if constexpr (std::is_same_v<T, double>) {
+      return _mm_castpd_si128(
+          _mm_max_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+    } else if constexpr (sizeof(T) == 1) {
+      return std::is_signed_v<T> ? _mm_max_epi8(a, b) : _mm_max_epu8(a, b);
+    } else if constexpr (sizeof(T) == 2) {
+      return std::is_signed_v<T> ? _mm_max_epi16(a, b) : _mm_max_epu16(a, b);
+    } else if constexpr (sizeof(T) == 4) {
+      return std::is_signed_v<T> ? _mm_max_epi32(a, b) : _mm_max_epu32(a, b);
+    } else {
+      return _mm_blendv_epi8(a, b, greater(b, a));
+    }
+  }
+
+  // Lanes holding a NaN.
+  MYSTL_TARGET_SSE42 static std::uint64_t unordered(__m128i lanes) {
+    if constexpr (std::is_same_v<T, float>) {
+      __m128 values = _mm_castsi128_ps(lanes);
+      return bits(_mm_castps_si128(_mm_cmpunord_ps(values, values)));
+    } else if constexpr (std::is_same_v<T, double>) {
+      __m128d values = _mm_castsi128_pd(lanes);
+      return bits(_mm_castpd_si128(_mm_cmpunord_pd(values, values)));
+    } else {
+      return 0;
+    }
+  }
+};
+
+template <typename T>
+struct avx2_lanes {
+  static constexpr std::size_t count = 32 / sizeof(T);
+  static constexpr int stride = sizeof(T);
+  static constexpr std::uint64_t all = 0xffffffff;
+
+  MYSTL_TARGET_AVX2 static __m256i load(T const *data) {
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data));
+  }
+
+  MYSTL_TARGET_AVX2 static void store(T *out, __m256i lanes) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), lanes);
+  }
+
+  MYSTL_TARGET_AVX2 static __m256i broadcast(T value) {
+    auto bits = std::bit_cast<lane_int_t<T>>(value);
+    if constexpr (sizeof(T) == 1) {
+      return _mm256_set1_epi8(bits);
+    } else if constexpr (sizeof(T) == 2) {
+      return _mm256_set1_epi16(bits);
+    } else if constexpr (sizeof(T) == 4) {
+      return _mm256_set1_epi32(bits);
+    } else {
+      return _mm256_set1_epi64x(bits);
+    }
+  }
+
+  MYSTL_TARGET_AVX2 static std::uint64_t bits(__m256i lanes) {
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(lanes));
+  }
+
+  template <int Predicate>
+  MYSTL_TARGET_AVX2 static __m256i compare_floats(__m256i a, __m256i b) {
+    if constexpr (std::is_same_v<T, float>) {
+      return _mm256_castps_si256(_mm256_cmp_ps(
+          _mm256_castsi256_ps(a), _mm256_castsi256_ps(b), Predicate));
+    } else {
+      return _mm256_castpd_si256(_mm256_cmp_pd(
+          _mm256_castsi256_pd(a), _mm256_castsi256_pd(b), Predicate));
+    }
+  }
+
+  MYSTL_TARGET_AVX2 static __m256i equal(__m256i a, __m256i b) {
+    if constexpr (std::is_floating_point_v<T>) {
+      return compare_floats<_CMP_EQ_OQ>(a, b);
+    } else if constexpr (sizeof(T) == 1) {
+      return _mm256_cmpeq_epi8(a, b);
+    } else if constexpr (sizeof(T) == 2) {
+      return _mm256_cmpeq_epi16(a, b);
+    } else if constexpr (sizeof(T) == 4) {
+      return _mm256_cmpeq_epi32(a, b);
+    } else {
+      return _mm256_cmpeq_epi64(a, b);
+    }
+  }
+
+  MYSTL_TARGET_AVX2 static __m256i greater(__m256i a, __m256i b) {
+    if constexpr (std::is_floating_point_v<T>) {
+      return compare_floats<_CMP_GT_OQ>(a, b);
+    } else {
+      if constexpr (std::is_unsigned_v<T>) {
+        __m256i flip = broadcast(sign_bit<T>);
+        a = _mm256_xor_si256(a, flip);
+        b = _mm256_xor_si256(b, flip);
+      }
+      if constexpr (sizeof(T) == 1) {
+        return _mm256_cmpgt_epi8(a, b);
+      } else if constexpr (sizeof(T) == 2) {
+        return _mm256_cmpgt_epi16(a, b);
+      } else if constexpr (sizeof(T) == 4) {
+        return _mm256_cmpgt_epi32(a, b);
+      } else {
+        return _mm256_cmpgt_epi64(a, b);
+      }
+    }
+  }
+
+  MYSTL_TARGET_AVX2 static __m256i greater_equal(__m256i a, __m256i b) {
+    if constexpr (std::is_floating_point_v<T>) {
+      return compare_floats<_CMP_GE_OQ>(a, b);
+    } else {
+      return _mm256_xor_si256(greater(b, a), _mm256_set1_epi32(-1));
+    }
+  }
+
+  template <simd_compare Op>
+  MYSTL_TARGET_AVX2 static std::uint64_t compare(__m256i a, __m256i b) {
+    if constexpr (Op == simd_compare::equal) {
+      return bits(equal(a, b));
+    } else if constexpr (Op == simd_compare::not_equal) {
+      return bits(equal(a, b)) ^ all;
+    } else if constexpr (Op == simd_compare::less) {
+      return bits(greater(b, a));
+    } else if constexpr (Op == simd_compare::less_equal) {
+      return bits(greater_equal(b, a));
+    } else if constexpr (Op == simd_compare::greater) {
+      return bits(greater(a, b));
+    } else {
+      return bits(greater_equal(a, b));
+    }
+  }
+
+  MYSTL_TARGET_AVX2 static __m256i min(__m256i a, __m256i b) {
+    if constexpr (std::is_same_v<T, float>) {
+      return _mm256_castps_si256(
+          _mm256_min_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+    } else if constexpr (std::is_same_v<T, double>) {
+      return _mm256_castpd_si256(
+          _mm256_min_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+    } else if constexpr (sizeof(T) == 1) {
+      return std::is_signed_v<T> ? _mm256_min_epi8(a, b)
+                                 : _mm256_min_epu8(a, b);
+    } else if constexpr (sizeof(T) == 2) {
+      return std::is_signed_v<T> ? _mm256_min_epi16(a, b)
+                                 : _mm256_min_epu16(a, b);
+    } else if constexpr (sizeof(T) == 4) {
+      return std::is_signed_v<T> ? _mm256_min_epi32(a, b)
+                                 : _mm256_min_epu32(a, b);
+    } else {
+      return _mm256_blendv_epi8(a, b, greater(a, b));
+    }
+  }
+
+  MYSTL_TARGET_AVX2 static __m256i max(__m256i a, __m256i b) {
+    if constexpr (std::is_same_v<T, float>) {
+      return _mm256_castps_si256(
+          _mm256_max_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+    } else if constexpr (std::is_same_v<T, double>) {
+      return _mm256_castpd_si256(
+          _mm256_max_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+    } else if constexpr (sizeof(T) == 1) {
+      return std::is_signed_v<T> ? _mm256_max_epi8(a, b)
+                                 : _mm256_max_epu8(a, b);
+    } else if constexpr (sizeof(T) == 2) {
+      return std::is_signed_v<T> ? _mm256_max_epi16(a, b)
+                                 : _mm256_max_epu16(a, b);
+    } else if constexpr (sizeof(T) == 4) {
+      return std::is_signed_v<T> ? _mm256_max_epi32(a, b)
+                                 : _mm256_max_epu32(a, b);
+    } else {
+      return _mm256_blendv_epi8(a, b, greater(b, a));
+    }
+  }
+
+  MYSTL_TARGET_AVX2 static std::uint64_t unordered(__m256i lanes) {
+    if constexpr (std::is_floating_point_v<T>) {
+      return bits(compare_floats<_CMP_UNORD_Q>(lanes, lanes));
+    } else {
+      return 0;
+    }
+  }
+};
+
+// Immediates of the AVX-512 compares, which take the predicate instead of
+// having an instruction per comparison.
+constexpr int avx512_int_predicate(simd_compare op) {
+  switch (op) {
+  case simd_compare::equal: return _MM_CMPINT_EQ;
+  case simd_compare::not_equal: return _MM_CMPINT_NE;
+  case simd_compare::less: return _MM_CMPINT_LT;
+  case simd_compare::less_equal: return _MM_CMPINT_LE;
+  case simd_compare::greater: return _MM_CMPINT_NLE;
+  default: return _MM_CMPINT_NLT;
+  }
+}
+
+// Ordered and quiet, as the C++ operators are; != is true for NaNs.
+constexpr int avx512_float_predicate(simd_compare op) {
+  switch (op) {
+  case simd_compare::equal: return _CMP_EQ_OQ;
+  case simd_compare::not_equal: return _CMP_NEQ_UQ;
+  case simd_compare::less: return _CMP_LT_OQ;
+  case simd_compare::less_equal: return _CMP_LE_OQ;
+  case simd_compare::greater: return _CMP_GT_OQ;
+  default: return _CMP_GE_OQ;
+  }
+}
+
+template <typename T>
+struct avx512_lanes {
+  static constexpr std::size_t count = 64 / sizeof(T);
+  static constexpr int stride = 1;
+  static constexpr std::uint64_t all =
+      count == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << count) - 1;
+
+  MYSTL_TARGET_AVX512 static __m512i load(T const *data) {
+    return _mm512_loadu_si512(data);
+  }
+
+  MYSTL_TARGET_AVX512 static void store(T *out, __m512i lanes) {
+    _mm512_storeu_si512(out, lanes);
+  }
+
+  MYSTL_TARGET_AVX512 static __m512i broadcast(T value) {
+    auto bits = std::bit_cast<lane_int_t<T>>(value);
+    if constexpr (sizeof(T) == 1) {
+      return _mm512_set1_epi8(bits);
+    } else if constexpr (sizeof(T) == 2) {
+      return _mm512_set1_epi16(bits);
+    } else if constexpr (sizeof(T) == 4) {
+      return _mm512_set1_epi32(bits);
+    } else {
+      return _mm512_set1_epi64(bits);
+    }
+  }
+
+  template <simd_compare Op>
+  MYSTL_TARGET_AVX512 static std::uint64_t compare(__m512i a, __m512i b) {
+    constexpr int floats = avx512_float_predicate(Op);
+    constexpr int ints = avx512_int_predicate(Op);
+    constexpr bool isSigned = std::is_signed_v<T>;
+    if constexpr (std::is_same_v<T, float>) {
+      return _mm512_cmp_ps_mask(_mm512_castsi512_ps(a),
+                                _mm512_castsi512_ps(b), floats);
+    } else if constexpr (std::is_same_v<T, double>) {
+      return _mm512_cmp_pd_mask(_mm512_castsi512_pd(a),
+                                _mm512_castsi512_pd(b), floats);
+    } else if constexpr (sizeof(T) == 1) {
+      return isSigned ? _mm512_cmp_epi8_mask(a, b, ints)
+                      : _mm512_cmp_epu8_mask(a, b, ints);
+    } else if constexpr (sizeof(T) == 2) {
+      return isSigned ? _mm512_cmp_epi16_mask(a, b, ints)
+                      : _mm512_cmp_epu16_mask(a, b, ints);
+    } else if constexpr (sizeof(T) == 4) {
+      return isSigned ? _mm512_cmp_epi32_mask(a, b, ints)
+                      : _mm512_cmp_epu32_mask(a, b, ints);
+    } else {
+      return isSigned ? _mm512_cmp_epi64_mask(a, b, ints)
+                      : _mm512_cmp_epu64_mask(a, b, ints);
+    }
+  }
+
+  MYSTL_TARGET_AVX512 static __m512i min(__m512i a, __m512i b) {
+    if constexpr (std::is_same_v<T, float>) {
+      return _mm512_castps_si512(
+          _mm512_min_ps(_mm512_castsi512_ps(a), _mm512_castsi512_ps(b)));
+    } else if constexpr (std::is_same_v<T, double>) {
+      return _mm512_castpd_si512(
+          _mm512_min_pd(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b)));
+    } else if constexpr (sizeof(T) == 1) {
+      return std::is_signed_v<T> ? _mm512_min_epi8(a, b)
+                                 : _mm512_min_epu8(a, b);
+    } else if constexpr (sizeof(T) == 2) {
+      return std::is_signed_v<T> ? _mm512_min_epi16(a, b)
+                                 : _mm512_min_epu16(a, b);
+    } else if constexpr (sizeof(T) == 4) {
+      return std::is_signed_v<T> ? _mm512_min_epi32(a, b)
+                                 : _mm512_min_epu32(a, b);
+    } else {
+      return std::is_signed_v<T> ? _mm512_min_epi64(a, b)
+                                 : _mm512_min_epu64(a, b);
+    }
+  }
+
+  MYSTL_TARGET_AVX512 static __m512i max(__m512i a, __m512i b) {
+    if constexpr (std::is_same_v<T, float>) {
+      return _mm512_castps_si512(
+          _mm512_max_ps(_mm512_castsi512_ps(a), _mm512_castsi512_ps(b)));
+    } else if constexpr (std::is_same_v<T, double>) {
+      return _mm512_castpd_si512(
+          _mm512_max_pd(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b)));
+    } else if constexpr (sizeof(T) == 1) {
+      return std::is_signed_v<T> ? _mm512_max_epi8(a, b)
+                                 : _mm512_max_epu8(a, b);
+    } else if constexpr (sizeof(T) == 2) {
+      return std::is_signed_v<T> ? _mm512_max_epi16(a, b)
+                                 : _mm512_max_epu16(a, b);
+    } else if constexpr (sizeof(T) == 4) {
+      return std::is_signed_v<T> ? _mm512_max_epi32(a, b)
+                                 : _mm512_max_epu32(a, b);
+    } else {
+      return std::is_signed_v<T> ? _mm512_max_epi64(a, b)
+                                 : _mm512_max_epu64(a, b);
+    }
+  }
+
+  MYSTL_TARGET_AVX512 static std::uint64_t unordered(__m512i lanes) {
+    if constexpr (std::is_same_v<T, float>) {
+      __m512 values = _mm512_castsi512_ps(lanes);
+      return _mm512_cmp_ps_mask(values, values, _CMP_UNORD_Q);
+    } else if constexpr (std::is_same_v<T, double>) {
+      __m512d values = _mm512_castsi512_pd(lanes);
+      return _mm512_cmp_pd_mask(values, values, _CMP_UNORD_Q);
+    } else {
+      return 0;
+    }
+  }
+};
+
+// The kernels, once per instruction set. All of them need
+// size >= Lanes::count.
+
+// Index of the first element `e` with `e Op value`, or size.
+template <simd_compare Op, typename T>
+MYSTL_TARGET_SSE42 std::size_t find_first_sse42(T const *data,
+                                                std::size_t size, T value) {
+  using lanes = sse42_lanes<T>;
+  __m128i needle = lanes::broadcast(value);
+  for (std::size_t i = 0;; i += lanes::count) {
+    bool last = i + lanes::count >= size;
+    i = last ? size - lanes::count : i;
+    auto bits = lanes::template compare<Op>(lanes::load(data + i), needle);
+    if (bits != 0) {
+      return i + std::countr_zero(bits) / lanes::stride;
+    }
+    if (last) {
+      return size;
+    }
+  }
+}
+
+// Index of the last element `e` with `e Op value`, or size.
+template <simd_compare Op, typename T>
+MYSTL_TARGET_SSE42 std::size_t find_last_sse42(T const *data,
+                                               std::size_t size, T value) {
+  using lanes = sse42_lanes<T>;
+  __m128i needle = lanes::broadcast(value);
+  for (std::size_t end = size;; end -= lanes::count) {
+    bool last = end <= lanes::count;
+    std::size_t i = last ? 0 : end - lanes::count;
+    auto bits = lanes::template compare<Op>(lanes::load(data + i), needle);
+    if (bits != 0) {
+      return i + (63 - std::countl_zero(bits)) / lanes::stride;
+    }
+    if (last) {
+      return size;
+    }
+  }
+}
+
+// Number of elements `e` with `e Op value`.
+template <simd_compare Op, typename T>
+MYSTL_TARGET_SSE42 std::size_t count_sse42(T const *data, std::size_t size,
+                                           T value) {
+  using lanes = sse42_lanes<T>;
+  __m128i needle = lanes::broadcast(value);
+  std::size_t bitCount = 0;
+  std::size_t i = 0;
+  for (; i + lanes::count < size; i += lanes::count) {
+    bitCount += std::popcount(
+        lanes::template compare<Op>(lanes::load(data + i), needle));
+  }
+  // The lanes of the last vector before i were counted already.
+  std::size_t start = size - lanes::count;
+  auto bits = lanes::template compare<Op>(lanes::load(data + start), needle);
+  bitCount += std::popcount(bits >> ((i - start) * lanes::stride));
+  return bitCount / lanes::stride;
+}
+
+// Smallest and largest element, or false if there is a NaN, which orders
+// against nothing.
+template <typename T>
+MYSTL_TARGET_SSE42 bool min_max_sse42(T const *data, std::size_t size,
+                                      T &min, T &max) {
+  using lanes = sse42_lanes<T>;
+  __m128i low = lanes::load(data);
+  __m128i high = low;
+  std::uint64_t nans = lanes::unordered(low);
+  std::size_t i = lanes::count;
+  for (;; i += lanes::count) {
+    if (i + lanes::count > size) {
+      if (i == size) {
+        break;
+      }
+      i = size - lanes::count;
+    }
+    __m128i values = lanes::load(data + i);
+    low = lanes::min(low, values);
+    high = lanes::max(high, values);
+    nans |= lanes::unordered(values);
+  }
+  if (nans != 0) {
+    return false;
+  }
+  T lows[lanes::count];
+  T highs[lanes::count];
+  lanes::store(lows, low);
+  lanes::store(highs, high);
+  reduce_min_max(lows, highs, lanes::count, min, max);
+  return true;
+}
+
+// Index of the first i with !(a[i] == b[i]), or size.
+template <typename T>
+MYSTL_TARGET_SSE42 std::size_t mismatch_sse42(T const *a, T const *b,
+                                              std::size_t size) {
+  using lanes = sse42_lanes<T>;
+  for (std::size_t i = 0;; i += lanes::count) {
+    bool last = i + lanes::count >= size;
+    i = last ? size - lanes::count : i;
+    auto bits = lanes::template compare<simd_compare::not_equal>(
+        lanes::load(a + i), lanes::load(b + i));
+    if (bits != 0) {
+      return i + std::countr_zero(bits) / lanes::stride;
+    }
+    if (last) {
+      return size;
+    }
+  }
+}
+
+template <simd_compare Op, typename T>
+MYSTL_TARGET_AVX2 std::size_t find_first_avx2(T const *data, std::size_t size,
+                                              T value) {
+  using lanes = avx2_lanes<T>;
+  __m256i needle = lanes::broadcast(value);
+  for (std::size_t i = 0;; i += lanes::count) {
+    bool last = i + lanes::count >= size;
+    i = last ? size - lanes::count : i;
+    auto bits = lanes::template compare<Op>(lanes::load(data + i), needle);
+    if (bits != 0) {
+      return i + std::countr_zero(bits) / lanes::stride;
+    }
+    if (last) {
+      return size;
+    }
+  }
+}
+
+template <simd_compare Op, typename T>
+MYSTL_TARGET_AVX2 std::size_t find_last_avx2(T const *data, std::size_t size,
+                                             T value) {
+  using lanes = avx2_lanes<T>;
+  __m256i needle = lanes::broadcast(value);
+  for (std::size_t end = size;; end -= lanes::count) {
+    bool last = end <= lanes::count;
+    std::size_t i = last ? 0 : end - lanes::count;
+    auto bits = lanes::template compare<Op>(lanes::load(data + i), needle);
+    if (bits != 0) {
+      return i + (63 - std::countl_zero(bits)) / lanes::stride;
+    }
+    if (last) {
+      return size;
+    }
+  }
+}
+
+template <simd_compare Op, typename T>
+MYSTL_TARGET_AVX2 std::size_t count_avx2(T const *data, std::size_t size,
+                                         T value) {
+  using lanes = avx2_lanes<T>;
+  __m256i needle = lanes::broadcast(value);
+  std::size_t bitCount = 0;
+  std::size_t i = 0;
+  for (; i + lanes::count < size; i += lanes::count) {
+    bitCount += std::popcount(
+        lanes::template compare<Op>(lanes::load(data + i), needle));
+  }
+  std::size_t start = size - lanes::count;
+  auto bits = lanes::template compare<Op>(lanes::load(data + start), needle);
+  bitCount += std::popcount(bits >> ((i - start) * lanes::stride));
+  return bitCount / lanes::stride;
+}
+
+template <typename T>
+MYSTL_TARGET_AVX2 bool min_max_avx2(T const *data, std::size_t size, T &min,
+                                    T &max) {
+  using lanes = avx2_lanes<T>;
+  __m256i low = lanes::load(data);
+  __m256i high = low;
+  std::uint64_t nans = lanes::unordered(low);
+  std::size_t i = lanes::count;
+  for (;; i += lanes::count) {
+    if (i + lanes::count > size) {
+      if (i == size) {
+        break;
+      }
+      i = size - lanes::count;
+    }
+    __m256i values = lanes::load(data + i);
+    low = lanes::min(low, values);
+    high = lanes::max(high, values);
+    nans |= lanes::unordered(values);
+  }
+  if (nans != 0) {
+    return false;
+  }
+  T lows[lanes::count];
+  T highs[lanes::count];
+  lanes::store(lows, low);
+  lanes::store(highs, high);
+  reduce_min_max(lows, highs, lanes::count, min, max);
+  return true;
+}
+
+template <typename T>
+MYSTL_TARGET_AVX2 std::size_t mismatch_avx2(T const *a, T const *b,
+                                            std::size_t size) {
+  using lanes = avx2_lanes<T>;
+  for (std::size_t i = 0;; i += lanes::count) {
+    bool last = i + lanes::count >= size;
+    i = last ? size - lanes::count : i;
+    auto bits = lanes::template compare<simd_compare::not_equal>(
+        lanes::load(a + i), lanes::load(b + i));
+    if (bits != 0) {
+      return i + std::countr_zero(bits) / lanes::stride;
+    }
+    if (last) {
+      return size;
+    }
+  }
+}
+
+template <simd_compare Op, typename T>
+MYSTL_TARGET_AVX512 std::size_t find_first_avx512(T const *data,
+                                                  std::size_t size, T value) {
+  using lanes = avx512_lanes<T>;
+  __m512i needle = lanes::broadcast(value);
+  for (std::size_t i = 0;; i += lanes::count) {
+    bool last = i + lanes::count >= size;
+    i = last ? size - lanes::count : i;
+    auto bits = lanes::template compare<Op>(lanes::load(data + i), needle);
+    if (bits != 0) {
+      return i + std::countr_zero(bits);
+    }
+    if (last) {
+      return size;
+    }
+  }
+}
+
+template <simd_compare Op, typename T>
+MYSTL_TARGET_AVX512 std::size_t find_last_avx512(T const *data,
+                                                 std::size_t size, T value) {
+  using lanes = avx512_lanes<T>;
+  __m512i needle = lanes::broadcast(value);
+  for (std::size_t end = size;; end -= lanes::count) {
+    bool last = end <= lanes::count;
+    std::size_t i = last ? 0 : end - lanes::count;
+    auto bits = lanes::template compare<Op>(lanes::load(data + i), needle);
+    if (bits != 0) {
+      return i + (63 - std::countl_zero(bits));
+    }
+    if (last) {
+      return size;
+    }
+  }
+}
+
+template <simd_compare Op, typename T>
+MYSTL_TARGET_AVX512 std::size_t count_avx512(T const *data, std::size_t size,
+                                             T value) {
+  using lanes = avx512_lanes<T>;
+  __m512i needle = lanes::broadcast(value);
+  std::size_t total = 0;
+  std::size_t i = 0;
+  for (; i + lanes::count < size; i += lanes::count) {
+    total += std::popcount(
+        lanes::template compare<Op>(lanes::load(data + i), needle));
+  }
+  std::size_t start = size - lanes::count;
+  auto bits = lanes::template compare<Op>(lanes::load(data + start), needle);
+  return total + std::popcount(bits >> (i - start));
+}
+
+template <typename T>
+MYSTL_TARGET_AVX512 bool min_max_avx512(T const *data, std::size_t size,
+                                        T &min, T &max) {
+  using lanes = avx512_lanes<T>;
+  __m512i low = lanes::load(data);
+  __m512i high = low;
+  std::uint64_t nans = lanes::unordered(low);
+  std::size_t i = lanes::count;
+  for (;; i += lanes::count) {
+    if (i + lanes::count > size) {
+      if (i == size) {
+        break;
+      }
+      i = size - lanes::count;
+    }
+    __m512i values = lanes::load(data + i);
+    low = lanes::min(low, values);
+    high = lanes::max(high, values);
+    nans |= lanes::unordered(values);
+  }
+  if (nans != 0) {
+    return false;
+  }
+  T lows[lanes::count];
+  T highs[lanes::count];
+  lanes::store(lows, low);
+  lanes::store(highs, high);
+  reduce_min_max(lows, highs, lanes::count, min, max);
+  return true;
+}
+
+template <typename T>
+MYSTL_TARGET_AVX512 std::size_t mismatch_avx512(T const *a, T const *b,
+                                                std::size_t size) {
+  using lanes = avx512_lanes<T>;
+  for (std::size_t i = 0;; i += lanes::count) {
+    bool last = i + lanes::count >= size;
+    i = last ? size - lanes::count : i;
+    auto bits = lanes::template compare<simd_compare::not_equal>(
+        lanes::load(a + i), lanes::load(b + i));
+    if (bits != 0) {
+      return i + std::countr_zero(bits);
+    }
+    if (last) {
+      return size;
+    }
+  }
+}
+
+#endif
+
+// The entry points: the widest kernel that fits, else a scalar loop.
+
+template <simd_compare Op, typename T>
+std::size_t simd_find(T const *data, std::size_t size, T value) {
+#if defined(MYSTL_X86_SIMD)
+  if (size >= avx512_lanes<T>::count && cpu_has_avx512()) {
+    return find_first_avx512<Op>(data, size, value);
+  }
+  if (size >= avx2_lanes<T>::count && cpu_has_avx2()) {
+    return find_first_avx2<Op>(data, size, value);
+  }
+  if (size >= sse42_lanes<T>::count && cpu_has_sse42()) {
+    return find_first_sse42<Op>(data, size, value);
+  }
+#endif
+  for (std::size_t i = 0; i < size; ++i) {
+    if (compare_scalar<Op>(data[i], value)) {
+      return i;
+    }
+  }
+  return size;
+}
+
+template <simd_compare Op, typename T>
+std::size_t simd_find_last(T const *data, std::size_t size, T value) {
+#if defined(MYSTL_X86_SIMD)
+  if (size >= avx512_lanes<T>::count && cpu_has_avx512()) {
+    return find_last_avx512<Op>(data, size, value);
+  }
+  if (size >= avx2_lanes<T>::count && cpu_has_avx2()) {
+    return find_last_avx2<Op>(data, size, value);
+  }
+  if (size >= sse42_lanes<T>::count && cpu_has_sse42()) {
+    return find_last_sse42<Op>(data, size, value);
+  }
+#endif
+  for (std::size_t i = size; i != 0; --i) {
+    if (compare_scalar<Op>(data[i - 1], value)) {
+      return i - 1;
+    }
+  }
+  return size;
+}
+
+template <simd_compare Op, typename T>
+std::size_t simd_count(T const *data, std::size_t size, T value) {
+#if defined(MYSTL_X86_SIMD)
+  if (size >= avx512_lanes<T>::count && cpu_has_avx512()) {
+    return count_avx512<Op>(data, size, value);
+  }
+  if (size >= avx2_lanes<T>::count && cpu_has_avx2()) {
+    return count_avx2<Op>(data, size, value);
+  }
+  if (size >= sse42_lanes<T>::count && cpu_has_sse42()) {
+    return count_sse42<Op>(data, size, value);
+  }
+#endif
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    total += compare_scalar<Op>(data[i], value);
+  }
+  return total;
+}
+
+// Smallest and largest element of a non-empty array. False, with min and
+// max untouched, when no kernel applies or the array holds a NaN; the
+// caller then falls back to comparing elements one by one.
+template <typename T>
+bool simd_min_max([[maybe_unused]] T const *data,
+                  [[maybe_unused]] std::size_t size, [[maybe_unused]] T &min,
+                  [[maybe_unused]] T &max) {
+#if defined(MYSTL_X86_SIMD)
+  if (size >= avx512_lanes<T>::count && cpu_has_avx512()) {
+    return min_max_avx512(data, size, min, max);
+  }
+  if (size >= avx2_lanes<T>::count && cpu_has_avx2()) {
+    return min_max_avx2(data, size, min, max);
+  }
+  if (size >= sse42_lanes<T>::count && cpu_has_sse42()) {
+    return min_max_sse42(data, size, min, max);
+  }
+#endif
+  return false;
+}
+
+template <typename T>
+std::size_t simd_mismatch(T const *a, T const *b, std::size_t size) {
+#if defined(MYSTL_X86_SIMD)
+  if (size >= avx512_lanes<T>::count && cpu_has_avx512()) {
+    return mismatch_avx512(a, b, size);
+  }
+  if (size >= avx2_lanes<T>::count && cpu_has_avx2()) {
+    return mismatch_avx2(a, b, size);
+  }
+  if (size >= sse42_lanes<T>::count && cpu_has_sse42()) {
+    return mismatch_sse42(a, b, size);
+  }
+#endif
+  for (std::size_t i = 0; i < size; ++i) {
+    if (!(a[i] == b[i])) {
+      return i;
+    }
+  }
+  return size;
+}
+
+} // namespace internal
+
+} // namespace mystl
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Vector.h"
+#include <cstddef>
+
+namespace mystl {
+
+// A Vector that keeps up to N elements inside the object itself and only
+// moves to the heap once it grows past that. It is a Vector with inline
+// storage, so it has the same interface and iterators; moving one whose
+// elements are inline moves the elements.
+template <typename T, std::size_t N, typename GrowthPolicy = GeometricGrowth<>,
+          typename Allocator = mystl::Allocator<T>>
+  requires(N > 0)
+using SmallVector = Vector<T, GrowthPolicy, Allocator, N>;
+
+namespace pmr {
+
+template <typename T, std::size_t N, typename GrowthPolicy = GeometricGrowth<>>
+using SmallVector =
+    mystl::SmallVector<T, N, GrowthPolicy, PolymorphicAllocator<T>>;
+
+} // namespace pmr
+
+} // namespace mystl
@@ -0,0 +1,804 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Iterator.h"
+#include "algorithms.h"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace mystl::algo {
+
+// Sorting over contiguous ranges: raw pointers and ContiguousIterator.
+//
+// sort() is pattern-defeating quicksort (Peters, 2021): introsort whose
+// partitions detect already sorted runs and many equal elements, and which
+// falls back to heapsort after too many lopsided partitions, so it is
+// O(n log n) worst case and O(n) on sorted, reversed and all-equal input.
+// For arithmetic elements under std::less/std::greater, the partitions
+// are branchless (BlockQuicksort, Edelkamp & Weiss 2016) and small ranges
+// go through a sorting network, so random data costs no mispredictions.
+//
+// stable_sort() is a merge sort over insertion-sorted runs, or an LSD
+// radix sort for integers in ascending order. radix_sort() sorts by any
+// integral or floating-point key in O(n) passes over the data.
+
+namespace internal {
+
+// Below this many elements, partitioning costs more than it saves.
+inline constexpr std::ptrdiff_t insertion_sort_threshold = 24;
+// Above this many elements, the pivot is the median of three medians.
+inline constexpr std::ptrdiff_t ninther_threshold = 128;
+// partial_insertion_sort() gives up after moving this many elements.
+inline constexpr std::size_t partial_insertion_sort_limit = 8;
+// Elements classified per step of the branchless partition.
+inline constexpr std::size_t partition_block_size = 64;
+
+template <typename Iter_t>
+auto *contiguous_data(Iter_t iter) {
+  auto *data = mystl::internal::unwrap_contiguous(iter);
+  static_assert(std::is_pointer_v<decltype(data)>,
+                "sorting needs raw pointers or a ContiguousIterator");
+  return data;
+}
+
+// Comparisons that compile to a compare and a conditional move, with no
+// user code that could throw or have side effects.
+template <typename T, typename Compare>
+inline constexpr bool is_branchless_sortable_v =
+    (std::is_arithmetic_v<T> || std::is_pointer_v<T>) &&
+    (std::is_same_v<Compare, std::less<>> ||
+     std::is_same_v<Compare, std::less<T>> ||
+     std::is_same_v<Compare, std::greater<>> ||
+     std::is_same_v<Compare, std::greater<T>>);
+
+template <typename T, typename Compare>
+void sort2(T *a, T *b, Compare &comp) {
+  if (comp(*b, *a)) {
+    std::swap(*a, *b);
+  }
+}
+
+template <typename T, typename Compare>
+void sort3(T *a, T *b, T *c, Compare &comp) {
+  sort2(a, b, comp);
+  sort2(b, c, comp);
+  sort2(a, b, comp);
+}
+
+template <typename T, typename Compare>
+void insertion_sort(T *begin, T *end, Compare &comp) {
+  if (begin == end) {
+    return;
+  }
+  for (T *cur = begin + 1; cur != end; ++cur) {
+    T *sift = cur;
+    T *prev = cur - 1;
+    if (comp(*sift, *prev)) {
+      T moved(std::move(*sift));
+      do {
+        *sift-- = std::move(*prev);
+      } while (sift != begin && comp(moved, *--prev));
+      *sift = std::move(moved);
+    }
+  }
+}
+
+// As insertion_sort(), but *(begin - 1) must not be greater than any
+// element of the range, which saves the bounds check.
+template <typename T, typename Compare>
+void unguarded_insertion_sort(T *begin, T *end, Compare &comp) {
+  if (begin == end) {
+    return;
+  }
+  for (T *cur = begin + 1; cur != end; ++cur) {
+    T *sift = cur;
+    T *prev = cur - 1;
+    if (comp(*sift, *prev)) {
+      T moved(std::move(*sift));
+      do {
+        *sift-- = std::move(*prev);
+      } while (comp(moved, *--prev));
+      *sift = std::move(moved);
+    }
+  }
+}
+
+// Insertion sort that gives up once it has moved more than
+// partial_insertion_sort_limit elements. Returns whether it finished.
+template <typename T, typename Compare>
+bool partial_insertion_sort(T *begin, T *end, Compare &comp) {
+  if (begin == end) {
+    return true;
+  }
+  std::size_t moves = 0;
+  for (T *cur = begin + 1; cur != end; ++cur) {
+    if (moves > partial_insertion_sort_limit) {
+      return false;
+    }
+    T *sift = cur;
+    T *prev = cur - 1;
+    if (comp(*sift, *prev)) {
+      T moved(std::move(*sift));
+      do {
+        *sift-- = std::move(*prev);
+      } while (sift != begin && comp(moved, *--prev));
+      *sift = std::move(moved);
+      moves += static_cast<std::size_t>(cur - sift);
+    }
+  }
+  return true;
+}
+
+// Batcher's odd-even merge sort for `size` elements: calls fn(i, j) for
+// each pair to compare-exchange, in order. The pairs depend only on the
+// size, so a sort through them never branches on the data.
+template <typename Fn>
+constexpr void for_each_network_pair(std::size_t size, Fn &&fn) {
+  for (std::size_t p = 1; p < size; p <<= 1) {
+    for (std::size_t k = p; k >= 1; k >>= 1) {
+      for (std::size_t j = k % p; j + k < size; j += 2 * k) {
+        for (std::size_t i = 0; i < k && i < size - j - k; ++i) {
+          if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+            fn(i + j, i + j + k);
+          }
+        }
+      }
+    }
+  }
+}
+
+inline constexpr std::size_t network_max_size = insertion_sort_threshold;
+
+constexpr std::size_t network_pair_count() {
+  std::size_t count = 0;
+  for (std::size_t size = 0; size <= network_max_size; ++size) {
+    for_each_network_pair(size, [&count](std::size_t, std::size_t) {
+      ++count;
+    });
+  }
+  return count;
+}
+
+// The networks for every size up to network_max_size, flattened: the
+// pairs for size n are m_Pairs[2 * m_Offsets[n]] up to
+// m_Pairs[2 * m_Offsets[n + 1]], as i, j.
+struct sorting_networks {
+  std::array<std::uint8_t, 2 * network_pair_count()> m_Pairs{};
+  std::array<std::uint16_t, network_max_size + 2> m_Offsets{};
+};
+
+constexpr sorting_networks build_sorting_networks() {
+  sorting_networks networks;
+  std::size_t next = 0;
+  for (std::size_t size = 0; size <= network_max_size; ++size) {
+    networks.m_Offsets[size] = static_cast<std::uint16_t>(next);
+    for_each_network_pair(size, [&](std::size_t i, std::size_t j) {
+      networks.m_Pairs[2 * next] = static_cast<std::uint8_t>(i);
+      networks.m_Pairs[2 * next + 1] = static_cast<std::uint8_t>(j);
+      ++next;
+    });
+  }
+  networks.m_Offsets[network_max_size + 1] = static_cast<std::uint16_t>(next);
+  return networks;
+}
+
+inline constexpr sorting_networks sorting_network_table =
+    build_sorting_networks();
+
+// Sorts up to network_max_size elements with no data-dependent
+// branches. Only for is_branchless_sortable_v types.
+template <typename T, typename Compare>
+void network_sort(T *begin, T *end, Compare &comp) {
+  auto size = static_cast<std::size_t>(end - begin);
+  auto const &networks = sorting_network_table;
+  std::uint8_t const *pair = &networks.m_Pairs[2 * networks.m_Offsets[size]];
+  std::uint8_t const *last =
+      &networks.m_Pairs[2 * networks.m_Offsets[size + 1]];
+  for (; pair != last; pair += 2) {
+    T a = begin[pair[0]];
+    T b = begin[pair[1]];
+    bool swapped = comp(b, a);
+    begin[pair[0]] = swapped ? b : a;
+    begin[pair[1]] = swapped ? a : b;
+  }
+}
+
+// Heapsort, the worst-case guarantee. A max-heap under `comp` with the
+// children of i at 2i + 1 and 2i + 2.
+template <typename T, typename Compare>
+void sift_down(T *heap, std::ptrdiff_t size, std::ptrdiff_t hole, T value,
+               Compare &comp) {
+  while (true) {
+    std::ptrdiff_t child = 2 * hole + 1;
+    if (child >= size) {
+      break;
+    }
+    if (child + 1 < size && comp(heap[child], heap[child + 1])) {
+      ++child;
+    }
+    if (!comp(value, heap[child])) {
+      break;
+    }
+    heap[hole] = std::move(heap[child]);
+    hole = child;
+  }
+  heap[hole] = std::move(value);
+}
+
+template <typename T, typename Compare>
+void make_heap(T *begin, T *end, Compare &comp) {
+  std::ptrdiff_t size = end - begin;
+  for (std::ptrdiff_t i = size / 2; i-- > 0;) {
+    sift_down(begin, size, i, T(std::move(begin[i])), comp);
+  }
+}
+
+template <typename T, typename Compare>
+void sort_heap(T *begin, T *end, Compare &comp) {
+  for (std::ptrdiff_t size = end - begin; size > 1; --size) {
+    T value(std::move(begin[size - 1]));
+    begin[size - 1] = std::move(begin[0]);
+    sift_down(begin, size - 1, 0, std::move(value), comp);
+  }
+}
+
+template <typename T, typename Compare>
+void heap_sort(T *begin, T *end, Compare &comp) {
+  internal::make_heap(begin, end, comp);
+  internal::sort_heap(begin, end, comp);
+}
+
+// Partitions around *begin, putting elements equal to the pivot on the
+// right. Returns the pivot's final position and whether the range was
+// already partitioned. Needs an element not less than the pivot to the
+// right of it, which the median-of-three selection guarantees.
+template <typename T, typename Compare>
+std::pair<T *, bool> partition_right(T *begin, T *end, Compare &comp) {
+  T pivot(std::move(*begin));
+  T *first = begin;
+  T *last = end;
+
+  while (comp(*++first, pivot)) {
+  }
+  if (first - 1 == begin) {
+    while (first < last && !comp(*--last, pivot)) {
+    }
+  } else {
+    while (!comp(*--last, pivot)) {
+    }
+  }
+
+  bool alreadyPartitioned = first >= last;
+  while (first < last) {
+    std::swap(*first, *last);
+    while (comp(*++first, pivot)) {
+    }
+    while (!comp(*--last, pivot)) {
+    }
+  }
+
+  T *pivotPos = first - 1;
+  *begin = std::move(*pivotPos);
+  *pivotPos = std::move(pivot);
+  return {pivotPos, alreadyPartitioned};
+}
+
+// Swaps the elements named by the two offset lists: left[i] from `first`,
+// right[i] back from `last`. Without `useSwaps` they are rotated through
+// one temporary instead, which is cheaper but needs the lists to differ
+// in length or all elements to be distinct.
+template <typename T>
+void swap_offsets(T *first, T *last, unsigned char const *left,
+                  unsigned char const *right, std::size_t count,
+                  bool useSwaps) {
+  if (useSwaps) {
+    for (std::size_t i = 0; i < count; ++i) {
+      std::swap(first[left[i]], *(last - right[i]));
+    }
+  } else if (count > 0) {
+    T *l = first + left[0];
+    T *r = last - right[0];
+    T moved(std::move(*l));
+    *l = std::move(*r);
+    for (std::size_t i = 1; i < count; ++i) {
+      l = first + left[i];
+      *r = std::move(*l);
+      r = last - right[i];
+      *l = std::move(*r);
+    }
+    *r = std::move(moved);
+  }
+}
+
+// partition_right() without branches on the comparisons: blocks from both
+// ends are first classified into offset lists (the comparison result only
+// advances a counter), then the misplaced elements are swapped pairwise.
+template <typename T, typename Compare>
+std::pair<T *, bool> partition_right_branchless(T *begin, T *end,
+                                                Compare &comp) {
+  constexpr std::size_t block = partition_block_size;
+
+  T pivot(std::move(*begin));
+  T *first = begin;
+  T *last = end;
+
+  while (comp(*++first, pivot)) {
+  }
+  if (first - 1 == begin) {
+    while (first < last && !comp(*--last, pivot)) {
+    }
+  } else {
+    while (!comp(*--last, pivot)) {
+    }
+  }
+
+  bool alreadyPartitioned = first >= last;
+  if (!alreadyPartitioned) {
+    std::swap(*first, *last);
+    ++first;
+
+    unsigned char leftOffsets[block];
+    unsigned char rightOffsets[block];
+    T *leftBase = first;
+    T *rightBase = last;
+    std::size_t leftCount = 0, rightCount = 0;
+    std::size_t leftStart = 0, rightStart = 0;
+
+    while (first < last) {
+      auto unknown = static_cast<std::size_t>(last - first);
+      std::size_t leftSplit =
+          leftCount == 0 ? (rightCount == 0 ? unknown / 2 : unknown) : 0;
+      std::size_t rightSplit = rightCount == 0 ? unknown - leftSplit : 0;
+
+      // Elements on the left that belong right, and vice versa.
+      std::size_t leftTake = leftSplit < block ? leftSplit : block;
+      for (std::size_t i = 0; i < leftTake; ++i) {
+        leftOffsets[leftCount] = static_cast<unsigned char>(i);
+        leftCount += !comp(*first, pivot);
+        ++first;
+      }
+      std::size_t rightTake = rightSplit < block ? rightSplit : block;
+      for (std::size_t i = 0; i < rightTake;) {
+        rightOffsets[rightCount] = static_cast<unsigned char>(++i);
+        rightCount += comp(*--last, pivot);
+      }
+
+      std::size_t count = algo::min(leftCount, rightCount);
+      swap_offsets(leftBase, rightBase, leftOffsets + leftStart,
+                   rightOffsets + rightStart, count,
+                   leftCount == rightCount);
+      leftCount -= count;
+      rightCount -= count;
+      leftStart += count;
+      rightStart += count;
+      if (leftCount == 0) {
+        leftStart = 0;
+        leftBase = first;
+      }
+      if (rightCount == 0) {
+        rightStart = 0;
+        rightBase = last;
+      }
+    }
+
+    // One side still has misplaced elements; move them to the boundary.
+    if (leftCount != 0) {
+      while (leftCount-- > 0) {
+        std::swap(leftBase[leftOffsets[leftStart + leftCount]], *--last);
+      }
+      first = last;
+    }
+    if (rightCount != 0) {
+      while (rightCount-- > 0) {
+        std::swap(*(rightBase - rightOffsets[rightStart + rightCount]),
+                  *first);
+        ++first;
+      }
+      last = first;
+    }
+  }
+
+  T *pivotPos = first - 1;
+  *begin = std::move(*pivotPos);
+  *pivotPos = std::move(pivot);
+  return {pivotPos, alreadyPartitioned};
+}
+
+// Partitions around *begin with the elements equal to the pivot on the
+// left, and returns the pivot's position. Used when the pivot equals the
+// element before the range, i.e. the previous pivot: every element equal
+// to it is then already in place, which makes many duplicates linear.
+template <typename T, typename Compare>
+T *partition_left(T *begin, T *end, Compare &comp) {
+  T pivot(std::move(*begin));
+  T *first = begin;
+  T *last = end;
+
+  while (comp(pivot, *--last)) {
+  }
+  if (last + 1 == end) {
+    while (first < last && !comp(pivot, *++first)) {
+    }
+  } else {
+    while (!comp(pivot, *++first)) {
+    }
+  }
+
+  while (first < last) {
+    std::swap(*first, *last);
+    while (comp(pivot, *--last)) {
+    }
+    while (!comp(pivot, *++first)) {
+    }
+  }
+
+  T *pivotPos = last;
+  *begin = std::move(*pivotPos);
+  *pivotPos = std::move(pivot);
+  return pivotPos;
+}
+
+// Swaps a few elements of a lopsided partition to break up the pattern
+// that produced it.
+template <typename T>
+void shuffle_partition(T *begin, T *pivotPos, T *end) {
+  std::ptrdiff_t leftSize = pivotPos - begin;
+  std::ptrdiff_t rightSize = end - (pivotPos + 1);
+
+  if (leftSize >= insertion_sort_threshold) {
+    std::swap(begin[0], begin[leftSize / 4]);
+    std::swap(pivotPos[-1], pivotPos[-leftSize / 4]);
+    if (leftSize > ninther_threshold) {
+      std::swap(begin[1], begin[leftSize / 4 + 1]);
+      std::swap(begin[2], begin[leftSize / 4 + 2]);
+      std::swap(pivotPos[-2], pivotPos[-(leftSize / 4 + 1)]);
+      std::swap(pivotPos[-3], pivotPos[-(leftSize / 4 + 2)]);
+    }
+  }
+
+  if (rightSize >= insertion_sort_threshold) {
+    std::swap(pivotPos[1], pivotPos[1 + rightSize / 4]);
+    std::swap(end[-1], end[-rightSize / 4]);
+    if (rightSize > ninther_threshold) {
+      std::swap(pivotPos[2], pivotPos[2 + rightSize / 4]);
+      std::swap(pivotPos[3], pivotPos[3 + rightSize / 4]);
+      std::swap(end[-2], end[-(1 + rightSize / 4)]);
+      std::swap(end[-3], end[-(2 + rightSize / 4)]);
+    }
+  }
+}
+
+// `badAllowed` lopsided partitions are tolerated before heapsort takes
+// over. `leftmost` is false when *(begin - 1) is a previous pivot, i.e.
+// not greater than anything in the range.
+template <bool Branchless, typename T, typename Compare>
+void pdq_sort(T *begin, T *end, Compare &comp, int badAllowed,
+              bool leftmost) {
+  while (true) {
+    std::ptrdiff_t size = end - begin;
+
+    if (size < insertion_sort_threshold) {
+      if constexpr (Branchless) {
+        network_sort(begin, end, comp);
+      } else if (leftmost) {
+        insertion_sort(begin, end, comp);
+      } else {
+        unguarded_insertion_sort(begin, end, comp);
+      }
+      return;
+    }
+
+    // The pivot goes to *begin.
+    std::ptrdiff_t half = size / 2;
+    if (size > ninther_threshold) {
+      sort3(begin, begin + half, end - 1, comp);
+      sort3(begin + 1, begin + (half - 1), end - 2, comp);
+      sort3(begin + 2, begin + (half + 1), end - 3, comp);
+      sort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+      std::swap(*begin, begin[half]);
+    } else {
+      sort3(begin + half, begin, end - 1, comp);
+    }
+
+    if (!leftmost && !comp(begin[-1], *begin)) {
+      begin = partition_left(begin, end, comp) + 1;
+      continue;
+    }
+
+    auto [pivotPos, alreadyPartitioned] =
+        Branchless ? partition_right_branchless(begin, end, comp)
+                   : partition_right(begin, end, comp);
+
+    std::ptrdiff_t leftSize = pivotPos - begin;
+    std::ptrdiff_t rightSize = end - (pivotPos + 1);
+    if (leftSize < size / 8 || rightSize < size / 8) {
+      if (--badAllowed == 0) {
+        heap_sort(begin, end, comp);
+        return;
+      }
+      shuffle_partition(begin, pivotPos, end);
+    } else if (alreadyPartitioned &&
+               partial_insertion_sort(begin, pivotPos, comp) &&
+               partial_insertion_sort(pivotPos + 1, end, comp)) {
+      // Both sides were (nearly) sorted already.
+      return;
+    }
+
+    pdq_sort<Branchless>(begin, pivotPos, comp, badAllowed, leftmost);
+    begin = pivotPos + 1;
+    leftmost = false;
+  }
+}
+
+// Uninitialized storage for `size` elements, released on scope exit.
+template <typename T>
+class sort_buffer {
+public:
+  explicit sort_buffer(std::size_t size)
+      : m_Data(size == 0 ? nullptr : mystl::Allocator<T>().allocate(size)),
+        m_Size(size) {}
+
+  sort_buffer(sort_buffer const &) = delete;
+  sort_buffer &operator=(sort_buffer const &) = delete;
+
+  ~sort_buffer() {
+    if (m_Data != nullptr) {
+      mystl::Allocator<T>().deallocate(m_Data, m_Size);
+    }
+  }
+
+  T *data() const { return m_Data; }
+
+private:
+  T *m_Data;
+  std::size_t m_Size;
+};
+
+// Merges the sorted runs [begin, middle) and [middle, end), stably. The
+// shorter run is moved out to `buffer`, which must hold half the total.
+template <typename T, typename Compare>
+void merge_runs(T *begin, T *middle, T *end, T *buffer, Compare &comp) {
+  if (!comp(*middle, middle[-1])) {
+    return;
+  }
+
+  if (middle - begin <= end - middle) {
+    // Forwards, from the buffered left run and the right run.
+    T *bufferEnd = buffer;
+    for (T *it = begin; it != middle; ++it, ++bufferEnd) {
+      std::construct_at(bufferEnd, std::move(*it));
+    }
+    T *left = buffer;
+    T *right = middle;
+    T *out = begin;
+    while (left != bufferEnd && right != end) {
+      if (comp(*right, *left)) {
+        *out++ = std::move(*right++);
+      } else {
+        *out++ = std::move(*left++);
+      }
+    }
+    while (left != bufferEnd) {
+      *out++ = std::move(*left++);
+    }
+    std::destroy(buffer, bufferEnd);
+  } else {
+    // Backwards, from the left run and the buffered right run. On ties the
+    // right element is placed first, as it goes after.
+    T *bufferEnd = buffer;
+    for (T *it = middle; it != end; ++it, ++bufferEnd) {
+      std::construct_at(bufferEnd, std::move(*it));
+    }
+    T *left = middle;
+    T *right = bufferEnd;
+    T *out = end;
+    while (left != begin && right != buffer) {
+      if (comp(right[-1], left[-1])) {
+        *--out = std::move(*--left);
+      } else {
+        *--out = std::move(*--right);
+      }
+    }
+    while (right != buffer) {
+      *--out = std::move(*--right);
+    }
+    std::destroy(buffer, bufferEnd);
+  }
+}
+
+// Stable merge sort: insertion-sorted runs of merge_run_length, then
+// bottom-up merges of neighbouring runs.
+inline constexpr std::ptrdiff_t merge_run_length = 32;
+
+template <typename T, typename Compare>
+void merge_sort(T *begin, T *end, Compare &comp) {
+  std::ptrdiff_t size = end - begin;
+  for (std::ptrdiff_t run = 0; run < size; run += merge_run_length) {
+    std::ptrdiff_t runEnd = algo::min(run + merge_run_length, size);
+    insertion_sort(begin + run, begin + runEnd, comp);
+  }
+  if (size <= merge_run_length) {
+    return;
+  }
+
+  sort_buffer<T> buffer(static_cast<std::size_t>(size / 2));
+  for (std::ptrdiff_t width = merge_run_length; width < size; width *= 2) {
+    for (std::ptrdiff_t run = 0; run + width < size; run += 2 * width) {
+      merge_runs(begin + run, begin + run + width,
+                 begin + algo::min(run + 2 * width, size), buffer.data(),
+                 comp);
+    }
+  }
+}
+
+// The unsigned integer whose order matches `key`'s: the sign bit of
+// signed integers is flipped, and negative floating-point values have all
+// their bits flipped so that larger magnitudes sort first.
+template <typename Key_t>
+constexpr auto radix_bits(Key_t key) {
+  if constexpr (std::is_same_v<Key_t, bool>) {
+    return static_cast<std::uint8_t>(key);
+  } else if constexpr (std::is_floating_point_v<Key_t>) {
+    static_assert(sizeof(Key_t) == 4 || sizeof(Key_t) == 8,
+                  "radix keys must be float or double");
+    using bits_t = std::conditional_t<sizeof(Key_t) == 4, std::uint32_t,
+                                      std::uint64_t>;
+    constexpr int high = 8 * sizeof(bits_t) - 1;
+    auto bits = std::bit_cast<bits_t>(key);
+    bits_t mask = (bits_t(0) - (bits >> high)) | (bits_t(1) << high);
+    return static_cast<bits_t>(bits ^ mask);
+  } else {
+    using bits_t = std::make_unsigned_t<Key_t>;
+    auto bits = static_cast<bits_t>(key);
+    if constexpr (std::is_signed_v<Key_t>) {
+      constexpr int high = 8 * sizeof(bits_t) - 1;
+      bits = static_cast<bits_t>(bits ^ (bits_t(1) << high));
+    }
+    return bits;
+  }
+}
+
+// Below this many elements, a comparison sort is faster than the radix
+// passes and their histograms.
+inline constexpr std::ptrdiff_t radix_sort_threshold = 256;
+
+// LSD radix sort by `key`, one pass per byte of the key. Bytes that are the
+// same in every key are skipped. The elements move between the range and a
+// buffer; each pass leaves exactly one of the two holding live objects.
+template <typename T, typename Key>
+void radix_sort(T *begin, T *end, Key &key) {
+  using bits_t = decltype(radix_bits(key(*begin)));
+  constexpr std::size_t digits = sizeof(bits_t);
+  auto size = static_cast<std::size_t>(end - begin);
+
+  std::size_t counts[digits][256] = {};
+  for (T *it = begin; it != end; ++it) {
+    bits_t bits = radix_bits(key(*it));
+    for (std::size_t d = 0; d < digits; ++d) {
+      ++counts[d][(bits >> (8 * d)) & 0xff];
+    }
+  }
+
+  sort_buffer<T> buffer(size);
+  T *from = begin;
+  T *to = buffer.data();
+  for (std::size_t d = 0; d < digits; ++d) {
+    std::size_t *count = counts[d];
+    if (count[(radix_bits(key(*from)) >> (8 * d)) & 0xff] == size) {
+      continue;
+    }
+
+    std::size_t offsets[256];
+    std::size_t total = 0;
+    for (std::size_t digit = 0; digit < 256; ++digit) {
+      offsets[digit] = total;
+      total += count[digit];
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+      std::size_t digit = (radix_bits(key(from[i])) >> (8 * d)) & 0xff;
+      std::construct_at(to + offsets[digit]++, std::move(from[i]));
+      std::destroy_at(from + i);
+    }
+    std::swap(from, to);
+  }
+
+  if (from != begin) {
+    for (std::size_t i = 0; i < size; ++i) {
+      std::construct_at(begin + i, std::move(from[i]));
+      std::destroy_at(from + i);
+    }
+  }
+}
+
+} // namespace internal
+
+template <typename Iter_t, typename Compare = std::less<>>
+void sort(Iter_t first, Iter_t last, Compare comp = {}) {
+  auto *begin = internal::contiguous_data(first);
+  auto *end = begin + (last - first);
+  if (end - begin < 2) {
+    return;
+  }
+
+  using value_t = std::remove_pointer_t<decltype(begin)>;
+  int badAllowed = std::bit_width(static_cast<std::size_t>(end - begin));
+  internal::pdq_sort<internal::is_branchless_sortable_v<value_t, Compare>>(
+      begin, end, comp, badAllowed, true);
+}
+
+// Equal elements keep their order. Allocates a buffer of up to half the
+// range (all of it for the radix sort).
+template <typename Iter_t, typename Compare = std::less<>>
+void stable_sort(Iter_t first, Iter_t last, Compare comp = {}) {
+  auto *begin = internal::contiguous_data(first);
+  auto *end = begin + (last - first);
+  using value_t = std::remove_pointer_t<decltype(begin)>;
+
+  // Integers in ascending order are exactly the radix order. (Floating
+  // point is not: -0.0 and 0.0 compare equal but differ in their bits.)
+  if constexpr (std::is_integral_v<value_t> &&
+                (std::is_same_v<Compare, std::less<>> ||
+                 std::is_same_v<Compare, std::less<value_t>>)) {
+    if (end - begin >= internal::radix_sort_threshold) {
+      auto identity = [](value_t value) { return value; };
+      internal::radix_sort(begin, end, identity);
+      return;
+    }
+  }
+  internal::merge_sort(begin, end, comp);
+}
+
+// Sorts the smallest middle - first elements into [first, middle); the
+// rest are left in [middle, last) in no particular order. O(n log k).
+template <typename Iter_t, typename Compare = std::less<>>
+void partial_sort(Iter_t first, Iter_t middle, Iter_t last,
+                  Compare comp = {}) {
+  auto *begin = internal::contiguous_data(first);
+  auto *heapEnd = begin + (middle - first);
+  auto *end = begin + (last - first);
+  if (begin == heapEnd) {
+    return;
+  }
+
+  // A max-heap of the smallest elements seen so far.
+  internal::make_heap(begin, heapEnd, comp);
+  for (auto *it = heapEnd; it != end; ++it) {
+    if (comp(*it, *begin)) {
+      auto value(std::move(*it));
+      *it = std::move(*begin);
+      internal::sift_down(begin, heapEnd - begin, 0, std::move(value), comp);
+    }
+  }
+  internal::sort_heap(begin, heapEnd, comp);
+}
+
+// Stable LSD radix sort by key(element), which must return an integral or
+// floating-point type and must not throw. Orders floating-point keys by
+// their bits: -0.0 before 0.0, and NaNs (by sign) at either end. Without
+// a key, the elements are their own keys.
+template <typename Iter_t, typename Key>
+void radix_sort(Iter_t first, Iter_t last, Key key) {
+  auto *begin = internal::contiguous_data(first);
+  auto *end = begin + (last - first);
+  if (end - begin < internal::radix_sort_threshold) {
+    auto byBits = [&key](auto const &a, auto const &b) {
+      return internal::radix_bits(key(a)) < internal::radix_bits(key(b));
+    };
+    internal::merge_sort(begin, end, byBits);
+    return;
+  }
+  internal::radix_sort(begin, end, key);
+}
+
+template <typename Iter_t>
+void radix_sort(Iter_t first, Iter_t last) {
+  radix_sort(first, last, [](auto const &value) { return value; });
+}
+
+} // namespace mystl::algo
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Concurrency.h"
+#include "Memory.h"
+#include "MySTL/algorithms.h"
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <new>
+#include <span>
+#include <utility>
+
+namespace mystl {
+
+// Capacity argument that makes SpscQueue take its capacity at run time.
+inline constexpr std::size_t dynamic_capacity = static_cast<std::size_t>(-1);
+
+namespace internal {
+
+// Slots of a fixed-capacity queue live inside the object, like Array.
+template <typename T, std::size_t Capacity>
+struct spsc_storage {
+  static_assert(Capacity > 0 && std::has_single_bit(Capacity),
+                "SpscQueue capacity must be a power of two");
+
+  constexpr std::size_t capacity() const { return Capacity; }
+
+  T *data() { return std::launder(reinterpret_cast<T *>(m_Slots)); }
+
+  alignas(T) std::byte m_Slots[Capacity * sizeof(T)];
+};
+
+template <typename T>
+struct spsc_storage<T, dynamic_capacity> {
+  explicit spsc_storage(std::size_t capacity)
+      : m_Capacity(std::bit_ceil(algo::max(capacity, std::size_t{1}))),
+        m_Data(mystl::Allocator<T>{}.allocate(m_Capacity)) {}
+
+  spsc_storage(spsc_storage const &) = delete;
+  spsc_storage &operator=(spsc_storage const &) = delete;
+
+  ~spsc_storage() { mystl::Allocator<T>{}.deallocate(m_Data, m_Capacity); }
+
+  std::size_t capacity() const { return m_Capacity; }
+
+  T *data() { return m_Data; }
+
+  std::size_t m_Capacity;
+  T *m_Data;
+};
+
+} // namespace internal
+
+// Lock-free queue for exactly one producer thread and one consumer thread.
+// With a compile-time Capacity (a power of two) the slots live inside the
+// object; SpscQueue<T> takes its capacity at construction and rounds it up
+// to a power of two.
+//
+// The producer owns the tail index and the consumer the head index, each on
+// its own cache line next to a cached copy of the other side's index. The
+// shared indices are only re-read when the cached copy says the queue looks
+// full (or empty), so in steady state each side touches only its own line.
+template <typename T, std::size_t Capacity = dynamic_capacity>
+class SpscQueue {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+public:
+  SpscQueue()
+    requires(Capacity != dynamic_capacity)
+      : m_Mask(Capacity - 1) {}
+
+  explicit SpscQueue(size_type capacity)
+    requires(Capacity == dynamic_capacity)
+      : m_Storage(capacity), m_Mask(m_Storage.capacity() - 1) {}
+
+  SpscQueue(SpscQueue const &) = delete;
+  SpscQueue &operator=(SpscQueue const &) = delete;
+
+  ~SpscQueue() {
+    size_type head = m_Head.load(std::memory_order_relaxed);
+    size_type tail = m_Tail.load(std::memory_order_relaxed);
+    for (; head != tail; ++head) {
+      std::destroy_at(slot(head));
+    }
+  }
+
+  size_type capacity() const { return m_Mask + 1; }
+
+  // Only a snapshot while the other thread is running.
+  size_type size() const {
+    size_type head = m_Head.load(std::memory_order_acquire);
+    return m_Tail.load(std::memory_order_acquire) - head;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  // Producer side
+
+  template <typename... Args>
+  bool try_emplace(Args &&...args) {
+    size_type tail = m_Tail.load(std::memory_order_relaxed);
+    if (tail - m_CachedHead == capacity()) {
+      m_CachedHead = m_Head.load(std::memory_order_acquire);
+      if (tail - m_CachedHead == capacity()) {
+        return false;
+      }
+    }
+
+    new (slot(tail)) T{std::forward<Args>(args)...};
+    m_Tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_push(T const &val) { return try_emplace(val); }
+
+  bool try_push(T &&val) { return try_emplace(std::move(val)); }
+
+  // Copies as many of `values` as fit and publishes them with a single
+  // store; returns how many were pushed.
+  size_type try_push_n(std::span<T const> values) {
+    size_type tail = m_Tail.load(std::memory_order_relaxed);
+    size_type room = capacity() - (tail - m_CachedHead);
+    if (room < values.size()) {
+      m_CachedHead = m_Head.load(std::memory_order_acquire);
+      room = capacity() - (tail - m_CachedHead);
+    }
+
+    size_type count = algo::min(room, values.size());
+    size_type first = first_run(tail, count);
+    uninitialized_copy_n(values.data(), first, slot(tail));
+    uninitialized_copy_n(values.data() + first, count - first, slot(0));
+
+    m_Tail.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+  // Consumer side
+
+  bool try_pop(T &out) {
+    size_type head = m_Head.load(std::memory_order_relaxed);
+    if (head == m_CachedTail) {
+      m_CachedTail = m_Tail.load(std::memory_order_acquire);
+      if (head == m_CachedTail) {
+        return false;
+      }
+    }
+
+    relocate_assign(slot(head), 1, &out);
+    m_Head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Moves up to out.size() elements into `out` and frees their slots with a
+  // single store; returns how many were taken.
+  size_type try_pop_n(std::span<T> out) {
+    size_type head = m_Head.load(std::memory_order_relaxed);
+    if (m_CachedTail - head < out.size()) {
+      m_CachedTail = m_Tail.load(std::memory_order_acquire);
+    }
+
+    size_type count = algo::min(m_CachedTail - head, out.size());
+    size_type first = first_run(head, count);
+    relocate_assign(slot(head), first, out.data());
+    relocate_assign(slot(0), count - first, out.data() + first);
+
+    m_Head.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+private:
+  T *slot(size_type index) { return m_Storage.data() + (index & m_Mask); }
+
+  // Number of the `count` slots starting at `index` that lie before the end
+  // of the buffer; the rest wrap around to slot 0.
+  size_type first_run(size_type index, size_type count) const {
+    return algo::min(count, capacity() - (index & m_Mask));
+  }
+
+private:
+  internal::spsc_storage<T, Capacity> m_Storage;
+  size_type const m_Mask;
+
+  // Written by the producer.
+  alignas(cache_line_size) std::atomic<size_type> m_Tail{0};
+  size_type m_CachedHead = 0;
+
+  // Written by the consumer.
+  alignas(cache_line_size) std::atomic<size_type> m_Head{0};
+  size_type m_CachedTail = 0;
+};
+
+} // namespace mystl
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Vector.h"
+#include <concepts>
+#include <memory>
 #include <utility>
 
 namespace mystl {
@@ -8,11 +10,12 @@ namespace mystl {
 template <typename T, typename Container_t = Vector<T>>
 class Stack {
 public:
-  using value_type = typename Container_t::value_t;
-  using pointer = typename Container_t::pointer_t;
-  using const_pointer_t = typename Container_t::const_pointer_t;
-  using reference = typename Container_t::reference_t;
-  using const_reference = typename Container_t::reference_type;
+  using container_type = Container_t;
+  using value_type = typename Container_t::value_type;
+  using pointer = typename Container_t::pointer;
+  using const_pointer = typename Container_t::const_pointer;
+  using reference = typename Container_t::reference;
+  using const_reference = typename Container_t::const_reference;
   using size_type = typename Container_t::size_type;
 
   using iterator = typename Container_t::iterator;
@@ -24,6 +27,13 @@ public:
   constexpr explicit Stack(const Container_t &containter)
       : m_Underlying(containter) {}
 
+  // Builds the underlying container on the given allocator. Only allocators
+  // the container uses take part, so a Stack is not built from an int.
+  template <typename Allocator>
+    requires std::uses_allocator_v<Container_t, Allocator> &&
+             std::constructible_from<Container_t, Allocator const &>
+  constexpr explicit Stack(Allocator const &alloc) : m_Underlying(alloc) {}
+
   constexpr Stack &operator=(const Stack &) = default;
   constexpr Stack &operator=(Stack &&) = default;
 
@@ -41,7 +51,7 @@ public:
 
   template <typename Self>
   constexpr auto &&top(this Self &&self) {
-    return std::forward<Self>(self).back();
+    return std::forward<Self>(self).m_Underlying.back();
   }
 
   constexpr void clear() { m_Underlying.clear(); }
@@ -60,4 +70,11 @@ private:
   Container_t m_Underlying;
 };
 
+namespace pmr {
+
+template <typename T, typename Container_t = pmr::Vector<T>>
+using Stack = mystl::Stack<T, Container_t>;
+
+} // namespace pmr
+
 } // namespace mystl
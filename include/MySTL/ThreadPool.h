@@ -0,0 +1,333 @@
+#pragma once
+
+#include "Concurrency.h"
+#include "Vector.h"
+#include "WorkStealingDeque.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace mystl {
+
+namespace internal {
+
+class pool_job;
+
+// The iterations [m_Begin, m_End) of a job, waiting in some worker's deque.
+struct pool_task {
+  pool_job *m_Job;
+  std::size_t m_Begin;
+  std::size_t m_End;
+};
+
+// One ThreadPool::parallel_for() call. Lives on the caller's stack, which
+// waits in wait() until every iteration has run.
+class pool_job {
+public:
+  // Every split hands one new task to another worker, and only ranges
+  // longer than `grain` are split, so no task is shorter than half a grain
+  // (rounded up) and count / ceil(grain / 2) tasks are always enough.
+  template <typename Fn>
+  pool_job(std::size_t count, std::size_t grain, Fn &fn)
+      : m_Body(&invoke<Fn>),
+        m_Context(const_cast<void *>(static_cast<void const *>(&fn))),
+        m_Grain(grain),
+        m_Tasks(std::make_unique<pool_task[]>(task_bound(count, grain))),
+        m_Pending(count) {}
+
+  std::size_t grain() const { return m_Grain; }
+
+  pool_task *make_task(std::size_t begin, std::size_t end) {
+    pool_task *task =
+        &m_Tasks[m_NextTask.fetch_add(1, std::memory_order_relaxed)];
+    *task = pool_task{this, begin, end};
+    return task;
+  }
+
+  // Runs iterations [begin, end). After the first exception the remaining
+  // iterations are skipped; the exception is rethrown by wait(). Returns
+  // true if these were the job's last iterations, after which the job may
+  // be gone.
+  bool run(std::size_t begin, std::size_t end) {
+    for (std::size_t index = begin; index < end; ++index) {
+      if (m_Failed.load(std::memory_order_relaxed)) {
+        break;
+      }
+      try {
+        m_Body(m_Context, index);
+      } catch (...) {
+        if (!m_Failed.exchange(true, std::memory_order_relaxed)) {
+          m_Error = std::current_exception();
+        }
+      }
+    }
+
+    if (m_Pending.fetch_sub(end - begin, std::memory_order_acq_rel) ==
+        end - begin) {
+      // Notifying under the lock keeps the waiter, and with it the job, from
+      // going away before we are done with it.
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Done = true;
+      m_Finished.notify_all();
+      return true;
+    }
+    return false;
+  }
+
+  bool finished() const {
+    return m_Pending.load(std::memory_order_acquire) == 0;
+  }
+
+  void wait() {
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_Finished.wait(lock, [this] { return m_Done; });
+    }
+    if (m_Error) {
+      std::rethrow_exception(m_Error);
+    }
+  }
+
+private:
+  static std::size_t task_bound(std::size_t count, std::size_t grain) {
+    std::size_t shortest = (grain + 1) / 2;
+    return count / shortest > 1 ? count / shortest : 1;
+  }
+
+  template <typename Fn>
+  static void invoke(void *context, std::size_t index) {
+    (*static_cast<Fn *>(context))(index);
+  }
+
+private:
+  void (*m_Body)(void *, std::size_t);
+  void *m_Context;
+  std::size_t m_Grain;
+  std::unique_ptr<pool_task[]> m_Tasks;
+  std::atomic<std::size_t> m_NextTask{0};
+  std::atomic<std::size_t> m_Pending;
+  std::atomic<bool> m_Failed{false};
+  std::exception_ptr m_Error;
+  std::mutex m_Mutex;
+  std::condition_variable m_Finished;
+  bool m_Done = false;
+};
+
+} // namespace internal
+
+// Fork-join pool for data-parallel loops. parallel_for(count, fn) calls
+// fn(i) for every i in [0, count) across the workers and returns once all
+// calls are done.
+//
+// Scheduling is work stealing: each worker owns a WorkStealingDeque. A
+// worker holding a range of iterations keeps half of it and pushes the
+// other half on its own deque until it is down to the grain size, then
+// runs that range in a loop. Idle workers steal the largest pieces (from
+// the top) while the owner works through the small ones it split off last
+// (from the bottom). Jobs from threads outside the pool enter through a
+// shared queue and the caller sleeps until they finish; a worker calling
+// parallel_for() instead keeps running tasks while it waits, so nested
+// loops cannot deadlock. Idle workers, and waiting ones with nothing to
+// run, sleep on an event_count.
+class ThreadPool {
+public:
+  using size_type = std::size_t;
+
+public:
+  explicit ThreadPool(size_type threads = std::thread::hardware_concurrency())
+      : m_ThreadCount(threads == 0 ? 1 : threads),
+        m_Workers(std::make_unique<Worker[]>(m_ThreadCount)) {
+    for (size_type i = 0; i < m_ThreadCount; ++i) {
+      m_Workers[i].m_Pool = this;
+      m_Workers[i].m_Index = i;
+    }
+    for (size_type i = 0; i < m_ThreadCount; ++i) {
+      m_Workers[i].m_Thread = std::thread([this, i] { work(m_Workers[i]); });
+    }
+  }
+
+  ThreadPool(ThreadPool const &) = delete;
+  ThreadPool &operator=(ThreadPool const &) = delete;
+
+  // Waits for the workers to run out of tasks, then joins them.
+  ~ThreadPool() {
+    m_Stopping.store(true, std::memory_order_release);
+    m_Sleep.notify_all();
+    for (size_type i = 0; i < m_ThreadCount; ++i) {
+      m_Workers[i].m_Thread.join();
+    }
+  }
+
+  size_type thread_count() const { return m_ThreadCount; }
+
+  // Calls fn(i) for every i in [0, count), in no particular order and
+  // possibly concurrently. Rethrows the first exception thrown by `fn`; the
+  // iterations that had not started by then are skipped.
+  //
+  // Ranges of at most `grain` iterations are not split further but run in
+  // one loop, which bounds the scheduling cost. By default the loop is cut
+  // into about eight pieces per worker; cheap, uniform iterations want no
+  // finer, while uneven ones may want a smaller grain.
+  template <typename Fn>
+  void parallel_for(size_type count, Fn &&fn, size_type grain = 0) {
+    Worker *self = t_Worker != nullptr && t_Worker->m_Pool == this
+                       ? t_Worker
+                       : nullptr;
+
+    // A single worker gains nothing over the caller doing the work itself.
+    if (count <= 1 || (self == nullptr && m_ThreadCount == 1)) {
+      for (size_type i = 0; i < count; ++i) {
+        fn(i);
+      }
+      return;
+    }
+
+    if (grain == 0) {
+      grain = count / (m_ThreadCount * 8);
+      grain = grain == 0 ? 1 : grain;
+    }
+
+    internal::pool_job job(count, grain, fn);
+    internal::pool_task *root = job.make_task(0, count);
+    if (self != nullptr) {
+      self->m_Tasks.push(root);
+      m_Sleep.notify_one();
+      internal::pool_task *task;
+      while (!job.finished()) {
+        if (find_task(*self, task)) {
+          run(*self, task);
+          continue;
+        }
+
+        // The job's last tasks run elsewhere. Sleep until they finish
+        // (run() wakes everyone when a job ends) or new work shows up.
+        std::uint32_t epoch = m_Sleep.prepare_wait();
+        if (job.finished() || has_tasks()) {
+          m_Sleep.cancel_wait();
+        } else {
+          m_Sleep.wait(epoch);
+        }
+      }
+    } else {
+      {
+        std::lock_guard<std::mutex> lock(m_InjectedMutex);
+        m_Injected.push_back(root);
+        m_InjectedCount.fetch_add(1, std::memory_order_relaxed);
+      }
+      m_Sleep.notify_one();
+    }
+    job.wait();
+  }
+
+private:
+  struct Worker {
+    ThreadPool *m_Pool = nullptr;
+    size_type m_Index = 0;
+    WorkStealingDeque<internal::pool_task *> m_Tasks;
+    std::thread m_Thread;
+  };
+
+  void work(Worker &self) {
+    t_Worker = &self;
+    internal::pool_task *task;
+    while (true) {
+      if (find_task(self, task)) {
+        run(self, task);
+        continue;
+      }
+
+      std::uint32_t epoch = m_Sleep.prepare_wait();
+      if (has_tasks()) {
+        m_Sleep.cancel_wait();
+      } else if (m_Stopping.load(std::memory_order_acquire)) {
+        m_Sleep.cancel_wait();
+        return;
+      } else {
+        m_Sleep.wait(epoch);
+      }
+    }
+  }
+
+  // Splits the task down to the job's grain, leaving the other halves for
+  // thieves, and runs what is left. Workers waiting in parallel_for() for
+  // a job are woken when it ends.
+  void run(Worker &self, internal::pool_task *task) {
+    internal::pool_job *job = task->m_Job;
+    size_type begin = task->m_Begin;
+    size_type end = task->m_End;
+    while (end - begin > job->grain()) {
+      size_type middle = begin + (end - begin) / 2;
+      self.m_Tasks.push(job->make_task(middle, end));
+      m_Sleep.notify_one();
+      end = middle;
+    }
+    if (job->run(begin, end)) {
+      m_Sleep.notify_all();
+    }
+  }
+
+  // Own tasks first, then new jobs, then other workers' tasks.
+  bool find_task(Worker &self, internal::pool_task *&task) {
+    if (self.m_Tasks.pop(task)) {
+      return true;
+    }
+
+    if (m_InjectedCount.load(std::memory_order_relaxed) != 0) {
+      std::lock_guard<std::mutex> lock(m_InjectedMutex);
+      if (!m_Injected.empty()) {
+        task = m_Injected.back();
+        m_Injected.pop_back();
+        m_InjectedCount.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+
+    for (size_type i = 1; i < m_ThreadCount; ++i) {
+      Worker &victim = m_Workers[(self.m_Index + i) % m_ThreadCount];
+      if (victim.m_Tasks.steal(task)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool has_tasks() const {
+    if (m_InjectedCount.load(std::memory_order_relaxed) != 0) {
+      return true;
+    }
+    for (size_type i = 0; i < m_ThreadCount; ++i) {
+      if (!m_Workers[i].m_Tasks.empty()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  // The worker running on this thread, if any.
+  static inline thread_local Worker *t_Worker = nullptr;
+
+  size_type const m_ThreadCount;
+  std::unique_ptr<Worker[]> m_Workers;
+  internal::event_count m_Sleep;
+  std::atomic<bool> m_Stopping{false};
+
+  std::mutex m_InjectedMutex;
+  Vector<internal::pool_task *> m_Injected;
+  std::atomic<size_type> m_InjectedCount{0};
+};
+
+// The pool the parallel algorithms use unless given another: one worker per
+// hardware thread, started on first use.
+inline ThreadPool &default_thread_pool() {
+  static ThreadPool pool;
+  return pool;
+}
+
+} // namespace mystl
@@ -0,0 +1,454 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Concurrency.h"
+#include "Iterator.h"
+#include "Memory.h"
+#include "MemoryResource.h"
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace mystl {
+
+namespace internal {
+
+struct unrolled_link {
+  unrolled_link *prev;
+  unrolled_link *next;
+};
+
+// A node holds its elements in order in slots [0, m_Count).
+template <typename T, std::size_t Capacity>
+struct unrolled_node : unrolled_link {
+  std::size_t m_Count = 0;
+  alignas(T) std::byte m_Slots[Capacity * sizeof(T)];
+
+  T *data() { return std::launder(reinterpret_cast<T *>(m_Slots)); }
+};
+
+// Enough elements to fill about four cache lines per node, and at least 4.
+template <typename T>
+constexpr std::size_t unrolled_node_capacity() {
+  std::size_t header = sizeof(unrolled_node<T, 1>) - sizeof(T);
+  std::size_t fit = (4 * cache_line_size - header) / sizeof(T);
+  return fit < 4 ? 4 : fit;
+}
+
+} // namespace internal
+
+// Doubly linked list of small arrays. Each node holds up to NodeCapacity
+// elements side by side, so a scan touches one node per few cache lines
+// instead of one per element, while inserting or erasing next to an
+// iterator only shifts the elements of one node. A full node is split in
+// half to make room; a node that drops below a quarter full is merged into
+// a neighbour that has room for it.
+//
+// Insert and erase invalidate iterators into the node they touch and its
+// neighbours; iterators into other nodes stay valid.
+template <typename T,
+          std::size_t NodeCapacity = internal::unrolled_node_capacity<T>(),
+          typename Allocator = mystl::Allocator<T>>
+class UnrolledList {
+  static_assert(NodeCapacity >= 2, "UnrolledList nodes hold at least two");
+
+public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = T const &;
+
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+
+  using allocator_type = Allocator;
+
+  using linkptr_type = internal::unrolled_link *;
+  using nodeptr_type = internal::unrolled_node<T, NodeCapacity> *;
+
+  using iterator = UnrolledIterator<UnrolledList>;
+  using const_iterator = ConstUnrolledIterator<UnrolledList>;
+
+  static constexpr size_type node_capacity = NodeCapacity;
+
+public:
+  UnrolledList() : UnrolledList(Allocator{}) {}
+
+  explicit UnrolledList(Allocator const &alloc)
+      : m_Alloc(alloc), m_Header{&m_Header, &m_Header}, m_Size(0) {}
+
+  UnrolledList(size_type count, T const &val,
+               Allocator const &alloc = Allocator{})
+      : UnrolledList(alloc) {
+    for (size_type i = 0; i < count; ++i) {
+      push_back(val);
+    }
+  }
+
+  UnrolledList(std::initializer_list<T> iList,
+               Allocator const &alloc = Allocator{})
+      : UnrolledList(alloc) {
+    for (T const &val : iList) {
+      push_back(val);
+    }
+  }
+
+  UnrolledList(UnrolledList const &copy)
+      : UnrolledList(Allocator(
+            node_traits::select_on_container_copy_construction(copy.m_Alloc))) {
+    copy_from(copy);
+  }
+
+  UnrolledList(UnrolledList &&move) : m_Alloc(std::move(move.m_Alloc)) {
+    steal(move);
+  }
+
+  ~UnrolledList() { clear(); }
+
+  UnrolledList &operator=(UnrolledList const &copy) {
+    if (this != &copy) {
+      clear();
+      if constexpr (node_traits::propagate_on_container_copy_assignment::
+                        value) {
+        m_Alloc = copy.m_Alloc;
+      }
+      copy_from(copy);
+    }
+    return *this;
+  }
+
+  UnrolledList &operator=(UnrolledList &&move) {
+    if (this != &move) {
+      clear();
+      if constexpr (!node_traits::propagate_on_container_move_assignment::
+                        value) {
+        // The nodes belong to another resource, so move the elements.
+        if (!(m_Alloc == move.m_Alloc)) {
+          for (T &val : move) {
+            push_back(std::move(val));
+          }
+          move.clear();
+          return *this;
+        }
+      } else {
+        m_Alloc = std::move(move.m_Alloc);
+      }
+      steal(move);
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator() const { return allocator_type(m_Alloc); }
+
+  size_type size() const { return m_Size; }
+
+  bool empty() const { return (m_Size == 0); }
+
+  iterator begin() { return iterator{m_Header.next, 0}; }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator cbegin() const { return const_iterator{m_Header.next, 0}; }
+
+  iterator end() { return iterator{end_link(), 0}; }
+  const_iterator end() const { return cend(); }
+  const_iterator cend() const { return const_iterator{end_link(), 0}; }
+
+  T &front() {
+    assert(!empty());
+    return *begin();
+  }
+
+  T const &front() const {
+    assert(!empty());
+    return *begin();
+  }
+
+  T &back() {
+    assert(!empty());
+    return *--end();
+  }
+
+  T const &back() const {
+    assert(!empty());
+    return *--end();
+  }
+
+  // Modifiers
+
+  void clear() {
+    linkptr_type link = m_Header.next;
+    while (link != &m_Header) {
+      nodeptr_type current = node(link);
+      link = link->next;
+      destroy(current->data(), current->data() + current->m_Count);
+      deallocate_node(current);
+    }
+    m_Header.prev = &m_Header;
+    m_Header.next = &m_Header;
+    m_Size = 0;
+  }
+
+  void push_back(T const &val) { emplace_back(val); }
+
+  void push_back(T &&val) { emplace_back(std::move(val)); }
+
+  template <typename... Args>
+  void emplace_back(Args &&...args) {
+    linkptr_type last = m_Header.prev;
+    if (last != &m_Header && node(last)->m_Count < NodeCapacity) {
+      emplace_in(node(last), node(last)->m_Count, std::forward<Args>(args)...);
+    } else {
+      emplace_in_new_node(&m_Header, std::forward<Args>(args)...);
+    }
+  }
+
+  void push_front(T const &val) { emplace_front(val); }
+
+  void push_front(T &&val) { emplace_front(std::move(val)); }
+
+  template <typename... Args>
+  void emplace_front(Args &&...args) {
+    linkptr_type first = m_Header.next;
+    if (first != &m_Header && node(first)->m_Count < NodeCapacity) {
+      emplace_in(node(first), 0, std::forward<Args>(args)...);
+    } else {
+      emplace_in_new_node(first, std::forward<Args>(args)...);
+    }
+  }
+
+  void pop_back() {
+    if (!empty()) {
+      erase(const_iterator{m_Header.prev, node(m_Header.prev)->m_Count - 1});
+    }
+  }
+
+  void pop_front() {
+    if (!empty()) {
+      erase(cbegin());
+    }
+  }
+
+  iterator insert(const_iterator pos, T const &val) {
+    return emplace(pos, val);
+  }
+
+  iterator insert(const_iterator pos, T &&val) {
+    return emplace(pos, std::move(val));
+  }
+
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    if (pos.m_Node == end_link()) {
+      emplace_back(std::forward<Args>(args)...);
+      return iterator{m_Header.prev, node(m_Header.prev)->m_Count - 1};
+    }
+
+    nodeptr_type target = node(pos.m_Node);
+    size_type index = pos.m_Index;
+
+    if (target->m_Count == NodeCapacity) {
+      // At the front of a full node, the previous node may have room.
+      linkptr_type prev = target->prev;
+      if (index == 0 && prev != &m_Header &&
+          node(prev)->m_Count < NodeCapacity) {
+        target = node(prev);
+        index = target->m_Count;
+      } else {
+        nodeptr_type upper = split(target);
+        if (index > target->m_Count) {
+          index -= target->m_Count;
+          target = upper;
+        }
+      }
+    }
+
+    emplace_in(target, index, std::forward<Args>(args)...);
+    return iterator{target, index};
+  }
+
+  iterator erase(const_iterator pos) {
+    nodeptr_type target = node(pos.m_Node);
+    size_type index = pos.m_Index;
+
+    T *slot = target->data() + index;
+    std::destroy_at(slot);
+    relocate(slot + 1, target->m_Count - index - 1, slot);
+    --target->m_Count;
+    --m_Size;
+
+    if (target->m_Count == 0) {
+      linkptr_type next = target->next;
+      free_node(target);
+      return iterator{next, 0};
+    }
+
+    if (target->m_Count < NodeCapacity / 4) {
+      merge_sparse(target, index);
+    }
+    if (index == target->m_Count) {
+      return iterator{target->next, 0};
+    }
+    return iterator{target, index};
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type count = 0;
+    for (const_iterator it = first; it != last; ++it) {
+      ++count;
+    }
+    // Erasing may move elements between nodes, so `last` cannot be used as
+    // the stopping point.
+    iterator pos{first.m_Node, first.m_Index};
+    while (count-- > 0) {
+      pos = erase(pos);
+    }
+    return pos;
+  }
+
+private:
+  using node_t = internal::unrolled_node<T, NodeCapacity>;
+  using node_allocator_t = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<node_t>;
+  using node_traits = std::allocator_traits<node_allocator_t>;
+
+  static nodeptr_type node(linkptr_type link) {
+    return static_cast<nodeptr_type>(link);
+  }
+
+  // Const traversal hands out the header through const_iterator, which
+  // never writes through it.
+  linkptr_type end_link() const {
+    return const_cast<linkptr_type>(&m_Header);
+  }
+
+  // Allocates an empty node and links it before `pos`.
+  nodeptr_type new_node_before(linkptr_type pos) {
+    nodeptr_type created = node_traits::allocate(m_Alloc, 1);
+    // Default-initialized, so the slots are left untouched.
+    new (created) node_t;
+    created->prev = pos->prev;
+    created->next = pos;
+    pos->prev->next = created;
+    pos->prev = created;
+    return created;
+  }
+
+  void deallocate_node(nodeptr_type target) {
+    std::destroy_at(target);
+    node_traits::deallocate(m_Alloc, target, 1);
+  }
+
+  // Unlinks and frees a node whose elements are already gone.
+  void free_node(nodeptr_type target) {
+    target->prev->next = target->next;
+    target->next->prev = target->prev;
+    deallocate_node(target);
+  }
+
+  // Constructs an element at `index` of a node that has room, shifting the
+  // ones after it up by one.
+  template <typename... Args>
+  void emplace_in(nodeptr_type target, size_type index, Args &&...args) {
+    T *slot = target->data() + index;
+    if (index == target->m_Count) {
+      std::construct_at(slot, std::forward<Args>(args)...);
+    } else {
+      T value(std::forward<Args>(args)...);
+      relocate(slot, target->m_Count - index, slot + 1);
+      std::construct_at(slot, std::move(value));
+    }
+    ++target->m_Count;
+    ++m_Size;
+  }
+
+  // The value is built before the node, so a throwing constructor leaves
+  // no empty node behind.
+  template <typename... Args>
+  void emplace_in_new_node(linkptr_type pos, Args &&...args) {
+    T value(std::forward<Args>(args)...);
+    nodeptr_type created = new_node_before(pos);
+    std::construct_at(created->data(), std::move(value));
+    created->m_Count = 1;
+    ++m_Size;
+  }
+
+  // Moves the upper half of a full node into a new node after it.
+  nodeptr_type split(nodeptr_type target) {
+    nodeptr_type upper = new_node_before(target->next);
+    size_type keep = NodeCapacity / 2;
+    relocate(target->data() + keep, NodeCapacity - keep, upper->data());
+    upper->m_Count = NodeCapacity - keep;
+    target->m_Count = keep;
+    return upper;
+  }
+
+  // Folds a sparse node into a neighbour with room for all of it. `target`
+  // and `index` are updated to where the element at `index` ended up.
+  void merge_sparse(nodeptr_type &target, size_type &index) {
+    linkptr_type next = target->next;
+    if (next != &m_Header &&
+        target->m_Count + node(next)->m_Count <= NodeCapacity) {
+      nodeptr_type from = node(next);
+      relocate(from->data(), from->m_Count, target->data() + target->m_Count);
+      target->m_Count += from->m_Count;
+      free_node(from);
+      return;
+    }
+
+    linkptr_type prev = target->prev;
+    if (prev != &m_Header &&
+        target->m_Count + node(prev)->m_Count <= NodeCapacity) {
+      nodeptr_type into = node(prev);
+      relocate(target->data(), target->m_Count, into->data() + into->m_Count);
+      index += into->m_Count;
+      into->m_Count += target->m_Count;
+      free_node(target);
+      target = into;
+    }
+  }
+
+  void copy_from(UnrolledList const &other) {
+    for (T const &val : other) {
+      push_back(val);
+    }
+  }
+
+  // Takes the nodes of `other`, which must use an equal allocator. The
+  // first and last nodes point at the header, which lives inside the list.
+  void steal(UnrolledList &other) {
+    if (other.empty()) {
+      m_Header.prev = &m_Header;
+      m_Header.next = &m_Header;
+      m_Size = 0;
+      return;
+    }
+
+    m_Header = other.m_Header;
+    m_Header.next->prev = &m_Header;
+    m_Header.prev->next = &m_Header;
+    m_Size = other.m_Size;
+
+    other.m_Header.prev = &other.m_Header;
+    other.m_Header.next = &other.m_Header;
+    other.m_Size = 0;
+  }
+
+private:
+  [[no_unique_address]] node_allocator_t m_Alloc;
+  internal::unrolled_link m_Header;
+  size_type m_Size;
+};
+
+namespace pmr {
+
+template <typename T,
+          std::size_t NodeCapacity = internal::unrolled_node_capacity<T>()>
+using UnrolledList =
+    mystl::UnrolledList<T, NodeCapacity, PolymorphicAllocator<T>>;
+
+} // namespace pmr
+
+} // namespace mystl
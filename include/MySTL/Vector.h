@@ -1,14 +1,52 @@
 #pragma once
 
+#include "Allocator.h"
+#include "GrowthPolicy.h"
 #include "Iterator.h"
+#include "Memory.h"
+#include "MemoryResource.h"
 #include "MySTL/algorithms.h"
+#include <concepts>
+#include <cstddef>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 namespace mystl {
 
+namespace internal {
+
+// Storage for the elements a Vector keeps inside itself. Without any, it is
+// an empty member and the Vector is just its three words.
+template <typename T, std::size_t N>
+struct inline_buffer {
+  T *data() { return std::launder(reinterpret_cast<T *>(m_Bytes)); }
+  T const *data() const {
+    return std::launder(reinterpret_cast<T const *>(m_Bytes));
+  }
+
+  alignas(T) std::byte m_Bytes[N * sizeof(T)];
+};
+
 template <typename T>
+struct inline_buffer<T, 0> {
+  constexpr T *data() { return nullptr; }
+  constexpr T const *data() const { return nullptr; }
+};
+
+} // namespace internal
+
+// With an InlineCapacity, up to that many elements are kept inside the
+// object itself and the heap is only used once the vector grows past it
+// (see SmallVector). Moving a vector whose elements are inline moves the
+// elements.
+template <typename T, typename GrowthPolicy = GeometricGrowth<>,
+          typename Allocator = mystl::Allocator<T>,
+          std::size_t InlineCapacity = 0>
 class Vector {
 public:
   using value_type = T;
@@ -20,77 +58,136 @@ public:
   using difference_type = std::ptrdiff_t;
   using size_type = std::size_t;
 
-  using iterator = ContiguousIterator<Vector<T>>;
-  using const_iterator = ConstContiguousIterator<Vector<T>>;
+  using growth_policy = GrowthPolicy;
+  using allocator_type = Allocator;
+
+  using iterator = ContiguousIterator<Vector>;
+  using const_iterator = ConstContiguousIterator<Vector>;
 
 public:
-  constexpr explicit Vector() : m_Capacity(0), m_Size(0), m_Data(nullptr) {}
+  constexpr explicit Vector() : Vector(Allocator{}) {}
+
+  constexpr explicit Vector(Allocator const &alloc)
+      : m_Allocator(alloc), m_Capacity(InlineCapacity), m_Size(0),
+        m_Data(nullptr) {
+    // Only now is m_Inline constructed.
+    m_Data = m_Inline.data();
+  }
+
+  constexpr explicit Vector(size_type size, const T &val = T{},
+                            Allocator const &alloc = Allocator{})
+      : Vector(alloc) {
+    realloc_and_resize(size);
+    uninitialized_fill(m_Data, m_Data + size, val);
+  }
 
-  constexpr explicit Vector(size_type size, const T &val = T{}) : Vector{} {
+  // Default-initializes the elements, so trivial ones are left unwritten.
+  constexpr explicit Vector(size_type size, default_init_t,
+                            Allocator const &alloc = Allocator{})
+      : Vector(alloc) {
     realloc_and_resize(size);
-    algo::fill(m_Data, m_Data + size, val);
+    uninitialized_default_construct(m_Data, m_Data + size);
   }
 
-  constexpr explicit Vector(std::initializer_list<T> iList) : Vector{} {
+  constexpr explicit Vector(std::initializer_list<T> iList,
+                            Allocator const &alloc = Allocator{})
+      : Vector(alloc) {
     realloc_and_resize(iList.size());
-    algo::copy(iList.begin(), iList.end(), m_Data);
+    uninitialized_copy(iList.begin(), iList.end(), m_Data);
   }
 
-  constexpr explicit Vector(const Vector<T> &copy) : Vector{} {
+  constexpr explicit Vector(const Vector &copy)
+      : Vector(alloc_traits::select_on_container_copy_construction(
+            copy.m_Allocator)) {
     realloc_and_resize(copy.m_Size);
-    algo::copy(copy.begin(), copy.end(), m_Data);
+    uninitialized_copy(copy.m_Data, copy.m_Data + copy.m_Size, m_Data);
   }
 
-  constexpr explicit Vector(Vector<T> &&move)
-      : m_Capacity(move.m_Capacity), m_Size(move.m_Size), m_Data(move.m_Data) {
-    move.m_Data = nullptr;
+  constexpr explicit Vector(Vector &&move)
+      : Vector(std::move(move.m_Allocator)) {
+    steal(move);
   }
 
   constexpr ~Vector() { clear(); }
 
-  constexpr Vector &operator=(const Vector<T> &copy) {
+  constexpr Vector &operator=(const Vector &copy) {
     if (this != &copy) {
-      deallocate();
+      clear();
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                        value) {
+        m_Allocator = copy.m_Allocator;
+      }
       realloc_and_resize(copy.m_Size);
-      algo::copy(copy.begin(), copy.end(), m_Data);
+      uninitialized_copy(copy.m_Data, copy.m_Data + copy.m_Size, m_Data);
     }
     return *this;
   }
 
-  constexpr Vector &operator=(Vector<T> &&move) {
+  constexpr Vector &operator=(Vector &&move) {
     if (this != &move) {
-      deallocate();
-      m_Capacity = move.m_Capacity;
-      m_Size = move.m_Size;
-      m_Data = move.m_Data;
-      move.m_Data = nullptr;
+      clear();
+      if constexpr (!alloc_traits::propagate_on_container_move_assignment::
+                        value) {
+        // The buffer belongs to another resource, so move the elements.
+        if (!(m_Allocator == move.m_Allocator)) {
+          realloc_and_resize(move.m_Size);
+          relocate(move.m_Data, move.m_Size, m_Data);
+          move.m_Size = 0;
+          move.clear();
+          return *this;
+        }
+      } else {
+        m_Allocator = std::move(move.m_Allocator);
+      }
+      steal(move);
     }
     return *this;
   }
 
+  constexpr allocator_type get_allocator() const { return m_Allocator; }
+
   constexpr size_type capacity() const { return m_Capacity; }
 
   constexpr size_type size() const { return m_Size; }
 
   constexpr bool empty() const { return (m_Size == 0); }
 
+  static constexpr size_type inline_capacity() { return InlineCapacity; }
+
+  // True while the elements are stored inside the object.
+  constexpr bool is_inline() const {
+    if constexpr (InlineCapacity == 0) {
+      return false;
+    } else {
+      return m_Data == m_Inline.data();
+    }
+  }
+
+  constexpr pointer data() { return m_Data; }
+  constexpr const_pointer data() const { return m_Data; }
+
   constexpr iterator begin() { return iterator{m_Data}; }
   constexpr const_iterator begin() const { return cbegin(); }
   constexpr const_iterator cbegin() const { return const_iterator{m_Data}; }
 
   constexpr iterator end() { return iterator{m_Data + m_Size}; }
   constexpr const_iterator end() const { return cend(); }
-  constexpr const_iterator cend() { return const_iterator{m_Data + m_Size}; }
+  constexpr const_iterator cend() const {
+    return const_iterator{m_Data + m_Size};
+  }
 
   constexpr void reserve(size_type capacity) {
-    // Do not use reallocate
-    T *newData = new T[capacity];
-    for (int i = 0; i < m_Size; ++i) {
-      newData[i] = std::move(m_Data[i]);
+    if (capacity > m_Capacity) {
+      reallocate(capacity);
+    }
+  }
+
+  // Releases all unused heap capacity, regardless of the growth policy,
+  // moving back inline when the elements fit.
+  constexpr void shrink_to_fit() {
+    if (!is_inline() && m_Size < m_Capacity) {
+      reallocate(m_Size);
     }
-    deallocate();
-    m_Data = newData;
-    m_Capacity = capacity;
   }
 
   template <typename Self>
@@ -120,39 +217,78 @@ public:
   // Modifiers
 
   constexpr void clear() {
-    for (std::size_t i = 0; i < m_Size; ++i) {
-      m_Data[i].~T();
-    }
+    destroy(m_Data, m_Data + m_Size);
     deallocate();
-    m_Capacity = 0;
+    m_Capacity = InlineCapacity;
     m_Size = 0;
-    m_Data = nullptr;
+    m_Data = m_Inline.data();
   }
 
-  // TODO: add iterator versions
-
   constexpr void insert(size_type pos, const T &val = T{},
                         size_type count = 1) {
-    size_t newSize = algo::max(m_Size, pos) + count;
-    size_t oldSize = m_Size;
+    size_type newSize = algo::max(m_Size, pos) + count;
+    size_type oldSize = m_Size;
 
-    if (newSize > m_Capacity) {
-      realloc_and_resize(newSize);
-    }
+    grow_to(newSize);
 
     // if pos > current size, default init the gap values
-    algo::fill(m_Data + oldSize, m_Data + pos, T{});
+    if (pos > oldSize) {
+      if constexpr (std::is_default_constructible_v<T>) {
+        uninitialized_fill(m_Data + oldSize, m_Data + pos, T{});
+      } else {
+        throw std::out_of_range("Vector insert past the end");
+      }
+    }
 
     // if pos is in the array, move the current values to offset amount
     // make room for the new values
     if (pos < oldSize) {
-      size_type offset = oldSize - pos;
-      for (size_type i = 1; i <= count; ++i) {
-        m_Data[newSize - i] = std::move(m_Data[pos + offset - i]);
+      relocate(m_Data + pos, oldSize - pos, m_Data + pos + count);
+    }
+
+    uninitialized_fill(m_Data + pos, m_Data + pos + count, val);
+    m_Size = newSize;
+  }
+
+  // Inserts [first, last) before pos. Multi-pass ranges are measured first,
+  // so the buffer is reallocated at most once and the tail moved once.
+  template <std::input_iterator Iter_t>
+  constexpr iterator insert(const_iterator pos, Iter_t first, Iter_t last) {
+    size_type index = static_cast<size_type>(pos.m_ProxyData - m_Data);
+
+    if constexpr (internal::single_pass_iterator<Iter_t>) {
+      Vector buffered(m_Allocator);
+      while (first != last) {
+        buffered.emplace_back(*first);
+        ++first;
       }
+      insert_counted(index, buffered.m_Size,
+                     std::make_move_iterator(buffered.m_Data));
+    } else {
+      auto count = static_cast<size_type>(algo::distance(first, last));
+      insert_counted(index, count, internal::unwrap_contiguous(first));
     }
+    return iterator{m_Data + index};
+  }
+
+  template <typename Range_t>
+  constexpr iterator insert_range(const_iterator pos, Range_t &&range) {
+    using std::begin;
+    using std::end;
+    return insert(pos, begin(range), end(range));
+  }
+
+  template <typename Range_t>
+  constexpr void append_range(Range_t &&range) {
+    insert_range(cend(), std::forward<Range_t>(range));
+  }
 
-    algo::fill(m_Data + pos, m_Data + pos + count, val);
+  // Replaces the contents with the range, allocating at most once.
+  template <typename Range_t>
+  constexpr void assign_range(Range_t &&range) {
+    destroy(m_Data, m_Data + m_Size);
+    m_Size = 0;
+    append_range(std::forward<Range_t>(range));
   }
 
   constexpr void erase(size_type pos, size_type count = 1) {
@@ -162,39 +298,25 @@ public:
 
     count = algo::min(m_Size - pos, count);
 
-    for (size_type i = pos; i < m_Size - count; ++i) {
-      m_Data[i] = std::move(m_Data[i + count]);
-    }
-
+    destroy(m_Data + pos, m_Data + pos + count);
+    relocate(m_Data + pos + count, m_Size - pos - count, m_Data + pos);
     m_Size -= count;
 
-    if ((m_GrowthFactor * m_Size < m_Capacity) ||
-        (m_Size < m_Capacity - m_MaxSizeDiff))
-      reallocate();
+    shrink_if_sparse();
   }
 
-  constexpr void push_back(const T &val) {
-    if (m_Size + 1 >= m_Capacity) {
-      reallocate(true);
-    }
-    m_Data[m_Size] = std::move(val);
-    m_Size++;
-  }
+  constexpr void push_back(const T &val) { emplace_back(val); }
 
-  constexpr void push_back(T &&val) {
-    if (m_Size + 1 >= m_Capacity) {
-      reallocate(true);
-    }
-    m_Data[m_Size] = std::move(val);
-    m_Size++;
-  }
+  constexpr void push_back(T &&val) { emplace_back(std::move(val)); }
 
   template <typename... Args>
   constexpr void emplace_back(Args &&...args) {
-    if (m_Size + 1 >= m_Capacity) {
-      reallocate();
+    if (m_Size == m_Capacity) [[unlikely]] {
+      grow_and_emplace_back(std::forward<Args>(args)...);
+      return;
     }
-    new (&m_Data[m_Size++]) T{std::forward<Args>(args)...};
+    new (&m_Data[m_Size]) T{std::forward<Args>(args)...};
+    m_Size++;
   }
 
   constexpr void pop_back() {
@@ -202,64 +324,283 @@ public:
       return;
     }
 
-    delete &m_Data[m_Size - 1];
+    m_Data[m_Size - 1].~T();
     --m_Size;
-    if ((m_GrowthFactor * m_Size < m_Capacity) ||
-        (m_Size < m_Capacity - m_MaxSizeDiff))
-      reallocate();
+    shrink_if_sparse();
   }
 
   void resize(size_type size, const T &val = T{}) {
     if (size == m_Size) {
       return;
     }
+    if (size < m_Size) {
+      erase(size, m_Size - size);
+      return;
+    }
     size_type oldSize = m_Size;
     realloc_and_resize(size);
-    algo::fill(m_Data + oldSize, m_Data + size, val);
+    uninitialized_fill(m_Data + oldSize, m_Data + size, val);
+  }
+
+  // Like resize(), but new elements are default-initialized instead of
+  // copied from a value. Meant for buffers that are overwritten right away,
+  // so shrinking keeps the capacity.
+  void resize_for_overwrite(size_type size) {
+    if (size <= m_Size) {
+      destroy(m_Data + size, m_Data + m_Size);
+      m_Size = size;
+      return;
+    }
+    size_type oldSize = m_Size;
+    realloc_and_resize(size);
+    uninitialized_default_construct(m_Data + oldSize, m_Data + size);
+  }
+
+  // Grows to `size` elements without initializing the new ones, then lets
+  // `op(data(), size)` write into the buffer. op returns how many elements
+  // are actually in use, and the vector is cut to that. A count below zero
+  // or above `size` throws std::out_of_range; then, or if op throws, size()
+  // is left as it was. The capacity is kept, since the buffer is usually
+  // overwritten again soon:
+  //
+  //   buffer.resize_and_overwrite(4096, [&](char *data, std::size_t n) {
+  //     ssize_t got = ::read(fd, data, n);
+  //     if (got < 0) {
+  //       throw std::system_error(errno, std::generic_category());
+  //     }
+  //     return static_cast<std::size_t>(got);
+  //   });
+  template <typename Operation>
+  void resize_and_overwrite(size_type size, Operation op) {
+    size_type oldSize = m_Size;
+    size_type live = size > oldSize ? size : oldSize;
+    if (size > oldSize) {
+      grow_to(size);
+      uninitialized_default_construct(m_Data + oldSize, m_Data + size);
+    }
+
+    auto discard_new = [&] { destroy(m_Data + oldSize, m_Data + live); };
+    auto used = [&] {
+      try {
+        return op(m_Data, size);
+      } catch (...) {
+        discard_new();
+        throw;
+      }
+    }();
+    if constexpr (std::is_signed_v<decltype(used)>) {
+      if (used < 0) {
+        discard_new();
+        throw std::out_of_range("resize_and_overwrite used a negative size");
+      }
+    }
+    if (static_cast<size_type>(used) > size) {
+      discard_new();
+      throw std::out_of_range("resize_and_overwrite used more than size");
+    }
+
+    destroy(m_Data + static_cast<size_type>(used), m_Data + live);
+    m_Size = static_cast<size_type>(used);
   }
 
 private:
+  // Takes the elements of `other`, which must use an equal allocator.
+  // Inline elements have to be moved; a heap buffer changes hands.
+  void steal(Vector &other) {
+    if (other.is_inline()) {
+      relocate(other.m_Data, other.m_Size, m_Data);
+      m_Size = other.m_Size;
+    } else {
+      m_Capacity = other.m_Capacity;
+      m_Size = other.m_Size;
+      m_Data = other.m_Data;
+    }
+    other.m_Capacity = InlineCapacity;
+    other.m_Size = 0;
+    other.m_Data = other.m_Inline.data();
+  }
+
   void reallocate(size_type newCapacity) {
-    if (newCapacity - m_Size > m_MaxSizeDiff) {
-      newCapacity = m_Size + m_MaxSizeDiff;
+    if (newCapacity <= InlineCapacity) {
+      // Only reached when shrinking, back inline or (without inline
+      // storage) to nothing.
+      if constexpr (InlineCapacity > 0) {
+        if (!is_inline()) {
+          relocate(m_Data, m_Size, m_Inline.data());
+          deallocate();
+          m_Data = m_Inline.data();
+          m_Capacity = InlineCapacity;
+        }
+      } else {
+        deallocate();
+        m_Data = nullptr;
+        m_Capacity = 0;
+      }
+      return;
     }
 
-    T *newData = (T *)::operator new(newCapacity * sizeof(T));
-    for (size_type i = 0; i < m_Size; ++i) {
-      newData[i] = std::move(m_Data[i]);
-      m_Data[i].~T();
+    if constexpr (m_CanReallocInPlace) {
+      // realloc either grows the block in place or does the memcpy for us.
+      if (m_Data != nullptr && !is_inline()) {
+        m_Data = m_Allocator.reallocate(m_Data, m_Capacity, newCapacity);
+        m_Capacity = newCapacity;
+        return;
+      }
     }
 
+    pointer newData = allocate(newCapacity);
+    relocate(m_Data, m_Size, newData);
+
     deallocate();
     m_Data = newData;
     m_Capacity = newCapacity;
   }
 
-  void reallocate(bool increaseSize = false) {
-    auto newSize = m_GrowthFactor * (static_cast<float>(m_Size) +
-                                     static_cast<float>(increaseSize));
-    reallocate(static_cast<size_type>(newSize));
+  // Growing frees the old buffer, which `args` may refer into, as in
+  // vec.push_back(vec[0]). The new element is therefore built before the old
+  // buffer goes: into the new buffer, or into a temporary when realloc may
+  // free the old block itself.
+  template <typename... Args>
+  void grow_and_emplace_back(Args &&...args) {
+    size_type newCapacity = GrowthPolicy::grow(m_Capacity, m_Size + 1);
+    if constexpr (m_CanReallocInPlace) {
+      if (m_Data != nullptr && !is_inline()) {
+        T value{std::forward<Args>(args)...};
+        reallocate(newCapacity);
+        new (&m_Data[m_Size]) T(std::move(value));
+        m_Size++;
+        return;
+      }
+    }
+
+    pointer newData = allocate(newCapacity);
+    try {
+      new (&newData[m_Size]) T{std::forward<Args>(args)...};
+    } catch (...) {
+      alloc_traits::deallocate(m_Allocator, newData, newCapacity);
+      throw;
+    }
+    relocate(m_Data, m_Size, newData);
+
+    deallocate();
+    m_Data = newData;
+    m_Capacity = newCapacity;
+    m_Size++;
+  }
+
+  // Opens a gap of `count` elements at `index` and copies `first...` into
+  // it. When the buffer has to grow, the two halves are relocated straight
+  // into the new buffer around the gap. If a copy throws, the vector is left
+  // as it was.
+  template <typename Iter_t>
+  void insert_counted(size_type index, size_type count, Iter_t first) {
+    if (count == 0) {
+      return;
+    }
+
+    size_type oldSize = m_Size;
+    if constexpr (m_CanReallocInPlace) {
+      // Growing in place beats relocating both halves into a new block.
+      grow_to(oldSize + count);
+    }
+
+    if (oldSize + count > m_Capacity) {
+      size_type newCapacity = GrowthPolicy::grow(m_Capacity, oldSize + count);
+      pointer newData = allocate(newCapacity);
+      try {
+        uninitialized_copy_n(first, count, newData + index);
+      } catch (...) {
+        alloc_traits::deallocate(m_Allocator, newData, newCapacity);
+        throw;
+      }
+      relocate(m_Data, index, newData);
+      relocate(m_Data + index, oldSize - index, newData + index + count);
+
+      deallocate();
+      m_Data = newData;
+      m_Capacity = newCapacity;
+    } else {
+      relocate(m_Data + index, oldSize - index, m_Data + index + count);
+      try {
+        uninitialized_copy_n(first, count, m_Data + index);
+      } catch (...) {
+        // Close the gap again, so the vector is as it was.
+        relocate(m_Data + index + count, oldSize - index, m_Data + index);
+        throw;
+      }
+    }
+    m_Size = oldSize + count;
+  }
+
+  // Makes room for at least `required` elements, growing by the policy.
+  void grow_to(size_type required) {
+    if (required > m_Capacity) {
+      reallocate(GrowthPolicy::grow(m_Capacity, required));
+    }
+  }
+
+  void shrink_if_sparse() {
+    if (is_inline()) {
+      return;
+    }
+    size_type newCapacity = GrowthPolicy::shrink(m_Size, m_Capacity);
+    if (newCapacity < m_Capacity) {
+      reallocate(newCapacity);
+    }
+  }
+
+  pointer allocate(size_type capacity) {
+    if (capacity == 0) {
+      return nullptr;
+    }
+    return alloc_traits::allocate(m_Allocator, capacity);
   }
 
   void deallocate() {
-    // Deallocate does not attemp to set m_Size and m_Capacity to valid data
-    // ::operator delete(m_Data, m_Capacity * sizeof(T));
-    ::operator delete(m_Data);
+    // Deallocate does not attempt to set m_Size and m_Capacity to valid data
+    if (m_Data != nullptr && !is_inline()) {
+      alloc_traits::deallocate(m_Allocator, m_Data, m_Capacity);
+    }
   }
 
   void realloc_and_resize(size_type newSize) {
-    auto newCapacity = m_GrowthFactor * static_cast<float>(newSize);
-    reallocate(static_cast<size_type>(newCapacity));
+    grow_to(newSize);
     m_Size = newSize;
   }
 
 private:
-  static constexpr float m_GrowthFactor = 1.5f;
-  static constexpr float m_MaxSizeDiff = 50.0f;
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  // Allocators with a reallocate() member (the default one uses realloc) can
+  // resize the buffer in place when the elements may be moved bytewise.
+  static constexpr bool m_CanReallocInPlace =
+      is_trivially_relocatable_v<T> &&
+      requires(Allocator &alloc, T *data, size_type count) {
+        { alloc.reallocate(data, count, count) } -> std::same_as<T *>;
+      };
 
+  [[no_unique_address]] Allocator m_Allocator;
   size_type m_Capacity;
   size_type m_Size;
   pointer m_Data;
+  [[no_unique_address]] internal::inline_buffer<T, InlineCapacity> m_Inline;
 };
 
+// Vector whose data() is aligned to Alignment bytes, for SIMD kernels.
+template <typename T, std::size_t Alignment = 64>
+using AlignedVector =
+    Vector<T, GeometricGrowth<>, AlignedAllocator<T, Alignment>>;
+
+// Vector whose large buffers are backed by transparent huge pages.
+template <typename T, std::size_t Alignment = 64>
+using HugePageVector =
+    Vector<T, GeometricGrowth<>, HugePageAllocator<T, Alignment>>;
+
+namespace pmr {
+
+template <typename T, typename GrowthPolicy = GeometricGrowth<>>
+using Vector = mystl::Vector<T, GrowthPolicy, PolymorphicAllocator<T>>;
+
+} // namespace pmr
+
 } // namespace mystl
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "Concurrency.h"
+#include "MySTL/algorithms.h"
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace mystl {
+
+// Chase-Lev work-stealing deque, in the C11 formulation of Lê et al. (2013).
+// One owner thread uses it like a Stack: push() and pop() work LIFO on the
+// bottom end and only synchronize with thieves when a single element is
+// left. Any other thread may steal() FIFO from the top end with one CAS.
+//
+// The slots grow by doubling. A thief may still be reading the old slots
+// after the owner has switched to new ones, so the old buffers are kept,
+// chained behind the current one, until the deque is destroyed; they add up
+// to less than the current buffer.
+//
+// A thief reads its element before its CAS decides whether it may have it,
+// so elements are copied bytewise and must be trivially copyable; task
+// pointers and indices are the intended use.
+template <typename T>
+class WorkStealingDeque {
+public:
+  static_assert(std::is_trivially_copyable_v<T>,
+                "WorkStealingDeque elements are copied racily");
+
+  using value_type = T;
+  using size_type = std::size_t;
+
+public:
+  // The capacity is rounded up to a power of two.
+  explicit WorkStealingDeque(size_type capacity = 64)
+      : m_Buffer(new Buffer(std::bit_ceil(algo::max(capacity, size_type{2})),
+                            nullptr)) {}
+
+  WorkStealingDeque(WorkStealingDeque const &) = delete;
+  WorkStealingDeque &operator=(WorkStealingDeque const &) = delete;
+
+  ~WorkStealingDeque() {
+    Buffer *buffer = m_Buffer.load(std::memory_order_relaxed);
+    while (buffer != nullptr) {
+      Buffer *previous = buffer->m_Previous;
+      delete buffer;
+      buffer = previous;
+    }
+  }
+
+  size_type capacity() const {
+    return m_Buffer.load(std::memory_order_relaxed)->capacity();
+  }
+
+  // Only a snapshot while other threads are running.
+  size_type size() const {
+    std::int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+    std::int64_t top = m_Top.load(std::memory_order_relaxed);
+    return static_cast<size_type>(algo::max(bottom - top, std::int64_t{0}));
+  }
+
+  bool empty() const { return size() == 0; }
+
+  // Owner only.
+  void push(T const &val) {
+    std::int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+    std::int64_t top = m_Top.load(std::memory_order_acquire);
+    Buffer *buffer = m_Buffer.load(std::memory_order_relaxed);
+    if (bottom - top > static_cast<std::int64_t>(buffer->m_Mask)) {
+      buffer = grow(buffer, top, bottom);
+    }
+    buffer->store(bottom, val);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  // Owner only. Takes the most recently pushed element; false when empty or
+  // when a thief won the race for the last one.
+  bool pop(T &out) {
+    std::int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+    Buffer *buffer = m_Buffer.load(std::memory_order_relaxed);
+    m_Bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = m_Top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      // Empty: undo the reservation.
+      m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+
+    out = buffer->load(bottom);
+    if (top == bottom) {
+      // The last element; thieves may be after it too.
+      bool won = m_Top.compare_exchange_strong(
+          top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+  // Any thread. Takes the oldest element; false when empty or when another
+  // thread got it first, in which case retrying may succeed.
+  bool steal(T &out) {
+    std::int64_t top = m_Top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+
+    if (top >= bottom) {
+      return false;
+    }
+
+    Buffer *buffer = m_Buffer.load(std::memory_order_acquire);
+    T val = buffer->load(top);
+    if (!m_Top.compare_exchange_strong(top, top + 1,
+                                       std::memory_order_seq_cst,
+                                       std::memory_order_relaxed)) {
+      return false;
+    }
+    out = val;
+    return true;
+  }
+
+private:
+  struct Buffer {
+    Buffer(size_type capacity, Buffer *previous)
+        : m_Mask(capacity - 1),
+          m_Slots(std::make_unique<std::atomic<T>[]>(capacity)),
+          m_Previous(previous) {}
+
+    size_type capacity() const { return m_Mask + 1; }
+
+    T load(std::int64_t index) const {
+      return m_Slots[static_cast<size_type>(index) & m_Mask].load(
+          std::memory_order_relaxed);
+    }
+
+    void store(std::int64_t index, T const &val) {
+      m_Slots[static_cast<size_type>(index) & m_Mask].store(
+          val, std::memory_order_relaxed);
+    }
+
+    size_type const m_Mask;
+    std::unique_ptr<std::atomic<T>[]> m_Slots;
+    // The buffer this one replaced, kept alive for late thieves.
+    Buffer *const m_Previous;
+  };
+
+  Buffer *grow(Buffer *buffer, std::int64_t top, std::int64_t bottom) {
+    auto *bigger = new Buffer(buffer->capacity() * 2, buffer);
+    for (std::int64_t i = top; i < bottom; ++i) {
+      bigger->store(i, buffer->load(i));
+    }
+    m_Buffer.store(bigger, std::memory_order_release);
+    return bigger;
+  }
+
+private:
+  // Written by thieves and, for the last element, the owner.
+  alignas(cache_line_size) std::atomic<std::int64_t> m_Top{0};
+  // Written by the owner only.
+  alignas(cache_line_size) std::atomic<std::int64_t> m_Bottom{0};
+  std::atomic<Buffer *> m_Buffer;
+};
+
+} // namespace mystl
@@ -1,28 +1,113 @@
 #pragma once
 
+#include "Iterator.h"
+#include "Simd.h"
+#include "SimdSearch.h"
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
 namespace mystl::algo {
 
 template <typename T>
-T const &max(T const &a, T const &b) {
+constexpr T const &max(T const &a, T const &b) {
   return a > b ? a : b;
 }
 
 template <typename T>
-T const &min(T const &a, T const &b) {
+constexpr T const &min(T const &a, T const &b) {
   return a < b ? a : b;
 }
 
+namespace internal {
+
+// Element types whose assignment is a byte copy, so whole ranges of them
+// can be moved with memmove/memset.
+template <typename To_t, typename From_t>
+inline constexpr bool is_bytewise_assignable_v =
+    std::is_trivially_copyable_v<To_t> &&
+    std::is_same_v<std::remove_cv_t<To_t>, std::remove_cv_t<From_t>>;
+
+template <typename T>
+bool has_uniform_bytes(T const &value) {
+  unsigned char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  for (std::size_t i = 1; i < sizeof(T); ++i) {
+    if (bytes[i] != bytes[0]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace internal
+
+// Contiguous ranges (raw pointers, any std::contiguous_iterator) of trivially
+// copyable elements are filled with memset when every byte of the value is
+// the same (zeroes, most commonly) and with SIMD stores of the repeated
+// value otherwise. Constant evaluation and other iterators use the loop.
 template <typename Iter_t, typename T>
 constexpr void fill(Iter_t begin, Iter_t end, T value) {
+  auto first = mystl::internal::unwrap_contiguous(begin);
+  using first_t = decltype(first);
+
+  if constexpr (std::is_pointer_v<first_t>) {
+    using elem_t = std::remove_pointer_t<first_t>;
+    if constexpr (internal::is_bytewise_assignable_v<elem_t, T>) {
+      if (!std::is_constant_evaluated()) {
+        auto count = static_cast<std::size_t>(end - begin);
+        if (count == 0) {
+          return;
+        }
+        if (internal::has_uniform_bytes(value)) {
+          unsigned char byte;
+          std::memcpy(&byte, &value, 1);
+          std::memset(static_cast<void *>(first), byte, count * sizeof(T));
+          return;
+        }
+        if constexpr (32 % sizeof(T) == 0) {
+          mystl::internal::fill_pattern(first, count, &value, sizeof(T));
+          return;
+        }
+      }
+    }
+  }
+
   while (begin != end) {
     *begin = value;
     ++begin;
   }
 }
 
+// Contiguous ranges of trivially copyable elements of the same type are
+// copied with one memmove, which the C library already dispatches to the
+// widest vector stores the CPU has (and non-temporal ones for copies
+// larger than the cache). Anything else is copied element by element.
 template <typename FromIter_t, typename ToIter_t>
 constexpr void copy(FromIter_t fromBegin, FromIter_t fromEnd,
                     ToIter_t toBegin) {
+  auto from = mystl::internal::unwrap_contiguous(fromBegin);
+  auto to = mystl::internal::unwrap_contiguous(toBegin);
+
+  if constexpr (std::is_pointer_v<decltype(from)> &&
+                std::is_pointer_v<decltype(to)>) {
+    using from_t = std::remove_pointer_t<decltype(from)>;
+    using to_t = std::remove_pointer_t<decltype(to)>;
+    if constexpr (internal::is_bytewise_assignable_v<to_t, from_t>) {
+      if (!std::is_constant_evaluated()) {
+        auto count = static_cast<std::size_t>(fromEnd - fromBegin);
+        if (count != 0) {
+          std::memmove(static_cast<void *>(to),
+                       static_cast<void const *>(from), count * sizeof(to_t));
+        }
+        return;
+      }
+    }
+  }
+
   while (fromBegin != fromEnd) {
     *toBegin = *fromBegin;
     ++fromBegin;
@@ -30,4 +115,453 @@ constexpr void copy(FromIter_t fromBegin, FromIter_t fromEnd,
   }
 }
 
+template <typename Iter_t, typename Fn>
+constexpr Fn for_each(Iter_t first, Iter_t last, Fn fn) {
+  for (; first != last; ++first) {
+    fn(*first);
+  }
+  return fn;
+}
+
+// Writes op(x) for every x of [first, last) to `dest`, which may be
+// `first` itself.
+template <typename FromIter_t, typename ToIter_t, typename UnaryOp>
+constexpr ToIter_t transform(FromIter_t first, FromIter_t last, ToIter_t dest,
+                             UnaryOp op) {
+  for (; first != last; ++first, ++dest) {
+    *dest = op(*first);
+  }
+  return dest;
+}
+
+// Folds [first, last) into `init` with `op`. The parallel overloads
+// regroup the operations, so `op` should be associative; they never
+// reorder them, so it need not be commutative.
+template <typename Iter_t, typename T, typename BinaryOp = std::plus<>>
+constexpr T reduce(Iter_t first, Iter_t last, T init, BinaryOp op = {}) {
+  for (; first != last; ++first) {
+    init = op(std::move(init), *first);
+  }
+  return init;
+}
+
+// reduce() over transform(first, last) without storing the transformed
+// values.
+template <typename Iter_t, typename T, typename BinaryOp, typename UnaryOp>
+constexpr T transform_reduce(Iter_t first, Iter_t last, T init,
+                             BinaryOp reduceOp, UnaryOp transformOp) {
+  for (; first != last; ++first) {
+    init = reduceOp(std::move(init), transformOp(*first));
+  }
+  return init;
+}
+
+// Pairwise form: folds transformOp(a, b) over [first1, last1) and the range
+// starting at `first2`. Defaults to the inner product.
+template <typename Iter1_t, typename Iter2_t, typename T,
+          typename BinaryOp = std::plus<>,
+          typename BinaryTransform = std::multiplies<>>
+  requires requires(Iter2_t iter) { *iter; }
+constexpr T transform_reduce(Iter1_t first1, Iter1_t last1, Iter2_t first2,
+                             T init, BinaryOp reduceOp = {},
+                             BinaryTransform transformOp = {}) {
+  for (; first1 != last1; ++first1, ++first2) {
+    init = reduceOp(std::move(init), transformOp(*first1, *first2));
+  }
+  return init;
+}
+
+// Writes the running totals of [first, last) to `dest`: the i-th output is
+// op over the first i + 1 inputs. `dest` may be `first` itself.
+template <typename FromIter_t, typename ToIter_t,
+          typename BinaryOp = std::plus<>>
+constexpr ToIter_t inclusive_scan(FromIter_t first, FromIter_t last,
+                                  ToIter_t dest, BinaryOp op = {}) {
+  if (first == last) {
+    return dest;
+  }
+  auto total = *first;
+  *dest = total;
+  for (++first, ++dest; first != last; ++first, ++dest) {
+    total = op(std::move(total), *first);
+    *dest = total;
+  }
+  return dest;
+}
+
+// Number of increments from first to last; O(1) when the iterators can be
+// subtracted.
+template <typename Iter_t>
+constexpr std::ptrdiff_t distance(Iter_t first, Iter_t last) {
+  if constexpr (requires { last - first; }) {
+    return last - first;
+  } else {
+    std::ptrdiff_t count = 0;
+    while (first != last) {
+      ++first;
+      ++count;
+    }
+    return count;
+  }
+}
+
+// `element op value` as a predicate, e.g. less_than(0) for negatives.
+// find_if and count_if see through it: over raw pointers or
+// ContiguousIterator to integers, floats or doubles they compare whole
+// vectors at a time, where an equivalent lambda takes the element-wise loop.
+template <typename Compare, typename T>
+struct compare_with {
+  T m_Value;
+  [[no_unique_address]] Compare m_Compare;
+
+  template <typename U>
+  constexpr bool operator()(U const &element) const {
+    return m_Compare(element, m_Value);
+  }
+};
+
+template <typename T>
+constexpr compare_with<std::equal_to<>, T> equal_to(T value) {
+  return {value, {}};
+}
+
+template <typename T>
+constexpr compare_with<std::not_equal_to<>, T> not_equal_to(T value) {
+  return {value, {}};
+}
+
+template <typename T>
+constexpr compare_with<std::less<>, T> less_than(T value) {
+  return {value, {}};
+}
+
+template <typename T>
+constexpr compare_with<std::less_equal<>, T> at_most(T value) {
+  return {value, {}};
+}
+
+template <typename T>
+constexpr compare_with<std::greater<>, T> greater_than(T value) {
+  return {value, {}};
+}
+
+template <typename T>
+constexpr compare_with<std::greater_equal<>, T> at_least(T value) {
+  return {value, {}};
+}
+
+namespace internal {
+
+template <typename Iter_t>
+using contiguous_t =
+    decltype(mystl::internal::unwrap_contiguous(std::declval<Iter_t>()));
+
+// The element type when Iter_t unwraps to a pointer, Iter_t otherwise.
+template <typename Iter_t>
+using simd_element_t =
+    std::remove_const_t<std::remove_pointer_t<contiguous_t<Iter_t>>>;
+
+// Iterators over arrays the kernels of SimdSearch.h can scan.
+template <typename Iter_t>
+inline constexpr bool is_simd_range_v =
+    std::is_pointer_v<contiguous_t<Iter_t>> &&
+    !std::is_volatile_v<simd_element_t<Iter_t>> &&
+    mystl::internal::is_simd_searchable_v<simd_element_t<Iter_t>>;
+
+template <typename T>
+constexpr bool is_negative(T value) {
+  if constexpr (std::is_signed_v<T>) {
+    return value < 0;
+  } else {
+    return false;
+  }
+}
+
+// Whether comparing Elem_t elements with a T can be done as comparing them
+// with the T converted to Elem_t.
+template <typename Elem_t, typename T>
+constexpr bool is_lane_comparable() {
+  if constexpr (!std::is_arithmetic_v<T>) {
+    return false;
+  } else {
+    return std::is_same_v<std::common_type_t<Elem_t, T>, Elem_t> ||
+           (std::is_integral_v<Elem_t> && std::is_integral_v<T>);
+  }
+}
+
+// `value` as an Elem_t, if `element op value` under the usual arithmetic
+// conversions gives the same answers as `element op Elem_t(value)`. When
+// the conversion is to Elem_t anyway, that is always. Between integers of
+// different types, it is when the value fits Elem_t and the common type
+// keeps every element's value (so not -1 against unsigned elements).
+template <typename Elem_t, typename T>
+constexpr std::optional<Elem_t> as_lane_value(T value) {
+  if constexpr (std::is_same_v<std::common_type_t<Elem_t, T>, Elem_t>) {
+    return static_cast<Elem_t>(value);
+  } else {
+    using common_t = decltype(Elem_t{} + T{});
+    auto lane = static_cast<Elem_t>(value);
+    bool fits = static_cast<T>(lane) == value &&
+                is_negative(lane) == is_negative(value);
+    if (fits && (std::is_signed_v<common_t> || std::is_unsigned_v<Elem_t>)) {
+      return lane;
+    }
+    return std::nullopt;
+  }
+}
+
+// compare_with predicates the kernels evaluate.
+template <typename Pred>
+struct simd_predicate {};
+
+template <typename Compare, typename T>
+struct simd_predicate<compare_with<Compare, T>>
+    : mystl::internal::simd_compare_of<Compare> {
+  using value_type = std::remove_cvref_t<T>;
+};
+
+template <typename Iter_t, typename Pred>
+constexpr bool is_simd_predicate() {
+  if constexpr (is_simd_range_v<Iter_t> &&
+                requires { simd_predicate<Pred>::value; }) {
+    return is_lane_comparable<simd_element_t<Iter_t>,
+                              typename simd_predicate<Pred>::value_type>();
+  } else {
+    return false;
+  }
+}
+
+template <typename Compare, typename T>
+inline constexpr bool is_less_v = std::is_same_v<Compare, std::less<>> ||
+                                  std::is_same_v<Compare, std::less<T>>;
+
+template <typename Compare, typename T>
+inline constexpr bool is_greater_v =
+    std::is_same_v<Compare, std::greater<>> ||
+    std::is_same_v<Compare, std::greater<T>>;
+
+template <typename Iter_t, typename Compare>
+inline constexpr bool is_simd_ordering_v =
+    is_simd_range_v<Iter_t> &&
+    (is_less_v<Compare, simd_element_t<Iter_t>> ||
+     is_greater_v<Compare, simd_element_t<Iter_t>>);
+
+// The smallest and largest element under Compare (std::less, or
+// std::greater, which swaps them) of a non-empty array; false if the
+// kernels do not apply.
+template <typename Compare, typename T>
+bool simd_extremes(T const *data, std::size_t size, T &smallest,
+                   T &largest) {
+  if (!mystl::internal::simd_min_max(data, size, smallest, largest)) {
+    return false;
+  }
+  if constexpr (is_greater_v<Compare, T>) {
+    std::swap(smallest, largest);
+  }
+  return true;
+}
+
+} // namespace internal
+
+template <typename Iter_t, typename Pred>
+constexpr Iter_t find_if(Iter_t first, Iter_t last, Pred pred) {
+  if constexpr (internal::is_simd_predicate<Iter_t, Pred>()) {
+    if (!std::is_constant_evaluated()) {
+      using elem_t = internal::simd_element_t<Iter_t>;
+      if (auto key = internal::as_lane_value<elem_t>(pred.m_Value)) {
+        constexpr auto op = internal::simd_predicate<Pred>::value;
+        auto size = static_cast<std::size_t>(last - first);
+        auto index = mystl::internal::simd_find<op>(
+            mystl::internal::unwrap_contiguous(first), size, *key);
+        first += static_cast<std::ptrdiff_t>(index);
+        return first;
+      }
+    }
+  }
+
+  while (first != last && !pred(*first)) {
+    ++first;
+  }
+  return first;
+}
+
+template <typename Iter_t, typename T>
+constexpr Iter_t find(Iter_t first, Iter_t last, T const &value) {
+  return algo::find_if(first, last,
+                       compare_with<std::equal_to<>, T const &>{value, {}});
+}
+
+template <typename Iter_t, typename Pred>
+constexpr std::ptrdiff_t count_if(Iter_t first, Iter_t last, Pred pred) {
+  if constexpr (internal::is_simd_predicate<Iter_t, Pred>()) {
+    if (!std::is_constant_evaluated()) {
+      using elem_t = internal::simd_element_t<Iter_t>;
+      if (auto key = internal::as_lane_value<elem_t>(pred.m_Value)) {
+        constexpr auto op = internal::simd_predicate<Pred>::value;
+        auto size = static_cast<std::size_t>(last - first);
+        return static_cast<std::ptrdiff_t>(mystl::internal::simd_count<op>(
+            mystl::internal::unwrap_contiguous(first), size, *key));
+      }
+    }
+  }
+
+  std::ptrdiff_t total = 0;
+  for (; first != last; ++first) {
+    total += pred(*first) ? 1 : 0;
+  }
+  return total;
+}
+
+template <typename Iter_t, typename T>
+constexpr std::ptrdiff_t count(Iter_t first, Iter_t last, T const &value) {
+  return algo::count_if(first, last,
+                        compare_with<std::equal_to<>, T const &>{value, {}});
+}
+
+// The first smallest element. For integers, floats and doubles in
+// contiguous ranges under std::less or std::greater, one vector pass finds
+// the smallest value and a second finds where it first is; ranges holding
+// a NaN compare element by element, as does everything else.
+template <typename Iter_t, typename Compare = std::less<>>
+constexpr Iter_t min_element(Iter_t first, Iter_t last, Compare comp = {}) {
+  if constexpr (internal::is_simd_ordering_v<Iter_t, Compare>) {
+    if (!std::is_constant_evaluated() && first != last) {
+      auto *data = mystl::internal::unwrap_contiguous(first);
+      auto size = static_cast<std::size_t>(last - first);
+      internal::simd_element_t<Iter_t> smallest, largest;
+      if (internal::simd_extremes<Compare>(data, size, smallest, largest)) {
+        using mystl::internal::simd_compare;
+        first += static_cast<std::ptrdiff_t>(
+            mystl::internal::simd_find<simd_compare::equal>(data, size,
+                                                            smallest));
+        return first;
+      }
+    }
+  }
+
+  Iter_t smallest = first;
+  if (first != last) {
+    while (++first != last) {
+      if (comp(*first, *smallest)) {
+        smallest = first;
+      }
+    }
+  }
+  return smallest;
+}
+
+// The first largest element, vectorised as min_element.
+template <typename Iter_t, typename Compare = std::less<>>
+constexpr Iter_t max_element(Iter_t first, Iter_t last, Compare comp = {}) {
+  if constexpr (internal::is_simd_ordering_v<Iter_t, Compare>) {
+    if (!std::is_constant_evaluated() && first != last) {
+      auto *data = mystl::internal::unwrap_contiguous(first);
+      auto size = static_cast<std::size_t>(last - first);
+      internal::simd_element_t<Iter_t> smallest, largest;
+      if (internal::simd_extremes<Compare>(data, size, smallest, largest)) {
+        using mystl::internal::simd_compare;
+        first += static_cast<std::ptrdiff_t>(
+            mystl::internal::simd_find<simd_compare::equal>(data, size,
+                                                            largest));
+        return first;
+      }
+    }
+  }
+
+  Iter_t largest = first;
+  if (first != last) {
+    while (++first != last) {
+      if (comp(*largest, *first)) {
+        largest = first;
+      }
+    }
+  }
+  return largest;
+}
+
+// The first smallest and the last largest element, as std::minmax_element;
+// vectorised as min_element, with the largest searched for from the back.
+template <typename Iter_t, typename Compare = std::less<>>
+constexpr std::pair<Iter_t, Iter_t> minmax_element(Iter_t first, Iter_t last,
+                                                   Compare comp = {}) {
+  if constexpr (internal::is_simd_ordering_v<Iter_t, Compare>) {
+    if (!std::is_constant_evaluated() && first != last) {
+      auto *data = mystl::internal::unwrap_contiguous(first);
+      auto size = static_cast<std::size_t>(last - first);
+      internal::simd_element_t<Iter_t> smallest, largest;
+      if (internal::simd_extremes<Compare>(data, size, smallest, largest)) {
+        using mystl::internal::simd_compare;
+        Iter_t min = first;
+        min += static_cast<std::ptrdiff_t>(
+            mystl::internal::simd_find<simd_compare::equal>(data, size,
+                                                            smallest));
+        first += static_cast<std::ptrdiff_t>(
+            mystl::internal::simd_find_last<simd_compare::equal>(data, size,
+                                                                 largest));
+        return {min, first};
+      }
+    }
+  }
+
+  std::pair<Iter_t, Iter_t> result{first, first};
+  if (first != last) {
+    while (++first != last) {
+      if (comp(*first, *result.first)) {
+        result.first = first;
+      } else if (!comp(*first, *result.second)) {
+        result.second = first;
+      }
+    }
+  }
+  return result;
+}
+
+// The first position where the ranges differ (by ==). [first2, ...) must
+// be at least as long as [first1, last1).
+template <typename Iter1_t, typename Iter2_t>
+constexpr std::pair<Iter1_t, Iter2_t> mismatch(Iter1_t first1, Iter1_t last1,
+                                               Iter2_t first2) {
+  if constexpr (internal::is_simd_range_v<Iter1_t> &&
+                internal::is_simd_range_v<Iter2_t> &&
+                std::is_same_v<internal::simd_element_t<Iter1_t>,
+                               internal::simd_element_t<Iter2_t>>) {
+    if (!std::is_constant_evaluated()) {
+      auto size = static_cast<std::size_t>(last1 - first1);
+      auto index = static_cast<std::ptrdiff_t>(mystl::internal::simd_mismatch(
+          mystl::internal::unwrap_contiguous(first1),
+          mystl::internal::unwrap_contiguous(first2), size));
+      first1 += index;
+      first2 += index;
+      return {first1, first2};
+    }
+  }
+
+  while (first1 != last1 && *first1 == *first2) {
+    ++first1;
+    ++first2;
+  }
+  return {first1, first2};
+}
+
+// Integers equal by value are equal by bits, so contiguous ranges of them
+// are compared with memcmp, which needs no position and is as wide as the
+// C library makes it.
+template <typename Iter1_t, typename Iter2_t>
+constexpr bool equal(Iter1_t first1, Iter1_t last1, Iter2_t first2) {
+  if constexpr (internal::is_simd_range_v<Iter1_t> &&
+                internal::is_simd_range_v<Iter2_t> &&
+                std::is_same_v<internal::simd_element_t<Iter1_t>,
+                               internal::simd_element_t<Iter2_t>> &&
+                std::is_integral_v<internal::simd_element_t<Iter1_t>>) {
+    if (!std::is_constant_evaluated()) {
+      auto count = static_cast<std::size_t>(last1 - first1);
+      return count == 0 ||
+             std::memcmp(mystl::internal::unwrap_contiguous(first1),
+                         mystl::internal::unwrap_contiguous(first2),
+                         count * sizeof(*first1)) == 0;
+    }
+  }
+  return algo::mismatch(first1, last1, first2).first == last1;
+}
+
 } // namespace mystl::algo
@@ -2,6 +2,24 @@
 #include <iostream>
 
 void test_array();
+void test_vector();
+void test_allocator();
+void test_list();
+void test_small_vector();
+void test_inplace_vector();
+void test_mapped_vector();
+void test_ring_buffer();
+void test_spsc_queue();
+void test_mpmc_queue();
+void test_work_stealing_deque();
+void test_concurrent_stack();
+void test_unrolled_list();
+void test_intrusive_list();
+void test_forward_list();
+void test_algorithms();
+void test_parallel_algorithms();
+void test_sort();
+void test_iterator();
 
 int main() {
   auto vs = mystl::Vector<float>{1, 2, 3, 4, 5, 6};
@@ -11,4 +29,22 @@ int main() {
   std::cout << '\n';
   std::cout << "run test \n";
   test_array();
+  test_vector();
+  test_allocator();
+  test_list();
+  test_small_vector();
+  test_inplace_vector();
+  test_mapped_vector();
+  test_ring_buffer();
+  test_spsc_queue();
+  test_mpmc_queue();
+  test_work_stealing_deque();
+  test_concurrent_stack();
+  test_unrolled_list();
+  test_intrusive_list();
+  test_forward_list();
+  test_algorithms();
+  test_parallel_algorithms();
+  test_sort();
+  test_iterator();
 }
@@ -0,0 +1,283 @@
+#include "MySTL/List.h"
+#include "MySTL/Vector.h"
+#include "MySTL/algorithms.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace {
+
+constexpr int constant_fill_and_copy() {
+  int from[5] = {};
+  int to[5] = {};
+  mystl::algo::fill(from, from + 5, 7);
+  mystl::algo::copy(from, from + 5, to);
+  return to[0] + to[4];
+}
+
+// Checks [first, first + count) holds `value` and the guard slots around
+// it were not touched.
+template <typename T>
+bool filled(mystl::Vector<T> const &vec, std::size_t first, std::size_t count,
+            T value, T guard) {
+  for (std::size_t i = 0; i < vec.size(); ++i) {
+    bool inside = i >= first && i < first + count;
+    if (vec[i] != (inside ? value : guard)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void test_algorithms_fill() {
+  static_assert(constant_fill_and_copy() == 14);
+
+  // Every length up to a few vectors, from every alignment, so the
+  // partial-vector tails are covered.
+  for (std::size_t offset = 0; offset < 4; ++offset) {
+    for (std::size_t count = 0; count < 40; ++count) {
+      mystl::Vector<std::uint32_t> words(count + 8, 0xdeadbeef);
+      mystl::algo::fill(words.data() + offset, words.data() + offset + count,
+                        std::uint32_t{0x01020304});
+      assert(filled(words, offset, count, std::uint32_t{0x01020304},
+                    std::uint32_t{0xdeadbeef}));
+
+      mystl::Vector<double> doubles(count + 8, -1.0);
+      mystl::algo::fill(doubles.begin() + offset,
+                        doubles.begin() + offset + count, 0.0);
+      assert(filled(doubles, offset, count, 0.0, -1.0));
+    }
+  }
+
+  // Large enough for non-temporal stores, from an unaligned start.
+  mystl::Vector<std::uint16_t> large((std::size_t{5} << 20) + 3, 1);
+  mystl::algo::fill(large.data() + 1, large.data() + large.size() - 1,
+                    std::uint16_t{0xabcd});
+  assert(filled(large, 1, large.size() - 2, std::uint16_t{0xabcd},
+                std::uint16_t{1}));
+
+  // Elements that do not tile a vector, and non-trivial ones.
+  struct Rgb {
+    unsigned char r, g, b;
+    bool operator!=(Rgb const &o) const {
+      return r != o.r || g != o.g || b != o.b;
+    }
+  };
+  mystl::Vector<Rgb> pixels(19, Rgb{0, 0, 0});
+  mystl::algo::fill(pixels.data() + 1, pixels.data() + 18, Rgb{1, 2, 3});
+  assert(filled(pixels, 1, 17, Rgb{1, 2, 3}, Rgb{0, 0, 0}));
+
+  // An element as wide as the whole pattern, through the dispatcher and
+  // through the SSE2 kernel, which every x86-64 CPU would otherwise only
+  // reach without AVX2.
+  struct Wide {
+    std::uint32_t lanes[8];
+    bool operator!=(Wide const &o) const {
+      return !std::equal(lanes, lanes + 8, o.lanes);
+    }
+  };
+  Wide const wide{{1, 2, 3, 4, 5, 6, 7, 8}};
+  for (std::size_t count = 0; count < 6; ++count) {
+    mystl::Vector<Wide> wides(count + 2, Wide{});
+    mystl::algo::fill(wides.data() + 1, wides.data() + 1 + count, wide);
+    assert(filled(wides, 1, count, wide, Wide{}));
+
+#if defined(MYSTL_X86_SIMD)
+    mystl::Vector<Wide> forced(count + 2, Wide{});
+    mystl::internal::fill_pattern_sse2(
+        reinterpret_cast<unsigned char *>(forced.data() + 1),
+        count * sizeof(Wide), reinterpret_cast<unsigned char const *>(&wide));
+    assert(filled(forced, 1, count, wide, Wide{}));
+#endif
+  }
+
+  mystl::Vector<std::string> strings(5, "x");
+  mystl::algo::fill(strings.begin(), strings.end(), std::string(30, 'y'));
+  assert(strings[4] == std::string(30, 'y'));
+}
+
+void test_algorithms_copy() {
+  mystl::Vector<float> from(1000);
+  for (std::size_t i = 0; i < from.size(); ++i) {
+    from[i] = float(i);
+  }
+  mystl::Vector<float> to(1000, 0.0f);
+  mystl::algo::copy(from.begin() + 1, from.begin() + 1000, to.begin());
+  assert(to[0] == 1.0f && to[998] == 999.0f && to[999] == 0.0f);
+
+  // Overlapping ranges behave like memmove.
+  mystl::algo::copy(to.data() + 1, to.data() + 10, to.data());
+  assert(to[0] == 2.0f && to[8] == 10.0f && to[9] == 10.0f);
+
+  // Converting copies go element by element.
+  mystl::Vector<double> wide(3, 0.0);
+  mystl::algo::copy(from.data(), from.data() + 3, wide.data());
+  assert(wide[2] == 2.0);
+
+  mystl::Vector<float> copy(from);
+  assert(copy[999] == 999.0f);
+}
+
+void test_algorithms_numeric() {
+  mystl::Vector<int> values{3, 1, 4, 1, 5};
+  int sum = 0;
+  mystl::algo::for_each(values.begin(), values.end(),
+                        [&sum](int value) { sum += value; });
+  assert(sum == 14);
+  assert(mystl::algo::reduce(values.begin(), values.end(), 0) == 14);
+
+  // Any iterator works; strings show the fold order is kept.
+  mystl::List<std::string> words{"a", "b", "c"};
+  assert(mystl::algo::reduce(words.begin(), words.end(), std::string(">")) ==
+         ">abc");
+
+  mystl::Vector<int> squares(5, 0);
+  mystl::algo::transform(values.begin(), values.end(), squares.begin(),
+                         [](int value) { return value * value; });
+  assert(squares[0] == 9 && squares[4] == 25);
+  assert(mystl::algo::transform_reduce(
+             values.begin(), values.end(), 0, std::plus<>(),
+             [](int value) { return value * value; }) == 52);
+  assert(mystl::algo::transform_reduce(values.begin(), values.end(),
+                                       squares.begin(), 0) == 27 + 1 + 64 +
+                                                                  1 + 125);
+
+  // In place.
+  mystl::algo::inclusive_scan(values.begin(), values.end(), values.begin());
+  assert(values[0] == 3 && values[2] == 8 && values[4] == 14);
+}
+
+// The searches against std's, for one element type at every length up to
+// past an AVX-512 vector of it (so each kernel width and its overlapping
+// last load runs), with the smallest, largest and a differing element at
+// every position.
+template <typename T>
+void check_search(std::size_t maxSize) {
+  using limits = std::numeric_limits<T>;
+  for (std::size_t size = 0; size <= maxSize; ++size) {
+    mystl::Vector<T> values(size, T(0));
+    for (std::size_t i = 0; i < size; ++i) {
+      values[i] = static_cast<T>(10 + i % 7);
+    }
+    T *first = values.data();
+    T *last = first + size;
+
+    auto check = [&](auto pred) {
+      assert(mystl::algo::find_if(first, last, pred) ==
+             std::find_if(first, last, pred));
+      assert(mystl::algo::count_if(first, last, pred) ==
+             std::count_if(first, last, pred));
+    };
+    check(mystl::algo::equal_to(T(13)));
+    check(mystl::algo::not_equal_to(T(10)));
+    check(mystl::algo::less_than(T(11)));
+    check(mystl::algo::at_most(T(12)));
+    check(mystl::algo::greater_than(T(15)));
+    check(mystl::algo::at_least(T(16)));
+    assert(mystl::algo::find(first, last, T(99)) == last);
+
+    mystl::Vector<T> copy(values);
+    for (std::size_t at = 0; at < size; ++at) {
+      values[at] = limits::lowest();
+      values[size - 1 - at] = limits::max();
+      assert(mystl::algo::find(first, last, limits::max()) ==
+             std::find(first, last, limits::max()));
+      assert(mystl::algo::count(first, last, limits::lowest()) ==
+             std::count(first, last, limits::lowest()));
+      check(mystl::algo::less_than(T(0)));
+      check(mystl::algo::greater_than(T(20)));
+
+      assert(mystl::algo::min_element(first, last) ==
+             std::min_element(first, last));
+      assert(mystl::algo::max_element(first, last) ==
+             std::max_element(first, last));
+      assert(mystl::algo::minmax_element(first, last) ==
+             std::minmax_element(first, last));
+      assert(mystl::algo::min_element(first, last, std::greater<>()) ==
+             std::min_element(first, last, std::greater<>()));
+      assert(mystl::algo::minmax_element(first, last, std::greater<>()) ==
+             std::minmax_element(first, last, std::greater<>()));
+
+      assert(mystl::algo::mismatch(first, last, copy.data()) ==
+             std::mismatch(first, last, copy.data()));
+      assert(!mystl::algo::equal(first, last, copy.data()));
+      values[at] = copy[at];
+      values[size - 1 - at] = copy[size - 1 - at];
+    }
+    assert(mystl::algo::equal(values.begin(), values.end(), copy.begin()));
+  }
+}
+
+void test_algorithms_search() {
+  check_search<std::int8_t>(130);
+  check_search<std::uint8_t>(130);
+  check_search<char>(70);
+  check_search<std::int16_t>(70);
+  check_search<std::uint16_t>(70);
+  check_search<std::int32_t>(40);
+  check_search<std::uint32_t>(40);
+  check_search<std::int64_t>(20);
+  check_search<std::uint64_t>(20);
+  check_search<float>(40);
+  check_search<double>(20);
+
+  // ContiguousIterator, const elements and other iterators.
+  mystl::Vector<int> ints{5, 3, 9, 3, 7, 1, 9, 2, 8, 6, 4, 0, 9, 5, 3, 1, 2};
+  mystl::Vector<int> const &view = ints;
+  assert(*mystl::algo::find(ints.begin(), ints.end(), 7) == 7);
+  assert(mystl::algo::count(view.begin(), view.end(), 9) == 3);
+  assert(*mystl::algo::min_element(view.begin(), view.end()) == 0);
+  auto [low, high] = mystl::algo::minmax_element(ints.begin(), ints.end());
+  assert(*low == 0 && high.operator->() == ints.data() + 12);
+  mystl::List<int> list{4, 2, 6};
+  assert(*mystl::algo::max_element(list.begin(), list.end()) == 6);
+  assert(mystl::algo::count_if(list.begin(), list.end(),
+                               mystl::algo::less_than(5)) == 2);
+
+  // Keys of another type compare as the language would: 300 is no byte,
+  // and -1 converts to the largest unsigned int but is below every byte.
+  mystl::Vector<std::uint8_t> bytes(100, 255);
+  mystl::Vector<std::uint32_t> words(100, 7);
+  assert(mystl::algo::count(bytes.begin(), bytes.end(), 255) == 100);
+  assert(mystl::algo::find(bytes.begin(), bytes.end(), 300) == bytes.end());
+  assert(mystl::algo::count_if(bytes.begin(), bytes.end(),
+                               mystl::algo::greater_than(-1)) == 100);
+  assert(mystl::algo::count_if(words.begin(), words.end(),
+                               mystl::algo::less_than(-1)) == 100);
+  mystl::Vector<float> floats(50, 2.0f);
+  assert(mystl::algo::count(floats.begin(), floats.end(), 2) == 50);
+
+  // NaN is equal to nothing, and leaves min/max to the element-wise loop;
+  // -0.0 and 0.0 are equal.
+  float nan = std::numeric_limits<float>::quiet_NaN();
+  for (std::size_t at : {0, 17, 49}) {
+    floats[at] = nan;
+    floats[(at + 5) % 50] = -0.0f;
+    float *first = floats.data();
+    float *last = first + 50;
+    assert(mystl::algo::find(first, last, nan) == last);
+    assert(mystl::algo::count_if(first, last, mystl::algo::not_equal_to(
+                                                  2.0f)) == 2);
+    assert(mystl::algo::find(first, last, 0.0f) == first + (at + 5) % 50);
+    assert(mystl::algo::min_element(first, last) ==
+           std::min_element(first, last));
+    assert(mystl::algo::minmax_element(first, last) ==
+           std::minmax_element(first, last));
+    assert(mystl::algo::mismatch(first, last, first).first == first + at);
+    floats[at] = 2.0f;
+    floats[(at + 5) % 50] = 2.0f;
+  }
+}
+
+} // namespace
+
+void test_algorithms() {
+  test_algorithms_fill();
+  test_algorithms_copy();
+  test_algorithms_numeric();
+  test_algorithms_search();
+}
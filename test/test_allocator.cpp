@@ -0,0 +1,234 @@
+#include "MySTL/List.h"
+#include "MySTL/MemoryResource.h"
+#include "MySTL/Queue.h"
+#include "MySTL/Stack.h"
+#include "MySTL/Vector.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+// The adaptors take an allocator, not anything the container happens to be
+// constructible from: Vector<int>(5) is five ints, but Stack<int>(5) is no
+// stack.
+static_assert(!std::is_constructible_v<mystl::Stack<int>, int>);
+static_assert(!std::is_constructible_v<mystl::Queue<int>, int>);
+static_assert(
+    std::is_constructible_v<mystl::Stack<int>, mystl::Allocator<int>>);
+static_assert(
+    std::is_constructible_v<mystl::Queue<int>, mystl::Allocator<int>>);
+
+// Counts what reaches the upstream so tests can tell who touched the heap.
+class CountingResource : public mystl::MemoryResource {
+public:
+  std::size_t m_Allocations = 0;
+  std::size_t m_Deallocations = 0;
+  std::size_t m_BytesInUse = 0;
+
+private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++m_Allocations;
+    m_BytesInUse += bytes;
+    return mystl::default_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *data, std::size_t bytes,
+                     std::size_t alignment) override {
+    ++m_Deallocations;
+    m_BytesInUse -= bytes;
+    mystl::default_resource()->deallocate(data, bytes, alignment);
+  }
+};
+
+bool is_aligned(void const *data, std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(data) % alignment == 0;
+}
+
+} // namespace
+
+void test_monotonic_resource() {
+  CountingResource upstream;
+  {
+    mystl::MonotonicResource arena(&upstream);
+    for (std::size_t i = 1; i < 200; ++i) {
+      void *data = arena.allocate(i, 8);
+      assert(is_aligned(data, 8));
+      arena.deallocate(data, i, 8);
+    }
+    void *wide = arena.allocate(100, 64);
+    assert(is_aligned(wide, 64));
+
+    // Chunks grow geometrically, so there are only a handful of them.
+    assert(upstream.m_Allocations < 8);
+    assert(upstream.m_Deallocations == 0);
+  }
+  assert(upstream.m_Deallocations == upstream.m_Allocations);
+  assert(upstream.m_BytesInUse == 0);
+
+  // An initial buffer is used before the upstream is touched.
+  alignas(std::max_align_t) std::byte buffer[256];
+  mystl::MonotonicResource stackArena(buffer, sizeof(buffer), &upstream);
+  std::size_t before = upstream.m_Allocations;
+  stackArena.allocate(128);
+  assert(upstream.m_Allocations == before);
+  stackArena.allocate(256);
+  assert(upstream.m_Allocations == before + 1);
+  stackArena.release();
+  assert(upstream.m_BytesInUse == 0);
+}
+
+void test_pool_resource() {
+  CountingResource upstream;
+  {
+    mystl::PoolResource pool(24, 16, &upstream);
+
+    // Blocks take the alignment of the first request, not max_align_t's.
+    void *blocks[32];
+    for (auto &block : blocks) {
+      block = pool.allocate(24, 8);
+    }
+    assert(pool.block_size() == 24 && pool.block_alignment() == 8);
+    assert(static_cast<std::byte *>(blocks[1]) -
+               static_cast<std::byte *>(blocks[0]) ==
+           24);
+    assert(upstream.m_Allocations == 2);
+
+    // Freed blocks are recycled before a new chunk is requested.
+    pool.deallocate(blocks[3], 24, 8);
+    assert(pool.allocate(24, 8) == blocks[3]);
+    assert(upstream.m_Allocations == 2);
+
+    // Oversized and more strictly aligned requests bypass the pool.
+    void *big = pool.allocate(1000);
+    assert(upstream.m_Allocations == 3);
+    pool.deallocate(big, 1000);
+    assert(upstream.m_Deallocations == 1);
+    void *aligned = pool.allocate(16, 16);
+    assert(upstream.m_Allocations == 4 && is_aligned(aligned, 16));
+    pool.deallocate(aligned, 16, 16);
+  }
+  assert(upstream.m_BytesInUse == 0);
+
+  // Sized by the first request, with the default alignment.
+  mystl::PoolResource sized(0, 16, &upstream);
+  void *block = sized.allocate(24);
+  assert(sized.block_size() == 32 && is_aligned(block, 16));
+  sized.deallocate(block, 24);
+}
+
+void test_allocator_aware_containers() {
+  CountingResource upstream;
+  mystl::MonotonicResource arena(&upstream);
+
+  {
+    mystl::pmr::Vector<std::string> strings(&arena);
+    for (int i = 0; i < 100; ++i) {
+      strings.push_back(std::string(32, 'x'));
+    }
+    assert(strings.get_allocator().resource() == &arena);
+
+    mystl::pmr::List<int> list(&arena);
+    for (int i = 0; i < 100; ++i) {
+      list.push_back(i);
+    }
+    assert(list.size() == 100 && list.back() == 99);
+
+    mystl::pmr::Stack<int> stack(mystl::PolymorphicAllocator<int>{&arena});
+    mystl::pmr::Queue<int> queue(mystl::PolymorphicAllocator<int>{&arena});
+    for (int i = 0; i < 100; ++i) {
+      stack.push(i);
+      queue.push(i);
+    }
+    assert(stack.top() == 99);
+
+    // Copies go back to the default resource; moves keep the arena.
+    mystl::pmr::Vector<std::string> copy(strings);
+    assert(copy.get_allocator().resource() == mystl::default_resource());
+    mystl::pmr::Vector<std::string> moved(std::move(strings));
+    assert(moved.get_allocator().resource() == &arena);
+
+    // Move assignment across resources moves the elements instead.
+    copy = std::move(moved);
+    assert(copy.get_allocator().resource() == mystl::default_resource());
+    assert(copy.size() == 100 && copy.back() == std::string(32, 'x'));
+  }
+
+  // Everything lives in a few arena chunks, freed in one go.
+  assert(upstream.m_Allocations < 16);
+  arena.release();
+  assert(upstream.m_BytesInUse == 0);
+
+  mystl::PoolResource nodes(sizeof(mystl::List_Node<int>));
+  mystl::pmr::List<int> pooled(&nodes);
+  for (int i = 0; i < 1000; ++i) {
+    pooled.push_front(i);
+  }
+  assert(pooled.front() == 999);
+}
+
+void test_aligned_storage() {
+  mystl::AlignedVector<float> floats;
+  for (int i = 0; i < 1000; ++i) {
+    floats.push_back(static_cast<float>(i));
+    assert(is_aligned(floats.data(), 64));
+  }
+
+  mystl::AlignedVector<double, 32> doubles(10, 1.0);
+  assert(is_aligned(doubles.data(), 32));
+
+  // Past the threshold the buffer is mapped on a 2 MiB boundary, and
+  // growing it keeps the contents.
+  mystl::HugePageVector<int> big;
+  constexpr int count = 3 << 20;
+  for (int i = 0; i < count; ++i) {
+    big.push_back(i);
+    if (big.capacity() * sizeof(int) >= (std::size_t{2} << 20)) {
+      assert(is_aligned(big.data(), 2 << 20));
+    }
+  }
+  assert(big[0] == 0 && big[count / 2] == count / 2 && big.back() == count - 1);
+
+  mystl::HugePageVector<int> copy(big);
+  assert(is_aligned(copy.data(), 2 << 20));
+  assert(copy.size() == big.size() && copy.back() == count - 1);
+
+  while (big.size() > 10) {
+    big.erase(10, big.size() / 2);
+  }
+  assert(big.back() == 9);
+
+#if defined(__linux__)
+  // With the pages after a block taken, growing has to move it, and it
+  // still lands on a 2 MiB boundary.
+  using HugeInts = mystl::HugePageAllocator<int>;
+  HugeInts huge;
+  std::size_t const blockInts = (std::size_t{2} << 20) / sizeof(int);
+  int *block = huge.allocate(blockInts);
+  block[blockInts - 1] = 42;
+  void *blocker = ::mmap(block + blockInts, std::size_t{2} << 20, PROT_READ,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                         -1, 0);
+  int *grown = huge.reallocate(block, blockInts, 3 * blockInts);
+  assert(is_aligned(grown, 2 << 20) && grown[blockInts - 1] == 42);
+  if (blocker != MAP_FAILED) {
+    assert(grown != block);
+    ::munmap(blocker, std::size_t{2} << 20);
+  }
+  huge.deallocate(grown, 3 * blockInts);
+#endif
+}
+
+void test_allocator() {
+  test_monotonic_resource();
+  test_pool_resource();
+  test_allocator_aware_containers();
+  test_aligned_storage();
+}
@@ -0,0 +1,112 @@
+#include "MySTL/ConcurrentStack.h"
+#include "MySTL/Vector.h"
+
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+void test_concurrent_stack_single_thread() {
+  mystl::ConcurrentStack<int> stack;
+  int out = -1;
+  assert(stack.empty() && !stack.try_pop(out));
+
+  for (int i = 0; i < 5; ++i) {
+    stack.push(i);
+  }
+  assert(stack.try_pop(out) && out == 4);
+
+  int expected = 3;
+  std::size_t count = stack.pop_all([&expected](int val) {
+    assert(val == expected);
+    --expected;
+  });
+  assert(count == 4 && stack.empty());
+
+  // A free-list of reusable buffers; leftovers are freed with the stack.
+  mystl::ConcurrentStack<mystl::Vector<char>> buffers;
+  buffers.push(mystl::Vector<char>(4096, 'x'));
+  buffers.push(mystl::Vector<char>(16, 'y'));
+  mystl::Vector<char> buffer;
+  assert(buffers.try_pop(buffer) && buffer.size() == 16);
+}
+
+void test_concurrent_stack_threads() {
+  constexpr int threadCount = 4;
+  constexpr int perThread = 20000;
+  mystl::ConcurrentStack<int> stack;
+  std::atomic<long> sum{0};
+
+  // Each thread pushes its values and pops as many, so nodes are retired
+  // and freed while other threads are still walking the stack.
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t) {
+    threads.emplace_back([&stack, &sum, t] {
+      long local = 0;
+      int popped = 0;
+      for (int i = 1; i <= perThread; ++i) {
+        stack.push(t * perThread + i);
+        int val;
+        if (i % 2 == 0 && stack.try_pop(val)) {
+          local += val;
+          ++popped;
+        }
+      }
+      while (popped < perThread / 2) {
+        int val;
+        if (stack.try_pop(val)) {
+          local += val;
+          ++popped;
+        }
+      }
+      sum += local;
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  long rest = 0;
+  stack.pop_all([&rest](int val) { rest += val; });
+  long total = long(threadCount) * perThread;
+  assert(sum + rest == total * (total + 1) / 2);
+}
+
+struct Tracked {
+  static inline int m_Freed = 0;
+  ~Tracked() { ++m_Freed; }
+};
+
+void test_hazard_pointers() {
+  std::atomic<Tracked *> first{new Tracked};
+  std::atomic<Tracked *> second{new Tracked};
+  Tracked::m_Freed = 0;
+  {
+    // Two hazard pointers on one thread protect two nodes at once.
+    mystl::HazardPointer firstHazard;
+    mystl::HazardPointer secondHazard;
+    Tracked *a = firstHazard.protect(first);
+    Tracked *b = secondHazard.protect(second);
+    mystl::HazardPointer::retire(a);
+    mystl::HazardPointer::retire(b);
+    mystl::internal::hazard_thread::instance().scan();
+    assert(Tracked::m_Freed == 0);
+
+    secondHazard.reset();
+    mystl::internal::hazard_thread::instance().scan();
+    assert(Tracked::m_Freed == 1);
+  }
+  mystl::internal::hazard_thread::instance().scan();
+  assert(Tracked::m_Freed == 2);
+}
+
+} // namespace
+
+void test_concurrent_stack() {
+  test_concurrent_stack_single_thread();
+  test_concurrent_stack_threads();
+  test_hazard_pointers();
+}
@@ -0,0 +1,110 @@
+#include "MySTL/ForwardList.h"
+
+#include <cassert>
+#include <initializer_list>
+#include <string>
+
+using IntForwardList = mystl::ForwardList<int>;
+
+namespace {
+
+bool equals(IntForwardList const &list, std::initializer_list<int> expected) {
+  if (list.size() != expected.size()) {
+    return false;
+  }
+  auto value = expected.begin();
+  for (int element : list) {
+    if (element != *value++) {
+      return false;
+    }
+  }
+  return true;
+}
+
+IntForwardList::iterator nth(IntForwardList &list, int index) {
+  auto it = list.before_begin();
+  while (index-- >= 0) {
+    ++it;
+  }
+  return it;
+}
+
+void test_forward_list_modifiers() {
+  IntForwardList list;
+  assert(list.empty() && list.begin() == list.end());
+
+  list.push_front(3);
+  list.push_front(1);
+  list.emplace_front(0);
+  auto it = list.insert_after(nth(list, 1), 2);
+  assert(*it == 2);
+  list.insert_after(nth(list, 3), 4);
+  assert(equals(list, {0, 1, 2, 3, 4}) && list.front() == 0);
+
+  it = list.erase_after(list.before_begin());
+  assert(*it == 1);
+  it = list.erase_after(nth(list, 0), nth(list, 3));
+  assert(*it == 4 && equals(list, {1, 4}));
+  list.pop_front();
+  assert(equals(list, {4}));
+
+  IntForwardList numbers{1, 2, 3};
+  IntForwardList copy(numbers);
+  IntForwardList moved(std::move(numbers));
+  assert(numbers.empty() && equals(moved, {1, 2, 3}));
+  numbers.push_front(9);
+  copy = moved;
+  assert(equals(copy, {1, 2, 3}) && equals(numbers, {9}));
+
+  mystl::ForwardList<std::string> strings(2, "abc");
+  strings.push_front(std::string(40, 'x'));
+  strings.clear();
+  assert(strings.empty());
+}
+
+void test_forward_list_operations() {
+  IntForwardList list{5, 1, 4, 1, 5, 9, 2, 6};
+  int const *nine = &*nth(list, 5);
+  list.sort();
+  assert(equals(list, {1, 1, 2, 4, 5, 5, 6, 9}));
+  // Nodes are relinked, not copied.
+  assert(&*nth(list, 7) == nine);
+
+  list.sort([](int a, int b) { return a > b; });
+  assert(equals(list, {9, 6, 5, 5, 4, 2, 1, 1}));
+  list.reverse();
+  assert(equals(list, {1, 1, 2, 4, 5, 5, 6, 9}));
+
+  // Lists on one allocator share nodes, so merge and splice only relink.
+  mystl::PoolAllocator<int> shared;
+  IntForwardList a({1, 4, 7}, shared), b({2, 4, 8}, shared);
+  int const *eight = &*nth(b, 2);
+  a.merge(b);
+  assert(b.empty() && equals(a, {1, 2, 4, 4, 7, 8}));
+  assert(&*nth(a, 5) == eight);
+
+  b.splice_after(b.before_begin(), a);
+  assert(a.empty() && b.size() == 6);
+  a.splice_after(a.before_begin(), b, nth(b, 0));
+  assert(equals(a, {2}) && equals(b, {1, 4, 4, 7, 8}));
+  a.splice_after(nth(a, 0), b, nth(b, 0), nth(b, 3));
+  assert(equals(a, {2, 4, 4}) && equals(b, {1, 7, 8}));
+
+  // Moving the front element to the back of the same list.
+  b.splice_after(nth(b, 2), b, b.before_begin());
+  assert(equals(b, {7, 8, 1}));
+
+  // Separate pools cannot trade nodes, so elements are moved instead.
+  IntForwardList c{3, 5};
+  c.merge(b);
+  assert(b.empty() && equals(c, {3, 5, 7, 8, 1}));
+  c.splice_after(c.before_begin(), a);
+  assert(a.empty() && equals(c, {2, 4, 4, 3, 5, 7, 8, 1}));
+}
+
+} // namespace
+
+void test_forward_list() {
+  test_forward_list_modifiers();
+  test_forward_list_operations();
+}
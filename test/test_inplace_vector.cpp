@@ -0,0 +1,83 @@
+#include "MySTL/InplaceVector.h"
+
+#include <cassert>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+// A lookup table built entirely at compile time.
+constexpr auto make_squares() {
+  mystl::InplaceVector<int, 16> squares;
+  for (int i = 0; i < 10; ++i) {
+    squares.push_back(i * i);
+  }
+  return squares;
+}
+
+// Slots past size() are left uninitialized, which constant evaluation allows
+// as long as nothing reads them; a constexpr variable would have to hold
+// them, so the results are checked directly.
+static_assert(make_squares().size() == 10);
+static_assert(make_squares()[3] == 9);
+static_assert(make_squares().back() == 81);
+
+constexpr bool try_push_back_stops_when_full() {
+  mystl::InplaceVector<int, 3> vec;
+  bool accepted = vec.try_push_back(1) && vec.try_push_back(2) &&
+                  vec.try_push_back(3);
+  return accepted && vec.try_push_back(4) == nullptr && vec.size() == 3;
+}
+static_assert(try_push_back_stops_when_full());
+
+constexpr bool insert_erase() {
+  mystl::InplaceVector<int, 8> vec{1, 2, 3, 4};
+  vec.insert(1, 9, 2);
+  if (vec.size() != 6 || vec[1] != 9 || vec[2] != 9 || vec[3] != 2) {
+    return false;
+  }
+  vec.erase(0, 3);
+  return vec.size() == 3 && vec.front() == 2 && vec.back() == 4;
+}
+static_assert(insert_erase());
+
+static_assert(std::is_trivially_destructible_v<mystl::InplaceVector<int, 4>>);
+static_assert(sizeof(mystl::InplaceVector<int, 0>) <= sizeof(std::size_t));
+
+} // namespace
+
+void test_inplace_vector() {
+  mystl::InplaceVector<std::string, 4> strings;
+  strings.push_back("a");
+  strings.emplace_back(3, 'b');
+  strings.unchecked_push_back("c");
+  assert(strings.size() == 3 && strings[1] == "bbb");
+
+  assert(strings.try_emplace_back("d") != nullptr);
+  assert(strings.try_emplace_back("e") == nullptr);
+
+  bool threw = false;
+  try {
+    strings.push_back("e");
+  } catch (std::bad_alloc const &) {
+    threw = true;
+  }
+  assert(threw);
+
+  mystl::InplaceVector<std::string, 4> copy(strings);
+  strings.erase(0, 2);
+  assert(strings.size() == 2 && strings.front() == "c");
+  assert(copy.size() == 4 && copy.front() == "a");
+
+  mystl::InplaceVector<std::string, 4> moved(std::move(copy));
+  assert(copy.empty() && moved.size() == 4);
+  moved.pop_back();
+  moved.insert(1, "x");
+  assert(moved.size() == 4 && moved[1] == "x" && moved.back() == "c");
+
+  int sum = 0;
+  for (int square : make_squares()) {
+    sum += square;
+  }
+  assert(sum == 285);
+}
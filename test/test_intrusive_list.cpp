@@ -0,0 +1,113 @@
+#include "MySTL/IntrusiveList.h"
+
+#include <cassert>
+#include <initializer_list>
+#include <memory>
+#include <string>
+
+namespace {
+
+struct Entry {
+  std::string m_Key;
+  int m_Deadline;
+  mystl::IntrusiveListHook m_Lru;
+  mystl::IntrusiveListHook m_Timers;
+};
+
+using LruList = mystl::IntrusiveList<Entry, &Entry::m_Lru>;
+using TimerList = mystl::IntrusiveList<Entry, &Entry::m_Timers>;
+
+template <typename List_t>
+bool keys_are(List_t const &list, std::initializer_list<char const *> keys) {
+  if (list.size() != keys.size()) {
+    return false;
+  }
+  auto key = keys.begin();
+  for (Entry const &entry : list) {
+    if (entry.m_Key != *key++) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Far larger than a thread's stack; finding the object behind a hook must
+// not need a T-sized temporary or storage of its own.
+struct Huge {
+  unsigned char m_Payload[std::size_t{16} << 20];
+  mystl::IntrusiveListHook m_Hook;
+};
+
+void test_intrusive_list_huge() {
+  auto first = std::make_unique<Huge>();
+  auto second = std::make_unique<Huge>();
+  first->m_Payload[0] = 1;
+  second->m_Payload[0] = 2;
+
+  mystl::IntrusiveList<Huge, &Huge::m_Hook> list;
+  list.push_back(*first);
+  list.push_back(*second);
+  assert(&list.front() == first.get() && &list.back() == second.get());
+  assert(list.begin()->m_Payload[0] == 1);
+}
+
+} // namespace
+
+void test_intrusive_list() {
+  Entry a{"a", 30, {}, {}};
+  Entry b{"b", 10, {}, {}};
+  Entry c{"c", 20, {}, {}};
+
+  {
+    LruList lru;
+    TimerList timers;
+    assert(lru.empty() && lru.begin() == lru.end());
+
+    // The same objects are in both lists, in different orders.
+    lru.push_front(a);
+    lru.push_front(b);
+    lru.push_front(c);
+    timers.push_back(b);
+    timers.insert(timers.end(), c);
+    timers.push_back(a);
+    assert(keys_are(lru, {"c", "b", "a"}));
+    assert(keys_are(timers, {"b", "c", "a"}));
+    assert(&lru.back() == &a && &timers.front() == &b);
+
+    // A cache hit on "a" moves it to the front without touching the
+    // timers.
+    lru.splice(lru.begin(), lru, lru.iterator_to(a));
+    assert(keys_are(lru, {"a", "c", "b"}));
+    assert(keys_are(timers, {"b", "c", "a"}));
+
+    // "b" expires: it leaves both lists given just the object.
+    timers.pop_front();
+    lru.erase(b);
+    assert(!b.m_Lru.is_linked() && !b.m_Timers.is_linked());
+    assert(keys_are(lru, {"a", "c"}) && keys_are(timers, {"c", "a"}));
+
+    // Walking backwards, and erasing through an iterator.
+    auto it = lru.end();
+    --it;
+    assert(it->m_Key == "c");
+    it = lru.erase(it);
+    assert(it == lru.end() && keys_are(lru, {"a"}));
+
+    // Moving a list re-points the ends at the new header.
+    LruList moved(std::move(lru));
+    assert(lru.empty() && keys_are(moved, {"a"}));
+    lru.push_back(c);
+    lru.splice(lru.end(), moved);
+    assert(moved.empty() && keys_are(lru, {"c", "a"}));
+
+    // Copies of an object start out in no list.
+    Entry copy = a;
+    assert(a.m_Lru.is_linked() && !copy.m_Lru.is_linked());
+  }
+
+  // The lists unlinked everything when they went away.
+  assert(!a.m_Lru.is_linked() && !a.m_Timers.is_linked());
+  assert(!c.m_Lru.is_linked() && !c.m_Timers.is_linked());
+
+  test_intrusive_list_huge();
+}
@@ -0,0 +1,96 @@
+#include "MySTL/Array.h"
+#include "MySTL/ForwardList.h"
+#include "MySTL/List.h"
+#include "MySTL/RingBuffer.h"
+#include "MySTL/UnrolledList.h"
+#include "MySTL/Vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <span>
+
+namespace {
+
+using IntVector = mystl::Vector<int>;
+using IntArray = mystl::Array<int, 4>;
+
+static_assert(std::contiguous_iterator<IntVector::iterator>);
+static_assert(std::contiguous_iterator<IntVector::const_iterator>);
+static_assert(std::contiguous_iterator<IntArray::iterator>);
+static_assert(std::contiguous_iterator<IntArray::const_iterator>);
+static_assert(std::random_access_iterator<mystl::RingBuffer<int>::iterator>);
+static_assert(
+    std::random_access_iterator<mystl::RingBuffer<int>::const_iterator>);
+static_assert(std::bidirectional_iterator<mystl::List<int>::iterator>);
+static_assert(std::bidirectional_iterator<mystl::List<int>::const_iterator>);
+static_assert(std::bidirectional_iterator<mystl::UnrolledList<int>::iterator>);
+static_assert(
+    std::bidirectional_iterator<mystl::UnrolledList<int>::const_iterator>);
+static_assert(std::forward_iterator<mystl::ForwardList<int>::iterator>);
+static_assert(std::forward_iterator<mystl::ForwardList<int>::const_iterator>);
+static_assert(std::ranges::contiguous_range<IntVector>);
+static_assert(std::ranges::contiguous_range<IntArray const>);
+
+void test_contiguous_iterator() {
+  IntVector values{5, 1, 4, 2, 3};
+
+  std::span<int> view(values.begin(), values.end());
+  assert(view.size() == 5 && view.data() == values.data());
+  assert(std::to_address(values.begin() + 2) == values.data() + 2);
+
+  auto it = values.begin() + 1;
+  assert(it[2] == 2 && *it == 1); // Indexing leaves the iterator alone.
+  auto before = it--;
+  assert(*before == 1 && *it == 5);
+  assert(*(2 + it) == 4 && (values.end() - it) == 5);
+
+  std::ranges::sort(values);
+  assert(std::ranges::equal(values, IntVector{1, 2, 3, 4, 5}));
+
+  IntArray array{};
+  std::ranges::copy(values.begin(), values.begin() + 4, array.begin());
+  std::span<int const> constView(array.cbegin(), array.cend());
+  assert(constView.back() == 4);
+}
+
+void test_ring_iterator() {
+  mystl::RingBuffer<int> ring;
+  for (int i = 0; i < 6; ++i) {
+    ring.push_back(i);
+  }
+
+  auto it = ring.begin() + 3;
+  assert(it[1] == 4 && *it == 3);
+  auto before = it--;
+  assert(*before == 3 && *it == 2);
+  assert(*(1 + it) == 3);
+  assert(std::ranges::find(ring, 5) == ring.end() - 1);
+}
+
+void test_node_iterators() {
+  mystl::List<int> list;
+  mystl::UnrolledList<int> unrolled;
+  for (int i = 0; i < 100; ++i) {
+    list.push_back(i);
+    unrolled.push_back(i);
+  }
+
+  auto listIt = std::ranges::next(list.begin(), 10);
+  auto listBefore = listIt--;
+  assert(*listBefore == 10 && *listIt == 9);
+
+  auto unrolledIt = std::ranges::prev(unrolled.end());
+  auto unrolledBefore = unrolledIt--;
+  assert(*unrolledBefore == 99 && *unrolledIt == 98);
+  assert(std::ranges::distance(unrolled) == 100);
+}
+
+} // namespace
+
+void test_iterator() {
+  test_contiguous_iterator();
+  test_ring_iterator();
+  test_node_iterators();
+}
@@ -0,0 +1,229 @@
+#include "MySTL/List.h"
+
+#include <cassert>
+#include <string>
+#include <thread>
+
+using IntList = mystl::List<int>;
+
+namespace {
+
+bool equals(IntList const &list, std::initializer_list<int> expected) {
+  if (list.size() != expected.size()) {
+    return false;
+  }
+  auto value = expected.begin();
+  for (auto it = list.begin(); it != list.end(); ++it, ++value) {
+    if (*it != *value) {
+      return false;
+    }
+  }
+  return true;
+}
+
+IntList::iterator nth(IntList &list, int index) {
+  auto it = list.begin();
+  while (index-- > 0) {
+    ++it;
+  }
+  return it;
+}
+
+} // namespace
+
+void test_list_modifiers() {
+  IntList list;
+  assert(list.empty());
+  assert(list.begin() == list.end());
+
+  list.push_back(2);
+  list.push_front(1);
+  list.emplace_back(3);
+  assert(equals(list, {1, 2, 3}));
+
+  auto it = list.begin();
+  ++it;
+  list.insert(it, 10);
+  list.insert(list.end(), 20);
+  list.insert(list.begin(), 0);
+  assert(equals(list, {0, 1, 10, 2, 3, 20}));
+
+  it = list.begin();
+  ++it;
+  it = list.erase(it);
+  assert(*it == 10);
+  assert(equals(list, {0, 10, 2, 3, 20}));
+
+  auto last = it;
+  ++last;
+  ++last;
+  list.erase(it, last);
+  assert(equals(list, {0, 3, 20}));
+
+  list.pop_front();
+  list.pop_back();
+  assert(equals(list, {3}));
+  list.pop_back();
+  assert(list.empty());
+  assert(list.begin() == list.end());
+}
+
+void test_list_copy_move() {
+  IntList list{1, 2, 3};
+  IntList copy(list);
+  assert(equals(copy, {1, 2, 3}));
+
+  IntList moved(std::move(list));
+  assert(list.empty());
+  assert(equals(moved, {1, 2, 3}));
+  moved.push_back(4);
+  assert(moved.back() == 4);
+
+  // end() stays put while the list changes, and a moved-from list is
+  // usable again.
+  auto end = moved.end();
+  moved.push_front(0);
+  moved.pop_front();
+  assert(end == moved.end() && *--end == 4);
+  list.push_back(5);
+  assert(equals(list, {5}) && *--list.end() == 5);
+
+  copy = moved;
+  assert(equals(copy, {1, 2, 3, 4}));
+
+  // Walking backwards from end() reaches every element.
+  int expected = 4;
+  auto it = copy.end();
+  do {
+    --it;
+    assert(*it == expected--);
+  } while (it != copy.begin());
+
+  mystl::List<std::string> strings(3, "abc");
+  strings.emplace_front(5, 'x');
+  assert(strings.front() == "xxxxx");
+  assert(strings.size() == 4);
+}
+
+void test_list_node_pool() {
+  IntList list;
+  for (int i = 0; i < 100; ++i) {
+    list.push_back(i);
+  }
+
+  // A freed node is the next one handed out.
+  int const *back = &list.back();
+  list.pop_back();
+  list.push_front(-1);
+  assert(&list.front() == back);
+
+  // Copies get their own pool; moves take the pool along.
+  IntList copy(list);
+  assert(!(copy.get_allocator() == list.get_allocator()));
+  IntList moved(std::move(list));
+  assert(moved.front() == -1 && moved.size() == 100);
+
+  // The moved-from list keeps nothing of the pool. Reusing it starts a new
+  // one, so the moved-to list can go to another thread meanwhile.
+  std::thread owner([taken = std::move(moved)]() mutable {
+    taken.push_back(100);
+    assert(taken.size() == 101);
+  });
+  list.push_back(1);
+  assert(equals(list, {1}));
+  owner.join();
+
+  // Moving an allocator hands its pool over.
+  mystl::PoolAllocator<int> source;
+  int *kept = source.allocate(1);
+  mystl::PoolAllocator<int> target(std::move(source));
+  assert(!(source == target));
+  target.deallocate(kept, 1);
+
+  // Lists built on one allocator share a pool.
+  mystl::PoolAllocator<int> shared;
+  IntList a(shared), b(shared);
+  a.push_back(1);
+  b.push_back(2);
+  assert(a.get_allocator() == b.get_allocator());
+
+  // Clearing a list of trivial elements drops whole chunks and the pool is
+  // reused afterwards.
+  copy.clear();
+  assert(copy.empty() && copy.begin() == copy.end());
+  copy.push_back(7);
+  assert(equals(copy, {7}));
+
+  mystl::List<std::string> strings;
+  for (int i = 0; i < 100; ++i) {
+    strings.push_back(std::string(40, 'x'));
+  }
+  strings.clear();
+  assert(strings.empty());
+}
+
+void test_list_operations() {
+  IntList list{5, 1, 4, 1, 5, 9, 2, 6, 5, 3};
+  int const *nine = &*nth(list, 5);
+  list.sort();
+  assert(equals(list, {1, 1, 2, 3, 4, 5, 5, 5, 6, 9}));
+  // Nodes are relinked, not copied.
+  assert(&list.back() == nine);
+
+  // Descending, and walking backwards still works after relinking.
+  list.sort([](int a, int b) { return a > b; });
+  assert(equals(list, {9, 6, 5, 5, 5, 4, 3, 2, 1, 1}));
+  assert(*--list.end() == 1);
+
+  list.reverse();
+  assert(equals(list, {1, 1, 2, 3, 4, 5, 5, 5, 6, 9}));
+  assert(list.unique() == 3);
+  assert(equals(list, {1, 2, 3, 4, 5, 6, 9}));
+  assert(list.remove_if([](int val) { return val % 2 == 0; }) == 3);
+  assert(equals(list, {1, 3, 5, 9}));
+  // The argument may be an element of the list itself.
+  assert(list.remove(list.front()) == 1);
+  assert(equals(list, {3, 5, 9}));
+
+  // Lists on one allocator share nodes, so merge and splice only relink.
+  mystl::PoolAllocator<int> shared;
+  IntList a({1, 4, 7}, shared), b({2, 4, 8, 9}, shared);
+  int const *eight = &*nth(b, 2);
+  a.merge(b);
+  assert(b.empty() && equals(a, {1, 2, 4, 4, 7, 8, 9}));
+  assert(&*nth(a, 5) == eight);
+
+  b.splice(b.end(), a);
+  assert(a.empty() && b.size() == 7);
+  a.splice(a.begin(), b, nth(b, 1));
+  a.splice(a.end(), b, b.begin(), nth(b, 3));
+  assert(equals(a, {2, 1, 4, 4}) && equals(b, {7, 8, 9}));
+
+  // Moving a range within one list.
+  b.splice(b.begin(), b, nth(b, 1), b.end());
+  assert(equals(b, {8, 9, 7}));
+  b.splice(b.end(), b, b.begin());
+  assert(equals(b, {9, 7, 8}));
+  assert(*--b.end() == 8);
+
+  // Separate pools cannot trade nodes, so elements are moved instead.
+  // merge needs both lists sorted.
+  IntList c{3, 5};
+  b.sort();
+  c.merge(b);
+  assert(b.empty() && equals(c, {3, 5, 7, 8, 9}));
+  c.splice(c.begin(), a);
+  assert(a.empty() && equals(c, {2, 1, 4, 4, 3, 5, 7, 8, 9}));
+
+  mystl::List<std::string> strings{"pear", "fig", "apple", "fig"};
+  strings.sort();
+  strings.unique();
+  assert(strings.size() == 3 && strings.front() == "apple");
+}
+
+void test_list() {
+  test_list_modifiers();
+  test_list_copy_move();
+  test_list_node_pool();
+  test_list_operations();
+}
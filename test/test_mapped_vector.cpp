@@ -0,0 +1,166 @@
+#include "MySTL/MappedVector.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <unistd.h>
+
+namespace {
+
+struct Record {
+  int id;
+  float value;
+};
+
+using WritableRecords = mystl::MappedVector<Record, mystl::MapMode::ReadWrite>;
+using ReadOnlyRecords = mystl::MappedVector<Record>;
+
+// A read-only mapping hands out const elements and cannot grow, so writes
+// fail to compile rather than fault on the read-only pages.
+template <typename Vector_t>
+concept writable = requires(Vector_t vec, Record record) {
+  vec[0] = record;
+};
+template <typename Vector_t>
+concept growable = requires(Vector_t vec, Record record) {
+  vec.push_back(record);
+};
+static_assert(writable<WritableRecords> && growable<WritableRecords>);
+static_assert(!writable<ReadOnlyRecords> && !growable<ReadOnlyRecords>);
+static_assert(std::is_same_v<
+              decltype(*std::declval<ReadOnlyRecords &>().begin()),
+              Record const &>);
+
+std::string temp_path() {
+  char path[] = "/tmp/mystl_mappedXXXXXX";
+  int file = ::mkstemp(path);
+  assert(file >= 0);
+  ::close(file);
+  return path;
+}
+
+} // namespace
+
+void test_mapped_vector() {
+  std::string path = temp_path();
+
+  // Write a dataset through a growing read-write mapping.
+  {
+    WritableRecords records(path.c_str());
+    assert(records.empty());
+    for (int i = 0; i < 10000; ++i) {
+      records.push_back({i, i * 0.5f});
+    }
+    assert(records.size() == 10000 && records.capacity() >= 10000);
+    records[0].value = -1.0f;
+    records.sync();
+  }
+
+  // The file was trimmed to exactly size() elements on close.
+  {
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    std::fseek(file, 0, SEEK_END);
+    assert(std::ftell(file) == long(10000 * sizeof(Record)));
+    std::fclose(file);
+  }
+
+  // Reopen read-only: the elements are there without any copy.
+  {
+    mystl::MappedVector<Record> const records(path.c_str());
+    assert(records.size() == 10000);
+    assert(records.front().value == -1.0f);
+    assert(records.back().id == 9999 && records[42].value == 21.0f);
+
+    long sum = 0;
+    for (Record const &record : records) {
+      sum += record.id;
+    }
+    assert(sum == 9999L * 10000 / 2);
+
+    bool threw = false;
+    try {
+      (void)records[10000];
+    } catch (std::out_of_range const &) {
+      threw = true;
+    }
+    assert(threw);
+  }
+
+  // Moving hands the mapping over.
+  {
+    mystl::MappedVector<Record> records(path.c_str());
+    assert(records.size() == 10000);
+    mystl::MappedVector<Record> moved(std::move(records));
+    assert(!records.is_open() && moved.size() == 10000);
+  }
+
+  // Shrink, resize and reopen for writing.
+  {
+    WritableRecords records(path.c_str());
+    records.resize(100);
+    records.shrink_to_fit();
+    assert(records.capacity() == 100);
+    records.resize(150, Record{-1, 0});
+    assert(records[149].id == -1 && records[99].id == 99);
+  }
+  {
+    mystl::MappedVector<Record> records(path.c_str());
+    assert(records.size() == 150 && records[120].id == -1);
+  }
+
+  // A file that is not a whole number of elements is rejected.
+  {
+    std::FILE *file = std::fopen(path.c_str(), "ab");
+    std::fputc(0, file);
+    std::fclose(file);
+
+    bool threw = false;
+    try {
+      mystl::MappedVector<Record> records(path.c_str());
+    } catch (std::system_error const &) {
+      // Opening or mapping failed; not the error under test.
+    } catch (std::runtime_error const &error) {
+      threw = std::string(error.what()).find("multiple of the element size") !=
+              std::string::npos;
+    }
+    assert(threw);
+  }
+
+  std::remove(path.c_str());
+
+  // A directory opens and has a size, but cannot be mapped; the failed
+  // open leaves nothing behind to read through.
+  {
+    char directory[] = "/tmp/mystl_mappedXXXXXX";
+    assert(::mkdtemp(directory) != nullptr);
+    std::string inside = std::string(directory) + "/entry";
+    std::fclose(std::fopen(inside.c_str(), "wb"));
+
+    mystl::MappedVector<char> bytes;
+    bool threw = false;
+    try {
+      bytes.open(directory);
+    } catch (std::system_error const &) {
+      threw = true;
+    }
+    assert(!threw || (!bytes.is_open() && bytes.empty() &&
+                      bytes.data() == nullptr));
+    bytes.close();
+    std::remove(inside.c_str());
+    ::rmdir(directory);
+  }
+
+  bool threw = false;
+  try {
+    mystl::MappedVector<Record> records(path.c_str());
+  } catch (std::system_error const &error) {
+    threw = error.code() == std::errc::no_such_file_or_directory;
+  }
+  assert(threw);
+}
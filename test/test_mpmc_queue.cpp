@@ -0,0 +1,102 @@
+#include "MySTL/MpmcQueue.h"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void test_mpmc_queue_single_thread() {
+  mystl::MpmcQueue<std::string> queue(3);
+  assert(queue.capacity() == 4 && queue.empty());
+
+  for (int lap = 0; lap < 3; ++lap) {
+    for (int i = 0; i < 4; ++i) {
+      assert(queue.try_push(std::to_string(i)));
+    }
+    assert(!queue.try_push("full") && queue.size() == 4);
+    std::string out;
+    for (int i = 0; i < 4; ++i) {
+      assert(queue.try_pop(out) && out == std::to_string(i));
+    }
+    assert(!queue.try_pop(out));
+  }
+
+  using namespace std::chrono_literals;
+  std::string out;
+  auto start = std::chrono::steady_clock::now();
+  assert(!queue.try_pop_for(out, 20ms));
+  assert(std::chrono::steady_clock::now() - start >= 20ms);
+
+  queue.push("a");
+  assert(queue.try_pop_for(out, 1s) && out == "a");
+  assert(queue.try_push_for("b", 0ms));
+  // Left in the queue to be destroyed with it.
+}
+
+void test_mpmc_queue_threads() {
+  constexpr int threadCount = 4;
+  constexpr int perThread = 20000;
+  mystl::MpmcQueue<int> queue(16);
+  std::atomic<long> sum{0};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t) {
+    threads.emplace_back([&queue, t] {
+      for (int i = 1; i <= perThread; ++i) {
+        queue.push(t * perThread + i);
+      }
+    });
+    threads.emplace_back([&queue, &sum] {
+      long local = 0;
+      for (int i = 0; i < perThread; ++i) {
+        int value;
+        queue.pop(value);
+        local += value;
+      }
+      sum += local;
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  long total = long(threadCount) * perThread;
+  assert(sum == total * (total + 1) / 2);
+  assert(queue.empty());
+}
+
+// A producer blocked on a full queue wakes once a consumer makes room.
+void test_mpmc_queue_blocking() {
+  mystl::MpmcQueue<int> queue(2);
+  queue.push(1);
+  queue.push(2);
+
+  std::atomic<bool> pushed{false};
+  std::thread producer([&] {
+    queue.push(3);
+    pushed = true;
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  assert(!pushed);
+  int value;
+  queue.pop(value);
+  assert(value == 1);
+  producer.join();
+  assert(pushed);
+  queue.pop(value);
+  queue.pop(value);
+  assert(value == 3);
+}
+
+} // namespace
+
+void test_mpmc_queue() {
+  test_mpmc_queue_single_thread();
+  test_mpmc_queue_threads();
+  test_mpmc_queue_blocking();
+}
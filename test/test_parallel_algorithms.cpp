@@ -0,0 +1,174 @@
+#include "MySTL/Array.h"
+#include "MySTL/List.h"
+#include "MySTL/ParallelAlgorithms.h"
+#include "MySTL/ThreadPool.h"
+#include "MySTL/Vector.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+void test_thread_pool() {
+  mystl::ThreadPool pool(4);
+  assert(pool.thread_count() == 4);
+
+  constexpr std::size_t iterationCount = 10000;
+  auto seen = std::make_unique<std::atomic<int>[]>(iterationCount);
+  pool.parallel_for(iterationCount, [&](std::size_t i) {
+    seen[i].fetch_add(1, std::memory_order_relaxed);
+  });
+  for (std::size_t i = 0; i < iterationCount; ++i) {
+    assert(seen[i].load() == 1);
+  }
+
+  // Every grain, down to single iterations and past the whole range, still
+  // runs each iteration once.
+  std::size_t const grains[] = {1, 3, 64, 20000};
+  for (std::size_t grain : grains) {
+    auto runs = std::make_unique<std::atomic<int>[]>(iterationCount);
+    pool.parallel_for(
+        iterationCount,
+        [&](std::size_t i) { runs[i].fetch_add(1, std::memory_order_relaxed); },
+        grain);
+    for (std::size_t i = 0; i < iterationCount; ++i) {
+      assert(runs[i].load() == 1);
+    }
+  }
+
+  // A long loop of trivial iterations is cut into a few ranges, not one
+  // task per iteration.
+  std::atomic<std::uint64_t> sum{0};
+  pool.parallel_for(std::size_t{50000000}, [&](std::size_t i) {
+    if (i % 1000000 == 0) {
+      sum.fetch_add(i, std::memory_order_relaxed);
+    }
+  });
+  assert(sum.load() == std::uint64_t{1225000000});
+
+  // Nested loops run on the workers that wait for them.
+  std::atomic<int> inner{0};
+  pool.parallel_for(16, [&](std::size_t) {
+    pool.parallel_for(16, [&](std::size_t) {
+      inner.fetch_add(1, std::memory_order_relaxed);
+    });
+  });
+  assert(inner.load() == 256);
+
+  bool thrown = false;
+  try {
+    pool.parallel_for(100, [](std::size_t i) {
+      if (i == 42) {
+        throw std::runtime_error("iteration 42");
+      }
+    });
+  } catch (std::runtime_error const &) {
+    thrown = true;
+  }
+  assert(thrown);
+
+  // Still usable afterwards.
+  std::atomic<int> count{0};
+  pool.parallel_for(3, [&](std::size_t) { ++count; });
+  assert(count.load() == 3);
+}
+
+void test_parallel_algorithms_vector() {
+  mystl::ThreadPool pool(3);
+  auto par = mystl::execution::par.on(pool);
+
+  // Several chunks, the last one partial.
+  constexpr std::size_t length = 100003;
+  mystl::Vector<std::int64_t> values(length, 0);
+  for (std::size_t i = 0; i < length; ++i) {
+    values[i] = static_cast<std::int64_t>(i);
+  }
+  std::int64_t const total =
+      static_cast<std::int64_t>(length) * (length - 1) / 2;
+
+  assert(mystl::algo::reduce(par, values.begin(), values.end(),
+                             std::int64_t{0}) == total);
+  assert(mystl::algo::reduce(mystl::execution::seq, values.begin(),
+                             values.end(), std::int64_t{0}) == total);
+  assert(mystl::algo::reduce(mystl::execution::par_unseq.on(pool),
+                             values.data(), values.data() + length,
+                             std::int64_t{5}) == total + 5);
+
+  std::atomic<std::int64_t> visited{0};
+  mystl::algo::for_each(par, values.begin(), values.end(),
+                        [&visited](std::int64_t value) {
+                          visited.fetch_add(value, std::memory_order_relaxed);
+                        });
+  assert(visited.load() == total);
+
+  mystl::Vector<std::int64_t> doubled(length, 0);
+  mystl::algo::transform(par, values.begin(), values.end(), doubled.begin(),
+                         [](std::int64_t value) { return 2 * value; });
+  assert(doubled[length - 1] == 2 * (length - 1));
+  assert(mystl::algo::transform_reduce(par, values.begin(), values.end(),
+                                       std::int64_t{0}, std::plus<>(),
+                                       [](std::int64_t value) {
+                                         return value % 3;
+                                       }) ==
+         mystl::algo::transform_reduce(values.begin(), values.end(),
+                                       std::int64_t{0}, std::plus<>(),
+                                       [](std::int64_t value) {
+                                         return value % 3;
+                                       }));
+  assert(mystl::algo::transform_reduce(par, values.begin(), values.end(),
+                                       doubled.begin(), std::int64_t{0}) ==
+         mystl::algo::transform_reduce(values.begin(), values.end(),
+                                       doubled.begin(), std::int64_t{0}));
+
+  mystl::algo::inclusive_scan(par, values.begin(), values.end(),
+                              doubled.begin());
+  for (std::size_t i = 0; i < length; ++i) {
+    assert(doubled[i] == static_cast<std::int64_t>(i * (i + 1) / 2));
+  }
+  // In place.
+  mystl::algo::inclusive_scan(par, values.begin(), values.end(),
+                              values.begin());
+  assert(values[length - 1] == total);
+
+  mystl::algo::fill(par, values.begin(), values.end(), std::int64_t{7});
+  mystl::algo::copy(par, values.begin(), values.end(), doubled.begin());
+  assert(doubled[0] == 7 && doubled[length - 1] == 7);
+}
+
+void test_parallel_algorithms_other_ranges() {
+  mystl::ThreadPool pool(2);
+  auto par = mystl::execution::par.on(pool);
+
+  mystl::Array<int, 5> array{1, 2, 3, 4, 5};
+  assert(mystl::algo::reduce(par, array.begin(), array.end(), 0) == 15);
+
+  // Not contiguous: runs sequentially, in order.
+  mystl::List<std::string> words{"a", "b", "c"};
+  assert(mystl::algo::reduce(par, words.begin(), words.end(),
+                             std::string()) == "abc");
+
+  // Only associativity is required: the chunk results are combined in
+  // order.
+  mystl::Vector<std::string> letters(40000, "x");
+  letters[0] = "a";
+  letters[39999] = "z";
+  std::string joined =
+      mystl::algo::reduce(par, letters.begin(), letters.end(), std::string());
+  assert(joined.size() == 40000 && joined.front() == 'a' &&
+         joined.back() == 'z');
+
+  mystl::Vector<int> empty;
+  assert(mystl::algo::reduce(par, empty.begin(), empty.end(), 3) == 3);
+}
+
+} // namespace
+
+void test_parallel_algorithms() {
+  test_thread_pool();
+  test_parallel_algorithms_vector();
+  test_parallel_algorithms_other_ranges();
+}
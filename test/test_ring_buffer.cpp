@@ -0,0 +1,106 @@
+#include "MySTL/Queue.h"
+#include "MySTL/RingBuffer.h"
+
+#include <cassert>
+#include <span>
+#include <string>
+#include <utility>
+
+namespace {
+
+void test_ring_buffer_wraps() {
+  mystl::RingBuffer<int> ring;
+  ring.reserve(5);
+  assert(ring.capacity() == 8);
+
+  // Walk the head around the buffer several times without growing.
+  int next = 0;
+  for (int i = 0; i < 6; ++i) {
+    ring.push_back(next++);
+  }
+  for (int round = 0; round < 20; ++round) {
+    assert(ring.front() == next - 6);
+    ring.pop_front();
+    ring.push_back(next++);
+  }
+  assert(ring.size() == 6 && ring.capacity() == 8);
+  assert(ring.back() == next - 1 && ring[1] == next - 5);
+
+  int expected = next - 6;
+  for (int value : ring) {
+    assert(value == expected++);
+  }
+  assert(ring.end() - ring.begin() == 6);
+
+  // Growing while wrapped puts the elements back in order from index 0.
+  for (int i = 0; i < 10; ++i) {
+    ring.push_back(next++);
+  }
+  assert(ring.capacity() == 16 && ring.size() == 16);
+  for (std::size_t i = 0; i < ring.size(); ++i) {
+    assert(ring[i] == next - 16 + int(i));
+  }
+
+  ring.push_front(-1);
+  assert(ring.front() == -1 && ring.size() == 17);
+  ring.pop_back();
+  assert(ring.back() == next - 2);
+}
+
+void test_ring_buffer_bulk() {
+  mystl::RingBuffer<int> ring;
+  int values[12];
+  for (int i = 0; i < 12; ++i) {
+    values[i] = i;
+  }
+
+  // Offset the head so the bulk copies straddle the end of the buffer.
+  ring.push_n(std::span<int const>{values, 6});
+  int out[12] = {};
+  assert(ring.pop_n(std::span<int>{out, 5}) == 5);
+  assert(out[4] == 4 && ring.size() == 1);
+  ring.push_n(std::span<int const>{values, 7});
+  assert(ring.capacity() == 8 && ring.size() == 8);
+
+  assert(ring.pop_n(out) == 8);
+  assert(out[0] == 5 && out[1] == 0 && out[7] == 6);
+  assert(ring.empty() && ring.pop_n(out) == 0);
+
+  mystl::RingBuffer<std::string> strings{"a", "b", "c"};
+  strings.pop_front();
+  strings.push_back("d");
+  strings.push_back("e");
+  std::string taken[2];
+  assert(strings.pop_n(taken) == 2);
+  assert(taken[0] == "b" && taken[1] == "c" && strings.front() == "d");
+
+  mystl::RingBuffer<std::string> copy(strings);
+  mystl::RingBuffer<std::string> moved(std::move(strings));
+  assert(strings.empty() && moved.size() == 2 && copy.back() == "e");
+  copy = moved;
+  copy.push_back("f");
+  assert(copy.size() == 3 && moved.size() == 2);
+  copy.shrink_to_fit();
+  assert(copy.capacity() == 4 && copy[2] == "f");
+}
+
+void test_queue_is_fifo() {
+  mystl::Queue<std::string> queue;
+  for (int i = 0; i < 100; ++i) {
+    queue.push(std::to_string(i));
+  }
+  for (int i = 0; i < 100; ++i) {
+    assert(queue.front() == std::to_string(i));
+    queue.pop();
+    queue.emplace(std::to_string(100 + i));
+  }
+  assert(queue.size() == 100 && queue.back() == "199");
+}
+
+} // namespace
+
+void test_ring_buffer() {
+  test_ring_buffer_wraps();
+  test_ring_buffer_bulk();
+  test_queue_is_fifo();
+}
@@ -0,0 +1,116 @@
+#include "MySTL/SmallVector.h"
+#include "MySTL/Stack.h"
+
+#include <cassert>
+#include <string>
+#include <type_traits>
+
+using Small = mystl::SmallVector<std::string, 4>;
+
+static_assert(std::is_same_v<mystl::SmallVector<int, 4>::iterator,
+                             mystl::ContiguousIterator<
+                                 mystl::SmallVector<int, 4>>>);
+
+void test_small_vector_spill() {
+  Small vec;
+  assert(vec.is_inline());
+  assert(vec.capacity() == 4);
+
+  for (int i = 0; i < 4; ++i) {
+    vec.push_back(std::to_string(i));
+  }
+  assert(vec.is_inline());
+
+  vec.push_back("4");
+  assert(!vec.is_inline());
+  assert(vec.capacity() > 4);
+  for (int i = 0; i < 5; ++i) {
+    assert(vec[i] == std::to_string(i));
+  }
+
+  vec.erase(1, 3);
+  vec.shrink_to_fit();
+  assert(vec.is_inline());
+  assert(vec.size() == 2 && vec.front() == "0" && vec.back() == "4");
+
+  vec.insert(1, "x", 2);
+  assert(vec.size() == 4 && vec[1] == "x" && vec[2] == "x");
+
+  vec.clear();
+  assert(vec.is_inline() && vec.empty());
+}
+
+void test_small_vector_copy_move() {
+  Small inlined{std::string("a"), std::string("b")};
+  Small spilled(10, std::string("long enough to not be sso"));
+
+  Small copy(inlined);
+  assert(copy.is_inline() && copy.size() == 2 && copy.back() == "b");
+
+  Small moved(std::move(inlined));
+  assert(moved.is_inline() && moved.size() == 2 && moved.front() == "a");
+  assert(inlined.empty() && inlined.is_inline());
+
+  Small movedHeap(std::move(spilled));
+  assert(!movedHeap.is_inline() && movedHeap.size() == 10);
+  assert(spilled.empty() && spilled.is_inline());
+
+  copy = movedHeap;
+  assert(copy.size() == 10);
+  movedHeap = std::move(moved);
+  assert(movedHeap.size() == 2 && movedHeap.is_inline());
+
+  // Trivially relocatable elements grow with realloc once on the heap.
+  mystl::SmallVector<int, 8> ints;
+  for (int i = 0; i < 1000; ++i) {
+    ints.push_back(i);
+  }
+  for (int i = 0; i < 1000; ++i) {
+    assert(ints[i] == i);
+  }
+  while (ints.size() > 2) {
+    ints.pop_back();
+  }
+  assert(ints.back() == 1);
+}
+
+// SmallVector is a Vector with inline storage, so it has every Vector
+// member; plain Vectors pay nothing for the option.
+static_assert(sizeof(mystl::Vector<int>) == 3 * sizeof(void *));
+
+void test_small_vector_vector_api() {
+  mystl::SmallVector<int, 4> ints{1, 5};
+  int middle[] = {2, 3, 4};
+  ints.insert(ints.cbegin() + 1, middle, middle + 3);
+  assert(!ints.is_inline() && ints.size() == 5);
+  for (int i = 0; i < 5; ++i) {
+    assert(ints[i] == i + 1);
+  }
+
+  mystl::SmallVector<char, 16> buffer;
+  buffer.resize_and_overwrite(8, [](char *data, std::size_t) {
+    data[0] = 'h';
+    data[1] = 'i';
+    return 2;
+  });
+  assert(buffer.is_inline() && buffer.size() == 2 && buffer.back() == 'i');
+}
+
+void test_small_vector_stack() {
+  mystl::Stack<int, mystl::SmallVector<int, 8>> stack;
+  for (int i = 0; i < 20; ++i) {
+    stack.push(i);
+  }
+  for (int i = 19; i >= 0; --i) {
+    assert(stack.top() == i);
+    stack.pop();
+  }
+  assert(stack.empty());
+}
+
+void test_small_vector() {
+  test_small_vector_spill();
+  test_small_vector_copy_move();
+  test_small_vector_vector_api();
+  test_small_vector_stack();
+}
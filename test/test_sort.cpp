@@ -0,0 +1,210 @@
+#include "MySTL/Array.h"
+#include "MySTL/Sort.h"
+#include "MySTL/Vector.h"
+
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace {
+
+template <typename T, typename Compare = std::less<>>
+bool is_sorted(mystl::Vector<T> const &values, Compare comp = {}) {
+  for (std::size_t i = 1; i < values.size(); ++i) {
+    if (comp(values[i], values[i - 1])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Inputs that exercise each of pdqsort's paths.
+void fill_input(mystl::Vector<int> &values, int pattern, std::mt19937 &rng) {
+  std::size_t size = values.size();
+  for (std::size_t i = 0; i < size; ++i) {
+    int index = static_cast<int>(i);
+    switch (pattern) {
+    case 0: values[i] = static_cast<int>(rng()); break;
+    case 1: values[i] = index; break;
+    case 2: values[i] = -index; break;
+    case 3: values[i] = static_cast<int>(rng() % 4); break;
+    case 4: values[i] = index % 2 == 0 ? index : -index; break; // Zig-zag.
+    default: values[i] = index < int(size) / 2 ? index : int(size) - index;
+    }
+  }
+}
+
+void test_sort_patterns() {
+  std::mt19937 rng(7);
+  std::size_t const sizes[] = {0, 1, 2, 5, 23, 24, 25, 100, 129, 1000, 50000};
+  for (std::size_t size : sizes) {
+    for (int pattern = 0; pattern < 6; ++pattern) {
+      // Branchless paths (int with std::less) ...
+      mystl::Vector<int> values(size, 0);
+      fill_input(values, pattern, rng);
+      mystl::algo::sort(values.begin(), values.end());
+      assert(is_sorted(values));
+
+      // ... and the generic ones.
+      mystl::Vector<int> copy(size, 0);
+      fill_input(copy, pattern, rng);
+      auto greater = [](int a, int b) { return a > b; };
+      mystl::algo::sort(copy.data(), copy.data() + size, greater);
+      assert(is_sorted(copy, greater));
+    }
+  }
+
+  mystl::Vector<std::string> words{"pear", "fig", "apple", "kiwi", "date"};
+  mystl::algo::sort(words.begin(), words.end());
+  assert(words[0] == "apple" && words[4] == "pear");
+
+  mystl::Array<double, 4> array{3.5, -1.0, 2.0, 0.0};
+  mystl::algo::sort(array.begin(), array.end(), std::greater<>());
+  assert(array[0] == 3.5 && array[3] == -1.0);
+}
+
+void test_sort_networks() {
+  // A comparator network sorts everything iff it sorts every 0/1 input.
+  using mystl::algo::internal::network_max_size;
+  std::less<> less;
+  for (std::size_t size = 0; size <= 16; ++size) {
+    for (std::uint32_t bits = 0; bits < (1u << size); ++bits) {
+      int values[network_max_size];
+      for (std::size_t i = 0; i < size; ++i) {
+        values[i] = (bits >> i) & 1;
+      }
+      mystl::algo::internal::network_sort(values, values + size, less);
+      for (std::size_t i = 1; i < size; ++i) {
+        assert(values[i - 1] <= values[i]);
+      }
+    }
+  }
+
+  std::mt19937 rng(3);
+  for (std::size_t size = 17; size <= network_max_size; ++size) {
+    for (int round = 0; round < 1000; ++round) {
+      int values[network_max_size];
+      for (std::size_t i = 0; i < size; ++i) {
+        values[i] = static_cast<int>(rng() % 8);
+      }
+      mystl::algo::internal::network_sort(values, values + size, less);
+      for (std::size_t i = 1; i < size; ++i) {
+        assert(values[i - 1] <= values[i]);
+      }
+    }
+  }
+}
+
+struct Record {
+  int m_Key;
+  int m_Order;
+};
+
+void test_stable_sort() {
+  std::mt19937 rng(11);
+  for (std::size_t size : {0, 1, 31, 33, 100, 1000, 5000}) {
+    mystl::Vector<Record> records(size, Record{0, 0});
+    for (std::size_t i = 0; i < size; ++i) {
+      records[i] = Record{static_cast<int>(rng() % 10), static_cast<int>(i)};
+    }
+    mystl::algo::stable_sort(records.begin(), records.end(),
+                             [](Record const &a, Record const &b) {
+                               return a.m_Key < b.m_Key;
+                             });
+    for (std::size_t i = 1; i < size; ++i) {
+      assert(records[i - 1].m_Key < records[i].m_Key ||
+             (records[i - 1].m_Key == records[i].m_Key &&
+              records[i - 1].m_Order < records[i].m_Order));
+    }
+
+    // Integers in ascending order go through the radix sort.
+    mystl::Vector<std::int64_t> numbers(size, 0);
+    for (std::size_t i = 0; i < size; ++i) {
+      numbers[i] = static_cast<std::int64_t>(rng()) - (1ll << 31);
+    }
+    mystl::algo::stable_sort(numbers.begin(), numbers.end());
+    assert(is_sorted(numbers));
+  }
+
+  mystl::Vector<std::string> words(100, "b");
+  words[50] = "a";
+  mystl::algo::stable_sort(words.begin(), words.end());
+  assert(words[0] == "a" && words[99] == "b");
+}
+
+void test_partial_sort() {
+  std::mt19937 rng(5);
+  mystl::Vector<int> values(1000, 0);
+  fill_input(values, 0, rng);
+  mystl::Vector<int> sorted(values);
+  mystl::algo::sort(sorted.begin(), sorted.end());
+
+  mystl::algo::partial_sort(values.data(), values.data() + 10,
+                            values.data() + 1000);
+  for (std::size_t i = 0; i < 10; ++i) {
+    assert(values[i] == sorted[i]);
+  }
+  // The rest is still the remaining elements.
+  mystl::algo::sort(values.data() + 10, values.data() + 1000);
+  for (std::size_t i = 10; i < 1000; ++i) {
+    assert(values[i] == sorted[i]);
+  }
+
+  mystl::algo::partial_sort(values.begin(), values.begin(), values.end());
+}
+
+void test_radix_sort() {
+  std::mt19937_64 rng(13);
+  for (std::size_t size : {0, 10, 255, 256, 10000}) {
+    mystl::Vector<std::int32_t> ints(size, 0);
+    mystl::Vector<double> doubles(size, 0.0);
+    mystl::Vector<std::uint16_t> shorts(size, 0);
+    for (std::size_t i = 0; i < size; ++i) {
+      ints[i] = static_cast<std::int32_t>(rng());
+      doubles[i] = static_cast<double>(static_cast<std::int64_t>(rng())) /
+                   double(rng() | 1);
+      shorts[i] = static_cast<std::uint16_t>(rng() % 7);
+    }
+    if (size > 3) {
+      doubles[0] = -0.0;
+      doubles[1] = 0.0;
+      doubles[2] = -1e300;
+    }
+    mystl::algo::radix_sort(ints.begin(), ints.end());
+    mystl::algo::radix_sort(doubles.begin(), doubles.end());
+    mystl::algo::radix_sort(shorts.data(), shorts.data() + size);
+    assert(is_sorted(ints) && is_sorted(doubles) && is_sorted(shorts));
+  }
+
+  // By a projection, stably, moving non-trivial elements.
+  mystl::Vector<std::string> words{"ccc", "a", "bb", "x", "dddd", "yy"};
+  mystl::algo::radix_sort(words.begin(), words.end(),
+                          [](std::string const &word) {
+                            return static_cast<float>(word.size());
+                          });
+  assert(words[0] == "a" && words[1] == "x" && words[2] == "bb" &&
+         words[3] == "yy" && words[5] == "dddd");
+
+  mystl::Vector<Record> records(1000, Record{0, 0});
+  for (int i = 0; i < 1000; ++i) {
+    records[i] = Record{(i * 7919) % 100 - 50, i};
+  }
+  mystl::algo::radix_sort(records.begin(), records.end(),
+                          [](Record const &record) { return record.m_Key; });
+  for (std::size_t i = 1; i < 1000; ++i) {
+    assert(records[i - 1].m_Key < records[i].m_Key ||
+           (records[i - 1].m_Key == records[i].m_Key &&
+            records[i - 1].m_Order < records[i].m_Order));
+  }
+}
+
+} // namespace
+
+void test_sort() {
+  test_sort_patterns();
+  test_sort_networks();
+  test_stable_sort();
+  test_partial_sort();
+  test_radix_sort();
+}
@@ -0,0 +1,98 @@
+#include "MySTL/SpscQueue.h"
+
+#include <cassert>
+#include <span>
+#include <string>
+#include <thread>
+
+namespace {
+
+void test_spsc_queue_single_thread() {
+  mystl::SpscQueue<int, 4> fixed;
+  assert(fixed.capacity() == 4 && fixed.empty());
+  for (int i = 0; i < 4; ++i) {
+    assert(fixed.try_push(i));
+  }
+  assert(!fixed.try_push(4) && fixed.size() == 4);
+
+  int value = -1;
+  assert(fixed.try_pop(value) && value == 0);
+  assert(fixed.try_push(4));
+
+  // Bulk pop across the wrap point.
+  int out[8] = {};
+  assert(fixed.try_pop_n(out) == 4);
+  assert(out[0] == 1 && out[3] == 4);
+  assert(!fixed.try_pop(value) && fixed.try_pop_n(out) == 0);
+
+  int values[6] = {10, 11, 12, 13, 14, 15};
+  assert(fixed.try_push_n(values) == 4);
+  assert(fixed.try_push_n(values) == 0);
+  assert(fixed.try_pop_n(std::span<int>{out, 2}) == 2 && out[1] == 11);
+  assert(fixed.try_push_n(std::span<int const>{values + 4, 2}) == 2);
+  assert(fixed.try_pop_n(out) == 4);
+  assert(out[0] == 12 && out[1] == 13 && out[2] == 14 && out[3] == 15);
+
+  mystl::SpscQueue<std::string> strings(3);
+  assert(strings.capacity() == 4);
+  assert(strings.try_emplace("aaa") && strings.try_push("b"));
+  std::string taken;
+  assert(strings.try_pop(taken) && taken == "aaa");
+  // Whatever is left is destroyed with the queue.
+  assert(strings.try_push(std::string(64, 'c')));
+}
+
+void test_spsc_queue_two_threads() {
+  constexpr int itemCount = 200000;
+  mystl::SpscQueue<int> queue(64);
+
+  std::thread producer([&queue] {
+    int batch[16];
+    for (int next = 0; next < itemCount;) {
+      if (next % 3 == 0) {
+        if (queue.try_push(next)) {
+          ++next;
+        } else {
+          std::this_thread::yield();
+        }
+        continue;
+      }
+      int count = 0;
+      for (; count < 16 && next + count < itemCount; ++count) {
+        batch[count] = next + count;
+      }
+      std::size_t pushed =
+          queue.try_push_n(std::span<int const>{batch, std::size_t(count)});
+      if (pushed == 0) {
+        std::this_thread::yield();
+      }
+      next += static_cast<int>(pushed);
+    }
+  });
+
+  int expected = 0;
+  int batch[8];
+  while (expected < itemCount) {
+    std::size_t count = queue.try_pop_n(batch);
+    for (std::size_t i = 0; i < count; ++i) {
+      assert(batch[i] == expected);
+      ++expected;
+    }
+    int value;
+    if (queue.try_pop(value)) {
+      assert(value == expected);
+      ++expected;
+    } else if (count == 0) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  assert(queue.empty());
+}
+
+} // namespace
+
+void test_spsc_queue() {
+  test_spsc_queue_single_thread();
+  test_spsc_queue_two_threads();
+}
@@ -0,0 +1,142 @@
+#include "MySTL/UnrolledList.h"
+
+#include <cassert>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+template <typename List_t>
+bool equals(List_t const &list, std::vector<int> const &expected) {
+  if (list.size() != expected.size()) {
+    return false;
+  }
+  std::size_t i = 0;
+  for (int value : list) {
+    if (value != expected[i++]) {
+      return false;
+    }
+  }
+  // Walking backwards from end() reaches every element too.
+  auto it = list.end();
+  while (i > 0) {
+    --it;
+    if (*it != expected[--i]) {
+      return false;
+    }
+  }
+  return it == list.begin();
+}
+
+void test_unrolled_list_modifiers() {
+  // Four per node, so splits and merges happen after a few elements.
+  using SmallNodes = mystl::UnrolledList<int, 4>;
+  SmallNodes list;
+  assert(list.empty() && list.begin() == list.end());
+
+  for (int i = 1; i <= 6; ++i) {
+    list.push_back(i);
+  }
+  list.push_front(0);
+  assert(equals(list, {0, 1, 2, 3, 4, 5, 6}));
+  assert(list.front() == 0 && list.back() == 6);
+
+  // Inserting into a full node splits it; the returned iterator points at
+  // the new element.
+  auto it = list.begin();
+  ++it;
+  ++it;
+  it = list.insert(it, 10);
+  assert(*it == 10 && *++it == 2);
+  assert(equals(list, {0, 1, 10, 2, 3, 4, 5, 6}));
+  list.insert(list.end(), 7);
+  assert(equals(list, {0, 1, 10, 2, 3, 4, 5, 6, 7}));
+
+  it = list.begin();
+  ++it;
+  it = list.erase(it);
+  assert(*it == 10);
+  auto last = it;
+  ++last;
+  ++last;
+  ++last;
+  it = list.erase(it, last);
+  assert(*it == 4 && equals(list, {0, 4, 5, 6, 7}));
+
+  list.pop_front();
+  list.pop_back();
+  assert(equals(list, {4, 5, 6}));
+
+  SmallNodes copy(list);
+  SmallNodes moved(std::move(list));
+  assert(list.empty() && equals(moved, {4, 5, 6}));
+  list.push_back(1);
+  copy = moved;
+  assert(equals(copy, {4, 5, 6}) && equals(list, {1}));
+
+  mystl::UnrolledList<std::string, 3> strings;
+  for (int i = 0; i < 10; ++i) {
+    strings.push_back(std::string(30, char('a' + i)));
+  }
+  strings.insert(strings.begin(), "front");
+  auto second = strings.begin();
+  ++second;
+  strings.erase(second);
+  assert(strings.front() == "front" && strings.size() == 10);
+  assert(strings.back() == std::string(30, 'j'));
+
+  // Emplacing constructs with parentheses, like List and Vector: (3, 7)
+  // is three sevens, not the list {3, 7}, and narrowing arguments work.
+  mystl::UnrolledList<std::vector<int>, 2> vectors;
+  vectors.emplace_back(3, 7);
+  vectors.emplace_front(std::size_t{2}, 1L);
+  vectors.emplace(++vectors.begin(), 1, 5);
+  vectors.emplace_back(4, 0);
+  assert(vectors.front() == std::vector<int>(2, 1));
+  assert(*++vectors.begin() == std::vector<int>(1, 5));
+  assert(vectors.back() == std::vector<int>(4, 0) && vectors.size() == 4);
+
+  mystl::UnrolledList<int, 4> narrowed;
+  long wide = 42;
+  narrowed.emplace_back(wide);
+  narrowed.emplace_front(wide + 1);
+  assert(equals(narrowed, {43, 42}));
+}
+
+// Random inserts and erases checked against std::vector.
+void test_unrolled_list_random() {
+  mystl::UnrolledList<int, 8> list;
+  std::vector<int> expected;
+  std::mt19937 random(42);
+
+  for (int step = 0; step < 4000; ++step) {
+    std::size_t index = expected.empty() ? 0 : random() % (expected.size() + 1);
+    auto it = list.begin();
+    for (std::size_t i = 0; i < index; ++i) {
+      ++it;
+    }
+
+    // Grow for the first half, then mostly shrink so nodes get merged.
+    bool grow = step < 2000 ? random() % 4 != 0 : random() % 4 == 0;
+    if (grow || index == expected.size()) {
+      it = list.insert(it, step);
+      expected.insert(expected.begin() + index, step);
+      assert(*it == step);
+    } else {
+      it = list.erase(it);
+      expected.erase(expected.begin() + index);
+      assert(index == expected.size() ? it == list.end()
+                                      : *it == expected[index]);
+    }
+  }
+  assert(equals(list, expected));
+}
+
+} // namespace
+
+void test_unrolled_list() {
+  test_unrolled_list_modifiers();
+  test_unrolled_list_random();
+}
@@ -0,0 +1,381 @@
+#include "MySTL/Vector.h"
+
+#include <cassert>
+#include <list>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+template <typename GrowthPolicy>
+void push_pop_round_trip() {
+  mystl::Vector<int, GrowthPolicy> vec;
+
+  for (int i = 0; i < 1000; ++i) {
+    vec.push_back(i);
+    assert(vec.capacity() >= vec.size());
+  }
+  assert(vec.size() == 1000);
+  assert(vec.front() == 0);
+  assert(vec.back() == 999);
+
+  while (!vec.empty()) {
+    assert(vec.back() == static_cast<int>(vec.size()) - 1);
+    vec.pop_back();
+    assert(vec.capacity() >= vec.size());
+  }
+}
+
+void test_geometric_growth() {
+  using Policy = mystl::GeometricGrowth<>;
+  static_assert(Policy::grow(0, 1) == Policy::m_MinCapacity);
+  static_assert(Policy::grow(100, 101) == 150);
+  static_assert(Policy::grow(100, 500) == 500);
+
+  mystl::Vector<int> vec;
+  std::size_t reallocations = 0;
+  std::size_t capacity = vec.capacity();
+  for (int i = 0; i < 100000; ++i) {
+    vec.push_back(i);
+    if (vec.capacity() != capacity) {
+      capacity = vec.capacity();
+      ++reallocations;
+    }
+  }
+  // 1.5x growth reaches 100000 in well under 40 steps.
+  assert(reallocations < 40);
+}
+
+void test_shrink_hysteresis() {
+  mystl::Vector<int> vec;
+  for (int i = 0; i < 1024; ++i) {
+    vec.push_back(i);
+  }
+  std::size_t capacity = vec.capacity();
+
+  // Popping a few elements must not reallocate.
+  for (int i = 0; i < 100; ++i) {
+    vec.pop_back();
+  }
+  assert(vec.capacity() == capacity);
+
+  // Alternating around the current size must not thrash either.
+  for (int i = 0; i < 100; ++i) {
+    vec.push_back(i);
+    vec.pop_back();
+  }
+  assert(vec.capacity() == capacity);
+
+  // Dropping below a quarter shrinks, but leaves room to grow again.
+  vec.erase(0, vec.size() - capacity / 8);
+  assert(vec.capacity() < capacity);
+  assert(vec.capacity() >= 2 * vec.size());
+}
+
+void test_shrink_to_fit() {
+  mystl::Vector<int> vec;
+  vec.reserve(100);
+  assert(vec.capacity() == 100);
+
+  vec.push_back(1);
+  vec.push_back(2);
+  vec.shrink_to_fit();
+  assert(vec.capacity() == 2);
+  assert(vec.front() == 1);
+  assert(vec.back() == 2);
+}
+
+void test_policies() {
+  static_assert(mystl::PowerOfTwoGrowth::grow(0, 1) == 1);
+  static_assert(mystl::PowerOfTwoGrowth::grow(8, 9) == 16);
+  static_assert(mystl::PowerOfTwoGrowth::grow(8, 100) == 128);
+  static_assert(mystl::FixedStepGrowth<16>::grow(32, 33) == 48);
+
+  push_pop_round_trip<mystl::GeometricGrowth<>>();
+  push_pop_round_trip<mystl::GeometricGrowth<2, 1>>();
+  push_pop_round_trip<mystl::FixedStepGrowth<16>>();
+  push_pop_round_trip<mystl::PowerOfTwoGrowth>();
+
+  mystl::Vector<int, mystl::PowerOfTwoGrowth> vec;
+  for (int i = 0; i < 100; ++i) {
+    vec.push_back(i);
+    assert((vec.capacity() & (vec.capacity() - 1)) == 0);
+  }
+}
+
+// Owns a heap buffer but has no self-pointers, so it opts in to relocation.
+struct Handle {
+  int *value;
+
+  explicit Handle(int v) : value(new int(v)) {}
+  Handle(Handle const &other) : value(new int(*other.value)) {}
+  Handle(Handle &&other) : value(other.value) { other.value = nullptr; }
+  ~Handle() { delete value; }
+};
+
+template <>
+struct mystl::is_trivially_relocatable<Handle> : std::true_type {};
+
+static_assert(mystl::is_trivially_relocatable_v<int>);
+static_assert(mystl::is_trivially_relocatable_v<float>);
+static_assert(!mystl::is_trivially_relocatable_v<std::string>);
+static_assert(mystl::is_trivially_relocatable_v<Handle>);
+
+template <typename T, typename MakeFn>
+void insert_erase_keeps_order(MakeFn make) {
+  mystl::Vector<T> vec;
+  for (int i = 0; i < 100; ++i) {
+    vec.emplace_back(make(i));
+  }
+
+  vec.insert(10, make(-1), 5);
+  assert(vec.size() == 105);
+  for (int i = 0; i < 105; ++i) {
+    int expected = i < 10 ? i : i < 15 ? -1 : i - 5;
+    assert(vec[i] == make(expected));
+  }
+
+  vec.erase(10, 5);
+  assert(vec.size() == 100);
+  for (int i = 0; i < 100; ++i) {
+    assert(vec[i] == make(i));
+  }
+
+  vec.erase(0, 90);
+  assert(vec.size() == 10);
+  assert(vec.front() == make(90));
+  assert(vec.back() == make(99));
+}
+
+void test_relocation() {
+  insert_erase_keeps_order<int>([](int i) { return i; });
+  insert_erase_keeps_order<float>([](int i) { return static_cast<float>(i); });
+  insert_erase_keeps_order<std::string>(
+      [](int i) { return std::string(40, static_cast<char>('a' + i % 26)); });
+
+  mystl::Vector<Handle> handles;
+  for (int i = 0; i < 100; ++i) {
+    handles.emplace_back(i);
+  }
+  handles.erase(0, 50);
+  handles.insert(0, Handle{-1});
+  assert(*handles.front().value == -1);
+  assert(*handles[1].value == 50);
+  assert(*handles.back().value == 99);
+
+  mystl::Vector<std::string> copy{std::string("a"), std::string("b")};
+  mystl::Vector<std::string> other{copy};
+  copy.reserve(64);
+  assert(other.size() == 2 && copy.size() == 2);
+  assert(copy.back() == "b" && other.back() == "b");
+}
+
+// Appending an element of the vector itself when it is full: growing frees
+// the buffer the argument lives in, so it must be read first.
+template <typename Vector_t, typename MakeFn>
+void append_own_element(MakeFn make) {
+  Vector_t vec;
+  vec.push_back(make(0));
+  for (int i = 1; i < 200; ++i) {
+    if (vec.size() == vec.capacity()) {
+      vec.push_back(vec[0]);
+      vec.emplace_back(vec.back());
+      vec.push_back(std::move(vec[vec.size() - 1]));
+      assert(vec[vec.size() - 3] == make(0) && vec.back() == make(0));
+    } else {
+      vec.push_back(make(i));
+    }
+  }
+  assert(vec[0] == make(0) && vec[1] == make(1));
+}
+
+void test_self_append() {
+  auto makeInt = [](int i) { return i; };
+  auto makeString = [](int i) {
+    return std::string(40, static_cast<char>('a' + i % 26));
+  };
+  append_own_element<mystl::Vector<int>>(makeInt);
+  append_own_element<mystl::Vector<std::string>>(makeString);
+  append_own_element<mystl::Vector<std::string, mystl::GeometricGrowth<>,
+                                   mystl::Allocator<std::string>, 4>>(
+      makeString);
+}
+
+// Throws on the copy numbered m_ThrowOn (counting from 0) after it is set.
+struct Fragile {
+  static inline int m_Copies = 0;
+  static inline int m_ThrowOn = -1;
+  static inline int m_Alive = 0;
+  std::string value;
+
+  Fragile(std::string text) : value(std::move(text)) { ++m_Alive; }
+  Fragile(Fragile const &other) : value(other.value) {
+    if (m_Copies++ == m_ThrowOn) {
+      throw std::runtime_error("copy failed");
+    }
+    ++m_Alive;
+  }
+  Fragile(Fragile &&other) noexcept : value(std::move(other.value)) {
+    ++m_Alive;
+  }
+  ~Fragile() { --m_Alive; }
+};
+
+// Two integers are a count and a value, not an iterator pair.
+template <typename Vector_t>
+concept inserts_int_pair = requires(Vector_t vec) {
+  vec.insert(vec.cbegin(), 3, 7);
+};
+static_assert(!inserts_int_pair<mystl::Vector<int>>);
+
+void test_range_insertion() {
+  mystl::Vector<int> vec{1, 2, 3};
+  int values[] = {10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+
+  // Growing insert in the middle: one reallocation around the gap.
+  auto it = vec.insert(++vec.cbegin(), values, values + 10);
+  assert(*it == 10);
+  assert(vec.size() == 13);
+  assert(vec[0] == 1 && vec[1] == 10 && vec[10] == 19 && vec[11] == 2);
+
+  // Non-growing insert shifts the tail in place.
+  vec.reserve(64);
+  std::size_t capacity = vec.capacity();
+  vec.insert(vec.cend(), values, values + 3);
+  vec.insert(vec.cbegin(), values + 5, values + 7);
+  assert(vec.capacity() == capacity);
+  assert(vec.size() == 18);
+  assert(vec.front() == 15 && vec[1] == 16 && vec[2] == 1 && vec.back() == 12);
+
+  // Any range with begin()/end(), including other mystl containers.
+  mystl::Vector<int> other;
+  other.append_range(vec);
+  assert(other.size() == vec.size() && other.back() == 12);
+
+  std::list<int> list{7, 8, 9};
+  other.assign_range(list);
+  assert(other.size() == 3 && other.front() == 7 && other.back() == 9);
+
+  other.insert_range(other.cbegin() + 1, mystl::Vector<int>{1, 2});
+  assert(other.size() == 5 && other[1] == 1 && other[2] == 2 && other[3] == 8);
+
+  // Single-pass input is buffered, then inserted the same way.
+  std::istringstream input("4 5 6");
+  other.insert(other.cbegin(), std::istream_iterator<int>(input),
+               std::istream_iterator<int>());
+  assert(other.size() == 8 && other[0] == 4 && other[2] == 6 && other[3] == 7);
+
+  // A copy that throws leaves the vector as it was, whether or not the
+  // insert had to grow the buffer.
+  for (bool grow : {true, false}) {
+    mystl::Vector<Fragile> fragile;
+    fragile.reserve(grow ? 2 : 16);
+    fragile.emplace_back(std::string("first"));
+    fragile.emplace_back(std::string("last"));
+    Fragile source[] = {std::string("x"), std::string("y"), std::string("z")};
+    int alive = Fragile::m_Alive;
+    Fragile::m_Copies = 0;
+    Fragile::m_ThrowOn = 2;
+    bool thrown = false;
+    try {
+      fragile.insert(fragile.cbegin() + 1, source, source + 3);
+    } catch (std::runtime_error const &) {
+      thrown = true;
+    }
+    Fragile::m_ThrowOn = -1;
+    assert(thrown && Fragile::m_Alive == alive && fragile.size() == 2);
+    assert(fragile[0].value == "first" && fragile[1].value == "last");
+  }
+
+  mystl::Vector<std::string> strings{std::string("a"), std::string("d")};
+  std::string middle[] = {"b", "c"};
+  strings.insert_range(strings.cbegin() + 1, middle);
+  assert(strings.size() == 4 && strings[1] == "b" && strings[2] == "c" &&
+         strings[3] == "d");
+}
+
+struct Counted {
+  static inline int m_Constructed = 0;
+  int value;
+
+  Counted() : value(7) { ++m_Constructed; }
+};
+
+void test_uninitialized_growth() {
+  mystl::Vector<int> ints(16, mystl::default_init);
+  assert(ints.size() == 16);
+  for (int i = 0; i < 16; ++i) {
+    ints[i] = i;
+  }
+
+  ints.resize_for_overwrite(32);
+  assert(ints.size() == 32 && ints[15] == 15);
+  ints.resize_for_overwrite(4);
+  assert(ints.size() == 4 && ints.back() == 3);
+
+  // The callback decides how much of the buffer is kept.
+  mystl::Vector<char> buffer;
+  buffer.resize_and_overwrite(4096, [](char *data, std::size_t size) {
+    assert(size == 4096);
+    data[0] = 'o';
+    data[1] = 'k';
+    return 2;
+  });
+  assert(buffer.size() == 2 && buffer.front() == 'o' && buffer.back() == 'k');
+  assert(buffer.capacity() >= 4096);
+
+  buffer.resize_and_overwrite(8, [](char *data, std::size_t) {
+    assert(data[0] == 'o');
+    data[2] = '!';
+    return 3;
+  });
+  assert(buffer.size() == 3 && buffer.back() == '!');
+
+  // A failed read (-1, as from ::read) or an overlong count is rejected and
+  // leaves the size alone; so does an exception from the callback.
+  bool rejected = false;
+  try {
+    buffer.resize_and_overwrite(64, [](char *, std::size_t) { return -1L; });
+  } catch (std::out_of_range const &) {
+    rejected = true;
+  }
+  assert(rejected && buffer.size() == 3 && buffer.back() == '!');
+  rejected = false;
+  try {
+    buffer.resize_and_overwrite(
+        4, [](char *, std::size_t size) { return size + 1; });
+  } catch (std::out_of_range const &) {
+    rejected = true;
+  }
+  assert(rejected && buffer.size() == 3);
+  rejected = false;
+  try {
+    buffer.resize_and_overwrite(16, [](char *, std::size_t) -> std::size_t {
+      throw std::runtime_error("read failed");
+    });
+  } catch (std::runtime_error const &) {
+    rejected = true;
+  }
+  assert(rejected && buffer.size() == 3);
+
+  // Shrinking for overwrite keeps the buffer.
+  std::size_t capacity = buffer.capacity();
+  buffer.resize_for_overwrite(1);
+  assert(buffer.size() == 1 && buffer.capacity() == capacity);
+
+  // Non-trivial types are still default constructed.
+  mystl::Vector<Counted> counted(5, mystl::default_init);
+  assert(Counted::m_Constructed == 5 && counted.back().value == 7);
+  counted.resize_for_overwrite(8);
+  assert(Counted::m_Constructed == 8);
+}
+
+void test_vector() {
+  test_geometric_growth();
+  test_shrink_hysteresis();
+  test_shrink_to_fit();
+  test_policies();
+  test_relocation();
+  test_self_append();
+  test_range_insertion();
+  test_uninitialized_growth();
+}
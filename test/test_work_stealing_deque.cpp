@@ -0,0 +1,80 @@
+#include "MySTL/WorkStealingDeque.h"
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void test_work_stealing_deque_single_thread() {
+  mystl::WorkStealingDeque<int> deque(2);
+  int out = -1;
+  assert(!deque.pop(out) && !deque.steal(out));
+
+  // Grows past the initial two slots while keeping the order.
+  for (int i = 0; i < 10; ++i) {
+    deque.push(i);
+  }
+  assert(deque.size() == 10 && deque.capacity() == 16);
+
+  // Owner end is LIFO, thief end is FIFO.
+  assert(deque.pop(out) && out == 9);
+  assert(deque.steal(out) && out == 0);
+  assert(deque.steal(out) && out == 1);
+  assert(deque.pop(out) && out == 8);
+  while (deque.pop(out)) {
+  }
+  assert(out == 2 && deque.empty());
+}
+
+void test_work_stealing_deque_threads() {
+  constexpr int taskCount = 100000;
+  constexpr int thiefCount = 3;
+  mystl::WorkStealingDeque<int> deque(4);
+  auto seen = std::make_unique<std::atomic<int>[]>(taskCount);
+  std::atomic<bool> done{false};
+
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < thiefCount; ++t) {
+    thieves.emplace_back([&] {
+      int task;
+      while (!done.load(std::memory_order_acquire)) {
+        if (deque.steal(task)) {
+          seen[task].fetch_add(1, std::memory_order_relaxed);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // The owner keeps pushing and occasionally works on its own tasks.
+  int task;
+  for (int i = 0; i < taskCount; ++i) {
+    deque.push(i);
+    if (i % 4 == 0 && deque.pop(task)) {
+      seen[task].fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  while (deque.pop(task)) {
+    seen[task].fetch_add(1, std::memory_order_relaxed);
+  }
+  done.store(true, std::memory_order_release);
+  for (std::thread &thief : thieves) {
+    thief.join();
+  }
+
+  // Every task ran exactly once.
+  for (int i = 0; i < taskCount; ++i) {
+    assert(seen[i].load() == 1);
+  }
+}
+
+} // namespace
+
+void test_work_stealing_deque() {
+  test_work_stealing_deque_single_thread();
+  test_work_stealing_deque_threads();
+}